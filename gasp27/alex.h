@@ -79,6 +79,16 @@ typedef struct DbMatStruct
 #define MOD_COMP_CRIT_LIKE    0
 #define MOD_COMP_CRIT_CV      1     
 
+/* Correlation parameters of the bags (BagHyperNum). */
+#define BAG_HYPER_NAMES       {SEPARATE, SHARED}
+#define BAG_HYPER_SEPARATE    0
+#define BAG_HYPER_SHARED      1
+
+/* Methods for leave-one-out cross validation (CalcCV). */
+#define CV_METHOD_NAMES       {CLOSED_FORM, DELETION}
+#define CV_METHOD_CLOSED      0
+#define CV_METHOD_DELETION    1
+
 
 /* run.c: */
 
@@ -120,7 +130,7 @@ int CalcCV(KrigingModel *KrigMod, real *YHatCV, real *SE);
 /*                                                               */
 /*   Args:     KrigMod   Input: Kriging model without            */
 /*                       decompositions.                         */
-/*                       Output: Decompositions are garbage.     */
+/*                       Output: Decompositions for all n cases. */
 /*             YHatCV    Output: Cross-validation predictions.   */
 /*             SE        Output: Standard errors (computed only  */
 /*                       if SE != NULL).                         */
@@ -129,8 +139,38 @@ int CalcCV(KrigingModel *KrigMod, real *YHatCV, real *SE);
 /*                                                               */
 /*   Comment:  Calling routine must allocate space for YHatCV    */
 /*             and SE.                                           */
-/*             Better matrix updating for doing this?            */
-/*             KrigMod decompositions are changed.               */
+/*             Closed-form leave-one-out from one decomposition  */
+/*             of all n cases, or CalcCVPerm if                  */
+/*             CrossValidationMethod = Deletion, or CalcCVFolds  */
+/*             if 1 < CVFolds < n.                               */
+/*****************************************************************/
+
+/*****************************************************************/
+int CalcCVFolds(KrigingModel *KrigMod, size_t nFolds, real *YHatCV,
+     real *SE);
+/*****************************************************************/
+/*   Purpose:  As CalcCV, but K-fold: case i is in fold          */
+/*             i mod nFolds (not random), and the cases in a     */
+/*             fold are predicted from the cases in the other    */
+/*             folds.                                            */
+/*                                                               */
+/*   Returns:  OK or an error number.                            */
+/*                                                               */
+/*   Comment:  KrigMod has the decompositions for all n cases on */
+/*             exit.                                             */
+/*****************************************************************/
+
+/*****************************************************************/
+int CalcCVPerm(KrigingModel *KrigMod, real *YHatCV, real *SE);
+/*****************************************************************/
+/*   Purpose:  As CalcCV, by deleting each case in turn from the */
+/*             Cholesky factor (TriPerm) and re-fitting; the     */
+/*             reference for CalcCV.                             */
+/*                                                               */
+/*   Comment:  KrigMod decompositions are garbage on exit.       */
+/*             If compiled with OpenMP, contiguous blocks of     */
+/*             cases are shared among threads, each with its own */
+/*             copy of the factor.                               */
 /*****************************************************************/
 
 
@@ -227,7 +267,7 @@ void AvePred(KrigingModel *KrigMod, const Matrix *PredReg,
      real *fAve, real *rAve, real *RAve);
 /*****************************************************************/
 /*   Purpose:  Average f and r w.r.t. the groups *not* in        */
-/*             IndexEffectGroup.                                       */
+/*             IndexEffectGroup.                                 */
 /*****************************************************************/
 
 /*****************************************************************/
@@ -283,16 +323,31 @@ int Fit(void);
 /*   Purpose:  Fit the model parameters.                         */
 /*                                                               */
 /*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  If FittedModel is set, the fitted models and      */
+/*             their decompositions are also saved to that file. */
 /*****************************************************************/
 
 /*****************************************************************/
-int FitBest(KrigingModel *KrigMod, size_t Tries, real *Beta,
-     Matrix *CorPar, real *SPVar, real *ErrVar, real *NegLogLike,
-     real *CVRootMSE, unsigned *nEvals, real *CondNum);
+int FitBest(KrigingModel *KrigMod, size_t nCases,
+     const size_t *RowIndex, size_t Tries, boolean Progress,
+     real *Beta, Matrix *CorPar, real *SPVar, real *ErrVar,
+     real *NegLogLike, real *CVRootMSE, unsigned *nEvals,
+     real *CondNum);
 /*****************************************************************/
-/*   Purpose:  Choose best of several MLE tries.                 */
+/*   Purpose:  Choose best of several MLE tries for KrigMod,     */
+/*             whose data are rows RowIndex[0],...,              */
+/*             RowIndex[nCases - 1] of X and y (see KrigModData).*/
 /*                                                               */
 /*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  Only tries that can be chosen are cross           */
+/*             validated: the best by likelihood, or, under the  */
+/*             cross-validation criterion, those within          */
+/*             CVLogLikelihoodMargin of the best log likelihood. */
+/*             A progress line per try is output if Progress.    */
+/*             Inside a parallel region (e.g., Bag) the tries    */
+/*             run in the calling thread.                        */
 /*****************************************************************/
 
 
@@ -310,6 +365,19 @@ int Predict(void);
 /*             prediction coefficients.                          */
 /*                                                               */
 /*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  If the FittedModel file has the model for a       */
+/*             response, the current data and model terms, and   */
+/*             the parameters in StochasticProcessModel and      */
+/*             YDescription, its parameters and decompositions   */
+/*             are used; otherwise they are set up from          */
+/*             StochasticProcessModel and YDescription.          */
+/*             If XPredictionFile is set, it is read             */
+/*             PredictionChunk rows at a time and the            */
+/*             predictions go to YPredictionFile (as MatWrite    */
+/*             would write them), instead of using XPrediction.  */
+/*             With PredictionStandardErrors = No, only the      */
+/*             predictions are computed (see PredYHatSE).        */
 /*****************************************************************/
 
 /*****************************************************************/
@@ -319,6 +387,133 @@ void OutputSummary(Matrix *Summ, size_t nCols,
 /*   Purpose:  Output summary information.                       */
 /*****************************************************************/
 
+/*****************************************************************/
+int PredModSetUp(FILE *ModFile, real SPVar, real ErrVar,
+     KrigingModel *KrigMod);
+/*****************************************************************/
+/*   Purpose:  Set up the kriging model for the current response */
+/*             (see DbIndexXY) for prediction: read from the     */
+/*             fitted-model file ModFile if it has the model for */
+/*             these data, otherwise from the data, SPModMat,    */
+/*             SPVar, and ErrVar.                                */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  KrigMod must be allocated by KrigModAlloc.        */
+/*             ModFile may be NULL.                              */
+/*****************************************************************/
+
+/*****************************************************************/
+int PredYHatSE(KrigingModel *KrigMod, const Matrix *XPred,
+     real *YHat, real *SE);
+/*****************************************************************/
+/*   Purpose:  Compute predictions at the rows of XPred, and     */
+/*             their standard errors if SE != NULL.              */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  With SE == NULL, KrigPred needs O(n) operations   */
+/*             per point after one back substitution, instead of */
+/*             the O(n * n) triangular solves in KrigPredSE.     */
+/*****************************************************************/
+
+/*****************************************************************/
+size_t PredModsSetUp(KrigingModel *KrigMod, boolean *Ready);
+/*****************************************************************/
+/*   Purpose:  Set up the kriging model of every response for    */
+/*             prediction (see PredModSetUp): KrigMod[j] for row */
+/*             j of YDescrip, if Ready[j] is YES on return.      */
+/*                                                               */
+/*   Returns:  The number of models set up.                      */
+/*                                                               */
+/*   Comment:  KrigMod and Ready must have as many elements as   */
+/*             YDescrip has rows.  Free with PredModsFree.       */
+/*****************************************************************/
+
+/*****************************************************************/
+void PredModsFree(KrigingModel *KrigMod, const boolean *Ready);
+/*****************************************************************/
+/*   Purpose:  Free the models set up by PredModsSetUp.          */
+/*****************************************************************/
+
+/*****************************************************************/
+FILE *FittedModelOpen(boolean Write);
+/*****************************************************************/
+/*   Purpose:  Open the fitted-model file named by the           */
+/*             FittedModel scalar, in OutDir for writing or      */
+/*             InDir for reading (as for matrices).              */
+/*                                                               */
+/*   Returns:  The file, or NULL if FittedModel is not set or    */
+/*             the file cannot be opened (see KrigFileOpen).     */
+/*****************************************************************/
+
+
+/* gaspserv.c: */
+
+/* Command-line option naming the socket for Serve. */
+#define SERVE_OPTION      "--serve"
+
+/* Message headers and commands (see gaspserv.c). */
+#define SERVE_HEAD        4
+#define SERVE_PREDICT     1
+#define SERVE_STATUS      2
+#define SERVE_STOP        3
+
+/* Values in the reply to SERVE_STATUS. */
+#define SERVE_STAT_LEN    6
+
+/* Most points in a request. */
+#define SERVE_MAX_POINTS  1000000
+
+/*****************************************************************/
+int Serve(void);
+/*****************************************************************/
+/*   Purpose:  Set up the kriging model of every response and    */
+/*             serve predictions on ServeSocket until a          */
+/*             SERVE_STOP request.                               */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  With OpenMP, ServerThreads workers (all threads   */
+/*             if 0) each take a client at a time; otherwise     */
+/*             clients are served one at a time.                 */
+/*****************************************************************/
+
+
+/* gaspbag.c: */
+
+/*****************************************************************/
+int Bag(void);
+/*****************************************************************/
+/*   Purpose:  Fit each response to BagIterations bags and put   */
+/*             the aggregated and the bags' predictions and      */
+/*             standard errors in YPrediction.                   */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  A bag is BagSize cases (all if 0) drawn from the  */
+/*             cases with no NA's, with replacement if           */
+/*             BagReplace = Yes, from the sequence started by    */
+/*             BagSeed (a case drawn more than once is fitted    */
+/*             once, also with RandomError).  Each bag is fitted */
+/*             by FitBest or, if BagHyperparameters = Shared,    */
+/*             takes the correlation parameters fitted to all    */
+/*             cases and is only decomposed.                     */
+/*             The aggregated prediction (Pred.y)                */
+/*             weights the bags by 1 / SE^2; the bags' are       */
+/*             Pred.y.1, Pred.y.2, etc., if BagPredictions = Yes */
+/*             (default No).  YDescription gets the number of    */
+/*             bags fitted and, if YTrue is given, the           */
+/*             aggregated errors.                                */
+/*             If BagCheckpointInterval = 5, say, the            */
+/*             aggregation over the first 5, 10, ... bags is     */
+/*             also put out, in Pred.y.Bags5, RootMSE.Bags5,     */
+/*             etc.  Each bag predicts the cases it left out,    */
+/*             for OOBRootMSE, OOBMaxErr, etc. in YDescription.  */
+/*             Apart from the bags' columns, memory is for two   */
+/*             bags per thread, however many bags there are.     */
+/*****************************************************************/
+
 
 /* acedlhs.c: */
 
@@ -697,6 +892,7 @@ void LHSValidX(const Matrix *XReg, const real *Mean, Matrix *X);
 
 /* Names of int scalars: */
 
+#define BAG_SEED              "BagSeed"
 #define RAN_NUM_SEED          "RandomNumberSeed"
 
 /* Names of real scalars: */
@@ -706,6 +902,7 @@ void LHSValidX(const Matrix *XReg, const real *Mean, Matrix *X);
 #define DIST_METRIC           "DistanceMetric"
 #define CRIT_COR              "CriticalCorrelation"
 #define CRIT_LOG_LIKE_DIFF    "CriticalLogLikelihoodDifference"
+#define CV_LOG_LIKE_MARGIN    "CVLogLikelihoodMargin"
 #define INTER_EFF_PERC        "InteractionEffectPercentage"
 #define LAMBDA                "Lambda"
 #define LIFE_DIST             "LifetimeDistribution"
@@ -716,24 +913,39 @@ void LHSValidX(const Matrix *XReg, const real *Mean, Matrix *X);
 
 /* Names of size_t scalars: */
 
+#define BAG_CHECK_INT    "BagCheckpointInterval"
+#define BAG_ITER         "BagIterations"
+#define BAG_SIZE         "BagSize"
+#define CV_FOLDS         "CVFolds"
 #define PROJ_DIM         "ProjectionDimension"
 #define PROTECTED_RUNS   "ProtectedRuns"
 #define REFIT_RUNS       "RefitRuns"
 #define RUNS             "Runs"
+#define SERVER_THREADS   "ServerThreads"
 #define TRIES            "Tries"
 #define N_X_VARS         "xVariables"
+#define PRED_CHUNK       "PredictionChunk"
 
 /* Names of string scalars: */
 
+#define BAG_HYPER             "BagHyperparameters"
+#define BAG_PREDS             "BagPredictions"
+#define BAG_REPLACE           "BagReplace"
 #define COR_FAM               "CorrelationFamily"
+#define CV_METHOD             "CrossValidationMethod"
 #define DESIGN_ALG            "DesignAlgorithm"
 #define DESIGN_CRIT           "DesignCriterion"
+#define FITTED_MODEL          "FittedModel"
 #define GEN_PRED_COEF         "GeneratePredictionCoefficients"
 #define IN_DIR                "InputDirectory"
+#define MIN_ALG               "MinimizationAlgorithm"
 #define MOD_COMP_CRIT         "ModelComparisonCriterion"
 #define NORMALIZED_RANGES     "NormalizedRanges"
+#define PRED_SE               "PredictionStandardErrors"
 #define RAN_ERR               "RandomError"
 #define SEQ_CRIT              "SequentialCriterion"
+#define X_PRED_FILE           "XPredictionFile"
+#define Y_PRED_FILE           "YPredictionFile"
 #define RESP_FUNC             "ResponseFunction"
 #define OUT_DIR               "OutputDirectory"
 
@@ -741,8 +953,14 @@ void LHSValidX(const Matrix *XReg, const real *Mean, Matrix *X);
 
 #define LIKELIHOOD       "Likelihood"
 #define CROSS_VALIDATION "CrossValidation"
+#define CLOSED_FORM      "ClosedForm"
+#define DELETION         "Deletion"
+#define LBFGS            "LBFGS"
+#define POWELL           "Powell"
 #define MATERN           "Matern"
 #define POW_EXP          "PowerExponential"
+#define SEPARATE         "Separate"
+#define SHARED           "Shared"
 
 /* Names of matrices: */
 
@@ -788,9 +1006,11 @@ void LHSValidX(const Matrix *XReg, const real *Mean, Matrix *X);
 
 #define ALPHA            "Alpha"
 #define ANOVA_TOTAL_PERC "ANOVATotal%"
+#define BAGS             "Bags"
 #define BETA             "Beta"
 #define CASE_MAX_ERR     "CaseMaxErr"
 #define CASE_CV_MAX_ERR  "CaseCVMaxErr"
+#define CASE_OOB_MAX_ERR "CaseOOBMaxErr"
 #define CASES            "Cases"
 #define COEF             "Coef"
 #define COND_NUM         "ConditionNumber"
@@ -801,6 +1021,9 @@ void LHSValidX(const Matrix *XReg, const real *Mean, Matrix *X);
 #define LOG_LIKE         "LogLikelihood"
 /* MIN and MAX in define.h. */
 #define MAX_ERR          "MaxErr"
+#define OOB_CASES        "OOBCases"
+#define OOB_MAX_ERR      "OOBMaxErr"
+#define OOB_ROOT_MSE     "OOBRootMSE"
 #define PRED             "Pred"
 #define ROOT_MSE         "RootMSE"
 #define STANDARDIZED     "Standardized"
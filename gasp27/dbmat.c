@@ -16,7 +16,7 @@
 #include "model.h"
 #include "alex.h"
 
-extern int          ErrorSeverityLevel;
+extern THREAD_LOCAL int ErrorSeverityLevel;
 extern List         *ColTemplates;
 
 extern boolean      DesignJob;
@@ -79,10 +79,11 @@ static string XDescripOptCol[]= {TRANSFORMATION, NUM_CATS,
           INCLUSIVE, WEIGHT, NULL};
 static string YDescripCompCol[]= {VARIABLE, SP_VAR, ERR_VAR, NULL};
 static string YDescripOptCol[]= {TRANSFORMATION, MIN, MAX, ANALYZE,
-          CASES, SP_VAR, ERR_VAR, LOG_LIKE, COND_NUM,
+          CASES, BAGS, SP_VAR, ERR_VAR, LOG_LIKE, COND_NUM,
           ANOVA_TOTAL_PERC, AVERAGE, STD_ERR "." AVERAGE,
           CASE_MAX_ERR, MAX_ERR, ROOT_MSE, CASE_CV_MAX_ERR,
-          CV_MAX_ERR, CV_ROOT_MSE, NULL};
+          CV_MAX_ERR, CV_ROOT_MSE, OOB_CASES, OOB_ROOT_MSE,
+          OOB_MAX_ERR, CASE_OOB_MAX_ERR, NULL};
 
 /* Table of matrices. */
 static DbMatrix DbMat[] =
@@ -266,7 +267,9 @@ int DbMatCheck(DbMatrix *D, string *FileName)
 /*                                                               */
 /*   Returns:  INPUT_ERR, INCOMPAT_ERR, or OK.                   */
 /*                                                               */
-/*   Version:  1996.05.20                                        */
+/*   2026.10.17: YDescrip as for "Fit" if FuncName is "Bag".     */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
      int       ErrNum;
@@ -287,7 +290,8 @@ int DbMatCheck(DbMatrix *D, string *FileName)
      {
           /* Jobs requiring previous fit. ?? */
           if (stricmp(Name, Y_DESCRIP) == 0 &&
-                    !DesignJob && stricmp(FuncName, "Fit") != 0)
+                    !DesignJob && stricmp(FuncName, "Fit") != 0 &&
+                    stricmp(FuncName, "Bag") != 0)
                D->CompCol = YDescripCompCol;
 
           if ( (ErrNum = DbMatLegal(D)) == OK)
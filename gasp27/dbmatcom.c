@@ -59,6 +59,7 @@ int DbMatCompat(DbMatrix *D)
 /*             DbMatCatCols not called if XDescrip is empty.     */
 /* 2009.05.07: CorParAlloc replaces PEAlloc (multiple            */
 /*             correlation families)                             */
+/* 2026.10.17: "Bag" fits, so is treated as "Fit".               */
 /*****************************************************************/
 {
      int       ErrNum;
@@ -156,6 +157,7 @@ int DbMatCompat(DbMatrix *D)
           ErrNum = ModParse2(nXVars, xName, nCats, SP_MOD, &SPMod);
           if (ErrNum == OK && !DesignJob &&
                     stricmp(FuncName, "Fit") != 0 &&
+                    stricmp(FuncName, "Bag") != 0 &&
                     stricmp(FuncName, "SequentialDesign") != 0)
           {
                nYVars = MatNumRows(&YDescrip);
@@ -188,6 +190,7 @@ int DbMatCompat(DbMatrix *D)
      else if (stricmp(Name, Y_DESCRIP) == 0)
      {
           if (!DesignJob && stricmp(FuncName, "Fit") != 0 &&
+                   stricmp(FuncName, "Bag") != 0 &&
                    stricmp(FuncName, "SequentialDesign") != 0 &&
                    MatColFind(&YDescrip, SP_VAR, NO) == NULL)
           {
@@ -195,7 +198,7 @@ int DbMatCompat(DbMatrix *D)
                ErrNum = INCOMPAT_ERR;
           }
           if (!DesignJob && stricmp(FuncName, "Fit") != 0 &&
-                    RanErr == YES &&
+                    stricmp(FuncName, "Bag") != 0 && RanErr == YES &&
                     MatColFind(&YDescrip, ERR_VAR, NO) == NULL)
           {
                Incompatibility(DB_COMPULSORY, Y_DESCRIP, ERR_VAR);
@@ -48,6 +48,8 @@ RealCol[] =
      {MAX,               -REAL_MAX,     REAL_MAX  },
      {MAX_ERR,           -REAL_MAX,     REAL_MAX  },
      {MIN,               -REAL_MAX,     REAL_MAX  },
+     {OOB_MAX_ERR,       -REAL_MAX,     REAL_MAX  },
+     {OOB_ROOT_MSE,      0.0,           REAL_MAX  },
      {PRED,              -REAL_MAX,     REAL_MAX  },
      {ROOT_MSE,          0.0,           REAL_MAX  },
      {STD_ERR,           0.0,           REAL_MAX  },
@@ -71,9 +73,11 @@ static struct Size_tColStruct
 Size_tCol[] =
 {
      {CAND_GROUP,        0,   SIZE_T_MAX     },
+     {BAGS,              0,   SIZE_T_MAX     },
      {CASES,             0,   SIZE_T_MAX     },
      {NUM_CATS,          0,   SIZE_T_MAX     },
      {NUM_LEVELS,        0,   SIZE_T_MAX     },
+     {OOB_CASES,         0,   SIZE_T_MAX     },
 };
 
 #define NUM_SIZE_T_COLS  (sizeof(Size_tCol)       \
@@ -99,6 +103,7 @@ StrCol[] =
      {ANALYZE,           2,                   NoYes           },
      {CASE_MAX_ERR,      0,                   NULL            },
      {CASE_CV_MAX_ERR,   0,                   NULL            },
+     {CASE_OOB_MAX_ERR,  0,                   NULL            },
      {DISTRIBUTION,      NumStr(DistribName), DistribName     },
      {INCLUSIVE,         2,                   NoYes           },
      {SUPPORT,           NumStr(SuppName),    SuppName        },
@@ -214,10 +219,15 @@ int DbMatColChk(DbMatrix *D)
 /*             both with and without extent (previously only     */
 /*             without).                                         */
 /* 2009.05.08: Derivatives (Matern) checked                      */                        
+/* 2026.10.17: A numeric extension following another one (the    */
+/*             per-bag columns Pred.y.1, SE.y.1, ... of Bag) is  */
+/*             removed before the usual extension.               */
+/* 2026.10.17: Likewise Bags and a number (Bag's checkpoints,    */
+/*             Pred.y.Bags5, ...).                               */
 /*****************************************************************/
 {
      boolean   InvalidName;
-     char      *DotPtr;
+     char      *BagPtr, *DotPtr;
      int       ErrNum;
      Matrix    *M;
      real      *col;
@@ -263,7 +273,18 @@ int DbMatColChk(DbMatrix *D)
                Name = MatColName(M, j);
 
                /* If column name includes extension, remove it. */
+               /* A trailing bag number goes first.             */
                NameNoExt = StrDup(Name);
+               if ( (DotPtr = strrchr(NameNoExt, '.')) != NULL &&
+                         DotPtr != strchr(NameNoExt, '.'))
+               {
+                    BagPtr = DotPtr + 1;
+                    if (strncmp(BagPtr, BAGS, strlen(BAGS)) == 0)
+                         BagPtr += strlen(BAGS);
+                    if (*BagPtr != NULL && strspn(BagPtr, "0123456789")
+                              == strlen(BagPtr))
+                         *DotPtr = NULL;
+               }
                if ( (DotPtr = strrchr(NameNoExt, '.')) != NULL)
                     *DotPtr = NULL;
 
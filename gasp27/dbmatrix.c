@@ -16,7 +16,7 @@
 #include "model.h"
 #include "alex.h"
 
-extern int          ErrorSeverityLevel;
+extern THREAD_LOCAL int ErrorSeverityLevel;
 extern List         *ColTemplates;
 
 extern boolean      DesignJob;
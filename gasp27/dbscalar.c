@@ -31,6 +31,7 @@ static size_t       nScalars = 0;
 /* Table of int scalars with defaults */
 /* (illegal value = no default).      */
 
+int       BagSeed = 1;
 int       Seed = 100;
 
 static struct IntStruct
@@ -42,6 +43,7 @@ static struct IntStruct
 }
 IntScalar[] =
 {
+     {BAG_SEED,          1,   30000,    &BagSeed},
      {RAN_NUM_SEED,      1,   30000,    &Seed}
 };
 
@@ -55,6 +57,8 @@ real AlphaMin            =  0.0;
 real CensLimit           = -1.0;
 real CoverDist           = -1.0;
 real CritLogLikeDiff     =  1.0;
+     /* Tries cross validated by FitBest (CV criterion). */
+real CVLogLikeMargin     =  5.0;
 real InterPerc           =  5.0;
 real Lambda              =  1.0;
 real LogLikeTol          =  0.00001;
@@ -90,6 +94,7 @@ RealScalar[] =
      {CENSORING_LIMIT,    0.0, REAL_MAX, &CensLimit      },
      {COVER_DIST,         0.0, REAL_MAX, &CoverDist      },
      {CRIT_LOG_LIKE_DIFF, 0.0, REAL_MAX, &CritLogLikeDiff},
+     {CV_LOG_LIKE_MARGIN, 0.0, REAL_MAX, &CVLogLikeMargin},
      {INTER_EFF_PERC,     0.0,    100.0, &InterPerc      },
      {LAMBDA,             1.0, REAL_MAX, &Lambda         },
      {LOG_LIKE_TOL,       0.0, REAL_MAX, &LogLikeTol     },
@@ -113,8 +118,12 @@ RealScalar[] =
 /* Table of size_t scalars with defaults */
 /* (illegal value = no default).         */
 
+size_t    BagCheckInt    = 0;      /* 0 for no checkpoints. */
+size_t    BagIter        = 10;
+size_t    BagSize        = 0;      /* 0 for all cases. */
 size_t    derivMin       = 0;      /* Matern correlation derivatives */
 size_t    derivMax       = 3;      /* Codes infinity! */
+size_t    CVFolds        = 0;      /* 0 for leave-one-out. */
 size_t    k              = 0;      /* Replace! */
 size_t    kf             = 0;      /* Replace! */
 size_t    ProjDimMax     = 2;
@@ -122,7 +131,9 @@ size_t    ProjDimMin     = 2;
 size_t    nProtected     = 0;
 size_t    n              = 0;
 size_t    nRefit         = 1;
+size_t    PredChunk      = 10000;  /* Rows of XPredictionFile. */
 size_t    s              = 0;      /* Replace! */
+size_t    ServerThreads  = 0;      /* 0 for all OpenMP threads. */
 size_t    Tries          = 1;
 size_t    nXVars         = 0;
 
@@ -135,8 +146,12 @@ static struct Size_tStruct
 }
 Size_tScalar[] =
 {
+     {BAG_CHECK_INT,     0,        SIZE_T_MAX,    &BagCheckInt   },
+     {BAG_ITER,          1,        SIZE_T_MAX,    &BagIter       },
+     {BAG_SIZE,          0,        SIZE_T_MAX,    &BagSize       },
      {"Derivatives.Min", 0,                 3,    &derivMin      },
      {"Derivatives.Max", 0,                 3,    &derivMax      },
+     {CV_FOLDS,          0,        SIZE_T_MAX,    &CVFolds       },
      {"k",               1,        SIZE_T_MAX,    &k             },
      {"kf",              1,        SIZE_T_MAX,    &kf            },
      {PROJ_DIM "." MAX,  1,        SIZE_T_MAX,    &ProjDimMax    },
@@ -145,8 +160,10 @@ Size_tScalar[] =
      {REFIT_RUNS,        1,        SIZE_T_MAX,    &nRefit        },
      {RUNS,              1,        SIZE_T_MAX,    &n             },
      {"s",               1,        SIZE_T_MAX,    &s             },
+     {SERVER_THREADS,    0,        SIZE_T_MAX,    &ServerThreads },
      {TRIES,             1,        SIZE_T_MAX,    &Tries         },
-     {N_X_VARS,          1,        SIZE_T_MAX,    &nXVars        }
+     {N_X_VARS,          1,        SIZE_T_MAX,    &nXVars        },
+     {PRED_CHUNK,        1,        SIZE_T_MAX,    &PredChunk     }
 };
 
 #define NUM_SIZE_TS (sizeof(Size_tScalar) / sizeof(struct Size_tStruct))
@@ -157,36 +174,54 @@ Size_tScalar[] =
 /* INDEX_ERR = no default.                                       */
 /* Why are some of these Num and some Size_t? */
 
+size_t BagHyperNum            = 0;
+size_t BagPredsSize_t         = 0;
+size_t BagReplaceSize_t       = 0;
 size_t CorFamNum              = 0;
 size_t CritNum                = INDEX_ERR;
+size_t CVMethodNum            = 0;
 size_t DesAlgNum              = INDEX_ERR;
+size_t FittedModelSize_t      = INDEX_ERR;
 size_t GenPredCoefsSize_t     = 0;
 size_t InDirSize_t            = INDEX_ERR;
 size_t LifeDist               = INDEX_ERR;
 size_t LikeNum                = 0;
 size_t LinkNum                = 0;
+size_t MinAlgNum              = 0;
 size_t ModCompCritNum         = 0;
 size_t NormalizedRangesSize_t = INDEX_ERR;
 size_t RanErrSize_t           = INDEX_ERR;
 size_t RespFuncSize_t         = INDEX_ERR;
 size_t SeqCritNum             = INDEX_ERR;
 size_t OutDirSize_t           = INDEX_ERR;
+size_t PredSESize_t           = 1;
 size_t VarFnNum               = 0;
+size_t XPredFileSize_t        = INDEX_ERR;
+size_t YPredFileSize_t        = INDEX_ERR;
 
+boolean BagPreds         = NO;
+boolean BagReplace       = NO;
 boolean RanErr           = NO;
 boolean GenPredCoefs     = NO;
 boolean NormalizedRanges = NO;
+boolean PredSE           = YES;
 
+string  FittedModel      = NULL;  /* Fitted-model file. */
 string  RespFunc         = NULL;
 string  InDir            = DEF_IN_DIR;
 string  OutDir           = DEF_OUT_DIR;
 string  SeqCrit          = NULL;
+string  XPredFile        = NULL;  /* Streamed by Predict. */
+string  YPredFile        = NULL;
 
+static string BagHyperName[]       = BAG_HYPER_NAMES;
 static string DesAlgName[]         = DES_ALG_NAMES;
 static string CorFamName[]         = COR_FAM_NAMES;
+static string CVMethodName[]       = CV_METHOD_NAMES;
 static string LifeDistName[]       = {"Exponential", "Weibull"};
 static string LikeName[]           = LIKE_NAMES;
 static string LinkName[]           = LINK_FN_NAMES;
+static string MinAlgName[]         = MIN_ALG_NAMES;
 static string ModCompCritName[]    = MOD_COMP_CRIT_NAMES;
 static string NoYes[]              = {NO_STR, YES_STR};
 static string SeqCritName[]        = {"Minimize", "Discriminate"};
@@ -201,12 +236,22 @@ static struct StrStruct
 }
 StrScalar[] =
 {
+     {BAG_HYPER,         NumStr(BagHyperName),    BagHyperName,
+                                                  &BagHyperNum        },
+     {BAG_PREDS,         2,                       NoYes,
+                                                  &BagPredsSize_t     },
+     {BAG_REPLACE,       2,                       NoYes,
+                                                  &BagReplaceSize_t   },
      {COR_FAM,           NumStr(CorFamName),      CorFamName,
                                                   &CorFamNum          },
+     {CV_METHOD,         NumStr(CVMethodName),    CVMethodName,
+                                                  &CVMethodNum        },
      {DESIGN_CRIT,       0,                       NULL,
                                                   &CritNum            },
      {DESIGN_ALG,        NumStr(DesAlgName),      DesAlgName,
                                                   &DesAlgNum          },
+     {FITTED_MODEL,      0,                       NULL,
+                                                  &FittedModelSize_t  },
      {GEN_PRED_COEF,     2,                       NoYes,
                                                   &GenPredCoefsSize_t },
      {IN_DIR,            0,                       NULL,
@@ -217,12 +262,16 @@ StrScalar[] =
                                                   &LikeNum            },
      {"LinkFunction",    NumStr(LinkName),        LinkName,
                                                   &LinkNum            },
+     {MIN_ALG,           NumStr(MinAlgName),      MinAlgName,
+                                                  &MinAlgNum          },
      {MOD_COMP_CRIT,     NumStr(ModCompCritName), ModCompCritName,
                                                   &ModCompCritNum     },
      {NORMALIZED_RANGES, 2,                       NoYes,
                                                   &NormalizedRangesSize_t},
      {OUT_DIR,           0,                       NULL,
                                                   &OutDirSize_t       },
+     {PRED_SE,           2,                       NoYes,
+                                                  &PredSESize_t       },
      {RESP_FUNC,         0,                       NULL,
                                                   &RespFuncSize_t     },
      {SEQ_CRIT,          NumStr(SeqCritName),     SeqCritName,
@@ -230,7 +279,11 @@ StrScalar[] =
      {RAN_ERR,           2,                       NoYes,
                                                   &RanErrSize_t       },
      {"VarianceFunction",NumStr(VarFnName),       VarFnName,
-                                                  &VarFnNum   }
+                                                  &VarFnNum   },
+     {X_PRED_FILE,       0,                       NULL,
+                                                  &XPredFileSize_t    },
+     {Y_PRED_FILE,       0,                       NULL,
+                                                  &YPredFileSize_t    }
 };
 
 #define NUM_STRS    (sizeof(StrScalar) / sizeof(struct StrStruct))
@@ -241,7 +294,10 @@ void DbScalarInit(void)
 /*****************************************************************/
 /*   Purpose:  Initialize the scalar database.                   */
 /*                                                               */
-/*   Version:  1995 May 11                                       */
+/*   2026.10.17: Default string is the one StrNum indexes, not   */
+/*               always the first legal string.                  */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
      size_t    i, nLegalStrs;
@@ -327,8 +383,9 @@ void DbScalarInit(void)
           else if (stricmp(StrScalar[i].Name, OUT_DIR) == 0)
                VecPutStr(v, 0, DEF_OUT_DIR);
           else if (*(StrScalar[i].StrNum) != INDEX_ERR)
-               /* Use LegalStr[0] as the default (may be NULL). */
-               VecPutStr(v, 0, StrScalar[i].LegalStr[0]);
+               /* Use the string StrNum indexes as the default. */
+               VecPutStr(v, 0,
+                         StrScalar[i].LegalStr[*(StrScalar[i].StrNum)]);
           else
                /* No default. */
                VecPutStr(v, 0, NOT_AVAIL);
@@ -468,20 +525,32 @@ int DbScalParse(size_t Index, const string Token)
 
                if (stricmp(VecName(ScalIndex), RAN_ERR) == 0)
                      RanErr = (boolean) VecSize_t(ScalIndex, 0);
+               else if (stricmp(VecName(ScalIndex), BAG_PREDS) == 0)
+                    BagPreds = (boolean) VecSize_t(ScalIndex, 0);
+               else if (stricmp(VecName(ScalIndex), BAG_REPLACE) == 0)
+                    BagReplace = (boolean) VecSize_t(ScalIndex, 0);
                else if (stricmp(VecName(ScalIndex), GEN_PRED_COEF)
                          == 0)
                     GenPredCoefs = (boolean) VecSize_t(ScalIndex, 0);
                else if (stricmp(VecName(ScalIndex), NORMALIZED_RANGES)
                          == 0)
                     NormalizedRanges = (boolean) VecSize_t(ScalIndex, 0);
+               else if (stricmp(VecName(ScalIndex), PRED_SE) == 0)
+                    PredSE = (boolean) VecSize_t(ScalIndex, 0);
                else if (stricmp(VecName(ScalIndex), RESP_FUNC) == 0)
                     RespFunc = VecStr(ScalIndex, 0);
+               else if (stricmp(VecName(ScalIndex), FITTED_MODEL) == 0)
+                    FittedModel = VecStr(ScalIndex, 0);
                else if (stricmp(VecName(ScalIndex), IN_DIR) == 0)
                     InDir = VecStr(ScalIndex, 0);
                else if (stricmp(VecName(ScalIndex), OUT_DIR) == 0)
                     OutDir = VecStr(ScalIndex, 0);
                else if (stricmp(VecName(ScalIndex), SEQ_CRIT) == 0)
                     SeqCrit = VecStr(ScalIndex, 0);
+               else if (stricmp(VecName(ScalIndex), X_PRED_FILE) == 0)
+                    XPredFile = VecStr(ScalIndex, 0);
+               else if (stricmp(VecName(ScalIndex), Y_PRED_FILE) == 0)
+                    YPredFile = VecStr(ScalIndex, 0);
           }
      }
 
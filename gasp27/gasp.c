@@ -36,6 +36,19 @@ boolean DesignJob = NO;
 
 /* Inputs: */
 
+const string BagCheck[]  = {IN_DIR, OUT_DIR,
+                              X_DESCRIP, X_MAT, Y_DESCRIP, Y_MAT,
+                              REG_MOD, SP_MOD, COR_FAM, RAN_ERR,
+                              THETA "." STANDARDIZED "." MIN,
+                              THETA "." STANDARDIZED "." MAX,
+                              ALPHA "." MIN, ALPHA "." MAX,
+                              "Derivatives" "." MIN, "Derivatives" "." MAX,
+                              SP_VAR_PROP "." MIN, SP_VAR_PROP "." MAX,
+                              CRIT_LOG_LIKE_DIFF, LOG_LIKE_TOL, TRIES,
+                              X_PRED, Y_PRED, Y_TRUE,
+                              BAG_ITER, BAG_SIZE, BAG_REPLACE, BAG_SEED,
+                              BAG_HYPER, BAG_CHECK_INT, BAG_PREDS, NULL};
+
 const string CVCheck[]   = {IN_DIR, OUT_DIR,
                               X_DESCRIP, X_MAT, Y_DESCRIP, Y_MAT,
                               REG_MOD, SP_MOD, COR_FAM, RAN_ERR,
@@ -70,9 +83,14 @@ const string SeqDesCheck[] = {IN_DIR, OUT_DIR,
 const string PredCheck[] = {IN_DIR, OUT_DIR,
                               X_DESCRIP, X_MAT, Y_DESCRIP, Y_MAT,
                               REG_MOD, SP_MOD, COR_FAM, RAN_ERR,
-                              X_PRED, Y_PRED, Y_TRUE,
+                              X_PRED, Y_PRED, Y_TRUE, PRED_SE,
                               GEN_PRED_COEF, PRED_COEF, NULL};
 
+const string ServeCheck[] = {IN_DIR, OUT_DIR,
+                              X_DESCRIP, X_MAT, Y_DESCRIP, Y_MAT,
+                              REG_MOD, SP_MOD, COR_FAM, RAN_ERR,
+                              SERVER_THREADS, NULL};
+
 const string VisCheck[]  = {IN_DIR, OUT_DIR,
                               X_DESCRIP, CAND, PRED_REG, X_MAT,
                               Y_DESCRIP, Y_MAT,
@@ -83,19 +101,33 @@ const string VisCheck[]  = {IN_DIR, OUT_DIR,
 /* Implemented functions: */
 static Function ImpFn[] =
 {
+     {"Bag",                    Bag,              BagCheck },
      {"CrossValidate",          CrossValidate,    CVCheck  },
      {"Fit",                    Fit,              FitCheck },
      /*
      {"SequentialDesign",       DataAdaptSeqDes,  SeqDesCheck },
      */
      {"Predict",                Predict,          PredCheck},
+     {"Serve",                  Serve,            ServeCheck},
      {"Visualize",              Visualize,        VisCheck }
 };
 
 #define NUM_FUNCS   (sizeof(ImpFn) / sizeof(Function))
 
+extern string ServeSocket;
+
 int main(int argc, char *argv[])
 {
+     /* gasp --serve <socket> [JobFile [LogFile]]: */
+     /* the Serve verb listens on <socket>.        */
+     if (argc >= 3 && strcmp(argv[1], SERVE_OPTION) == 0)
+     {
+          ServeSocket = argv[2];
+          argv[2] = argv[0];
+          argc -= 2;
+          argv += 2;
+     }
+
      Run(argc, argv, NUM_FUNCS, ImpFn, BANNER, PROMPT);
 
      exit(0);
@@ -0,0 +1,1064 @@
+/*****************************************************************/
+/*   ROUTINES TO EXECUTE BAGGING COMPUTATIONS                    */
+/*                                                               */
+/*   Bag fits the model to BagIterations subsamples ("bags") of  */
+/*   BagSize cases drawn from X and Y, with or without           */
+/*   replacement (BagReplace), and predicts XPrediction from     */
+/*   each bag.  The bags' predictions are combined with weights  */
+/*   1 / SE^2.  All bags share one process and one read of the   */
+/*   inputs.                                                     */
+/*                                                               */
+/*   With BagHyperparameters = Shared, the correlation           */
+/*   parameters are fitted once, to all cases, and each bag's    */
+/*   correlation matrix is gathered from the one for all cases:  */
+/*   a bag then costs one Cholesky factorization.                */
+/*                                                               */
+/*   With OpenMP the bags are fitted in parallel: each thread    */
+/*   takes the next bag as soon as it has finished one.  Each    */
+/*   bag has its own random-number seeds, so the output does not */
+/*   depend on the number of threads.  A bag's error and         */
+/*   warning messages are held with its predictions and saved in */
+/*   bag order too.                                              */
+/*                                                               */
+/*   The aggregation is a running (Welford-style) weighted mean, */
+/*   to which the master thread adds the bags in bag order, each */
+/*   as soon as it and the bags before it are finished.  A       */
+/*   finished bag waits in a ring of two slots per thread, so    */
+/*   memory does not grow with BagIterations; every              */
+/*   BagCheckpointInterval bags, the predictions and errors so   */
+/*   far are put out, as if Bag had stopped there.               */
+/*                                                               */
+/*   Each bag also predicts the training cases it left out, from */
+/*   its decomposition, giving out-of-bag errors without a test  */
+/*   set.                                                        */
+/*                                                               */
+/*   Copyright (c) William J. Welch 2026.                        */
+/*   All rights reserved.                                        */
+/*****************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _OPENMP
+     #include <omp.h>
+#endif
+
+#include "define.h"
+#include "implem.h"
+#include "matrix.h"
+#include "lib.h"
+#include "model.h"
+#include "kriging.h"
+#include "alex.h"
+
+extern boolean      ErrorSave;
+extern string       ErrorVar;
+
+extern boolean      BagPreds;
+extern boolean      BagReplace;
+extern boolean      RanErr;
+
+extern size_t       BagHyperNum;
+
+extern int          BagSeed;
+
+extern LinModel     RegMod;
+extern LinModel     SPMod;
+
+extern Matrix       T;
+extern Matrix       X;
+extern Matrix       XPred;
+extern Matrix       YDescrip;
+extern Matrix       YPred;
+
+extern real         *y;
+extern real         *yTrue;
+extern size_t       BagCheckInt;
+extern size_t       BagIter;
+extern size_t       BagSize;
+extern size_t       CorFamNum;
+extern size_t       Tries;
+extern size_t       nCasesXY;
+extern size_t       *IndexXY;
+extern string       yName;
+
+static string       SummaryStats[] = {VARIABLE, TRANSFORMATION,
+                         CASES, BAGS, ROOT_MSE, MAX_ERR, CASE_MAX_ERR,
+                         OOB_CASES, OOB_ROOT_MSE, OOB_MAX_ERR,
+                         CASE_OOB_MAX_ERR};
+
+/* The bags of one response.  The threads fit bag b into slot */
+/* b % nRing, and the master thread adds the finished slots   */
+/* to the running aggregation in bag order (see BagWorker).   */
+typedef struct
+{
+     /* Only read while the bags are fitted. */
+     const int          *Seed;
+     const KrigingModel *Shared;
+     size_t             j, m, nBag, nRing;
+
+     /* Next bag to be taken and number of bags aggregated. */
+     size_t             NextBag, nDone;
+
+     /* The slots, with each bag's held messages. */
+     boolean            *Ready;
+     int                *ErrBag;
+     Matrix             *ErrHeld;
+     real               *NegLogLike, *YHatBag, *SEBag, *YHatOOB;
+     size_t             *nDistinct;
+
+     /* Running aggregation (master thread only). */
+     real               *Mean, *SumWt, *MeanExact, *MeanOOB;
+     real               *YHat, *SE;
+     size_t             *nBags, *nExact, *nOOB;
+} BagRing;
+
+static int BagFitAll(KrigingModel *KrigMod, real *NegLogLike);
+static size_t BagSample(size_t nBag, size_t *Perm, size_t *BagPos);
+static void BagWorker(BagRing *Ring);
+static void BagTake(BagRing *Ring);
+static int BagFitPred(const int *Seed, size_t nBag,
+     const KrigingModel *Shared, size_t *nDistinct, real *NegLogLike,
+     real *YHat, real *SE, real *YHatOOB);
+static void BagOOB(KrigingModel *KrigMod, size_t n,
+     const size_t *BagPos, size_t *InBag, real *YHatOOB);
+static void BagAccumOOB(const real *YHatOOB, real *MeanOOB,
+     size_t *nOOB);
+static void BagPutOOB(size_t j, real *MeanOOB, const size_t *nOOB);
+static void BagCorMat(const Matrix *CorPar, real SPVar, real ErrVar,
+     KrigingModel *KrigMod);
+static void BagAccum(size_t m, const real *YHatBag, const real *SEBag,
+     real *Mean, real *SumWt, real *MeanExact, size_t *nExact);
+static void BagAggregate(size_t m, const real *Mean, const real *SumWt,
+     const real *MeanExact, const size_t *nExact, real *YHat,
+     real *SE);
+static void BagPut(size_t j, size_t nBags, size_t m, const real *YHat,
+     const real *SE);
+
+/*******************************+++*******************************/
+int Bag(void)
+/*****************************************************************/
+/*   Purpose:  Fit each response to BagIterations bags and put   */
+/*             the aggregated and the bags' predictions and      */
+/*             standard errors in YPrediction.                   */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  The bags' seeds are drawn from the sequence       */
+/*             started by BagSeed, so each response has the same */
+/*             bags (if it has the same cases); the main         */
+/*             sequence continues as if Bag had not used it.     */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: Bags fitted in parallel, each from its own      */
+/*               seeds; one progress line per bag.               */
+/*   2026.10.17: BagHyperparameters = Shared; transformations    */
+/*               not allowed.                                    */
+/*   2026.10.17: Running aggregation; BagCheckpointInterval.     */
+/*   2026.10.17: Out-of-bag errors.                              */
+/*   2026.10.17: Bags taken by the threads as they finish and    */
+/*               aggregated in order through a ring of slots     */
+/*               (BagWorker); bags' columns only if BagPreds.    */
+/*   2026.10.17: Bags' messages saved in bag order.              */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int            ErrNum, ErrReturn, xSave, ySave, zSave;
+     int            *Seed;
+     BagRing        Ring;
+     KrigingModel   AllMod;
+     real           NegLogLikeAll;
+     size_t         i, j, k, m, nBag, s;
+     string         ColName;
+#ifdef _OPENMP
+     int            nThreads;
+#endif
+
+     if (MatNumCols(&T) > 0)
+     {
+          Error("Transformations not allowed.\n");
+          return INPUT_ERR;
+     }
+
+     m = MatNumRows(&XPred);
+     if (m == 0)
+     {
+          Error("%s is empty: nothing to predict!\n", X_PRED);
+          return INPUT_ERR;
+     }
+
+     Ring.m    = m;
+     Ring.YHat = AllocReal(m, NULL);
+     Ring.SE   = AllocReal(m, NULL);
+
+     /* Running aggregation. */
+     Ring.Mean      = AllocReal(m, NULL);
+     Ring.SumWt     = AllocReal(m, NULL);
+     Ring.MeanExact = AllocReal(m, NULL);
+     Ring.nExact    = AllocSize_t(m, NULL);
+
+     /* Two slots per thread: a thread can fit its next bag */
+     /* while its last waits for the bags before it.        */
+#ifdef _OPENMP
+     nThreads   = (int) min(BagIter, (size_t) omp_get_max_threads());
+     Ring.nRing = min(2 * (size_t) nThreads, BagIter);
+#else
+     Ring.nRing = 1;
+#endif
+
+     Seed            = AllocInt(3 * BagIter, NULL);
+     Ring.Seed       = Seed;
+     Ring.Ready      = AllocInt(Ring.nRing, NULL);
+     Ring.ErrHeld    = (Matrix *) AllocGeneric(Ring.nRing,
+                              sizeof(Matrix), NULL);
+     Ring.ErrBag     = AllocInt(Ring.nRing, NULL);
+     Ring.NegLogLike = AllocReal(Ring.nRing, NULL);
+     Ring.nDistinct  = AllocSize_t(Ring.nRing, NULL);
+     Ring.YHatBag    = AllocReal(Ring.nRing * m, NULL);
+     Ring.SEBag      = AllocReal(Ring.nRing * m, NULL);
+     for (s = 0; s < Ring.nRing; s++)
+          MatInit(RECT, MIXED, YES, &Ring.ErrHeld[s]);
+
+     Ring.nBags = MatSize_tColAdd(BAGS, &YDescrip);
+
+     RandGetState(&xSave, &ySave, &zSave);
+
+     Output("%20s%5s%7s%16s\n", "Variable", "Bag", "Cases",
+               "LogLikelihood");
+
+     ErrReturn = OK;
+     ErrorSave = YES;
+     for (j = 0; j < MatNumRows(&YDescrip); j++)
+     {
+          if (DbIndexXY(j) == 0)
+               continue;
+
+          ErrorVar = yName;
+
+          nBag = (BagSize > 0) ? BagSize : nCasesXY;
+          if (!BagReplace && nBag > nCasesXY)
+          {
+               Error("%s is %lu but there are only %lu cases.\n",
+                         BAG_SIZE, (unsigned long) nBag,
+                         (unsigned long) nCasesXY);
+               ErrReturn = INPUT_ERR;
+               continue;
+          }
+
+          /* All seeds are drawn before any bag is fitted. */
+          RandInit(BagSeed, BagSeed, BagSeed);
+          for (i = 0; i < 3 * BagIter; i++)
+               Seed[i] = RandSeed();
+
+          /* The fit to all cases restarts the sequence, so it  */
+          /* does not depend on BagIterations.                  */
+          Ring.Shared = NULL;
+          if (BagHyperNum == BAG_HYPER_SHARED)
+          {
+               RandInit(BagSeed, BagSeed, BagSeed);
+               ErrNum = BagFitAll(&AllMod, &NegLogLikeAll);
+               if (ErrNum != OK)
+               {
+                    Output("%20s%5s%7lu%16s\n", yName, "All",
+                              (unsigned long) nCasesXY, NOT_AVAIL);
+                    Error("Cannot fit all cases for shared "
+                              "correlation parameters.\n");
+                    KrigModFree(&AllMod);
+                    ErrReturn = ErrNum;
+                    continue;
+               }
+               Output("%20s%5s%7lu%16g\n", yName, "All",
+                         (unsigned long) nCasesXY, -NegLogLikeAll);
+               Ring.Shared = &AllMod;
+          }
+
+          /* The columns for all the bags come before the */
+          /* checkpoints' (BagPut finds them).            */
+          ColName = StrPaste(3, PRED, ".", yName);
+          MatColAdd(ColName, &YPred);
+          AllocFree(ColName);
+
+          ColName = StrPaste(3, STD_ERR, ".", yName);
+          MatColAdd(ColName, &YPred);
+          AllocFree(ColName);
+
+          if (yTrue != NULL)
+          {
+               MatColAdd(ROOT_MSE, &YDescrip);
+               MatColAdd(MAX_ERR,  &YDescrip);
+               MatStrColAdd(CASE_MAX_ERR, &YDescrip);
+          }
+
+          Ring.YHatOOB = AllocReal(Ring.nRing * nCasesXY, NULL);
+          Ring.MeanOOB = AllocReal(nCasesXY, NULL);
+          Ring.nOOB    = AllocSize_t(nCasesXY, NULL);
+
+          VecInit(0.0, m, Ring.Mean);
+          VecInit(0.0, m, Ring.SumWt);
+          VecInit(0.0, m, Ring.MeanExact);
+          for (i = 0; i < m; i++)
+               Ring.nExact[i] = 0;
+          VecInit(0.0, nCasesXY, Ring.MeanOOB);
+          for (k = 0; k < nCasesXY; k++)
+               Ring.nOOB[k] = 0;
+
+          Ring.j    = j;
+          Ring.nBag = nBag;
+          Ring.nBags[j] = 0;
+          Ring.NextBag = Ring.nDone = 0;
+          for (s = 0; s < Ring.nRing; s++)
+               Ring.Ready[s] = NO;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nThreads) if (nThreads > 1)
+#endif
+          BagWorker(&Ring);
+
+          if (Ring.Shared != NULL)
+               KrigModFree(&AllMod);
+
+          if (Ring.nBags[j] == 0)
+          {
+               Error("No bag could be fitted.\n");
+               ErrReturn = NUMERIC_ERR;
+          }
+
+          BagAggregate(m, Ring.Mean, Ring.SumWt, Ring.MeanExact,
+                    Ring.nExact, Ring.YHat, Ring.SE);
+          BagPut(j, BagIter, m, Ring.YHat, Ring.SE);
+
+          BagPutOOB(j, Ring.MeanOOB, Ring.nOOB);
+
+          AllocFree(Ring.YHatOOB);
+          AllocFree(Ring.MeanOOB);
+          AllocFree(Ring.nOOB);
+     }
+
+     RandInit(xSave, ySave, zSave);
+
+     Output("\n");
+
+     OutputSummary(&YDescrip, NumStr(SummaryStats), SummaryStats);
+
+     AllocFree(Ring.YHat);
+     AllocFree(Ring.SE);
+     AllocFree(Ring.Mean);
+     AllocFree(Ring.SumWt);
+     AllocFree(Ring.MeanExact);
+     AllocFree(Ring.nExact);
+     AllocFree(Seed);
+     AllocFree(Ring.Ready);
+     for (s = 0; s < Ring.nRing; s++)
+          MatFree(&Ring.ErrHeld[s]);
+     AllocFree(Ring.ErrHeld);
+     AllocFree(Ring.ErrBag);
+     AllocFree(Ring.NegLogLike);
+     AllocFree(Ring.nDistinct);
+     AllocFree(Ring.YHatBag);
+     AllocFree(Ring.SEBag);
+
+     return ErrReturn;
+}
+
+/*******************************+++*******************************/
+static void BagWorker(BagRing *Ring)
+/*****************************************************************/
+/*   Purpose:  Fit bags of the current response, in one thread,  */
+/*             until none is left; the master thread also        */
+/*             aggregates them (BagTake).                        */
+/*                                                               */
+/*   Comment:  A thread takes the next bag, b, from              */
+/*             Ring->NextBag and fits it into slot b % nRing as  */
+/*             soon as bag b - nRing has been aggregated.  Thus  */
+/*             the bags go to whichever thread is free, but at   */
+/*             most nRing of them wait to be aggregated.  The    */
+/*             master thread aggregates the finished bags before */
+/*             taking each of its own and, when all are taken,   */
+/*             until the last is aggregated.  A bag's messages   */
+/*             are held in its slot (ErrorHold) for BagTake.     */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     boolean   Master, TakeNext;
+     size_t    b, m, nDone, s;
+
+#ifdef _OPENMP
+     Master = (omp_get_thread_num() == 0);
+#else
+     Master = YES;
+#endif
+
+     m = Ring->m;
+     b = BagIter;
+     TakeNext = YES;
+     for (;;)
+     {
+          if (Master)
+               BagTake(Ring);
+
+          if (TakeNext)
+          {
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+               b = Ring->NextBag++;
+               TakeNext = NO;
+          }
+
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+          nDone = Ring->nDone;
+
+          if (b >= BagIter)
+          {
+               /* All bags taken: the master waits for the rest. */
+               if (!Master || nDone == BagIter)
+                    break;
+          }
+          else if (b < nDone + Ring->nRing)
+          {
+               /* Slot s is free: bag b - nRing is aggregated. */
+#ifdef _OPENMP
+#pragma omp flush
+#endif
+               s = b % Ring->nRing;
+               ErrorHold(&Ring->ErrHeld[s]);
+               Ring->ErrBag[s] = BagFitPred(Ring->Seed + 3 * b,
+                         Ring->nBag, Ring->Shared, &Ring->nDistinct[s],
+                         &Ring->NegLogLike[s], Ring->YHatBag + s * m,
+                         Ring->SEBag + s * m,
+                         Ring->YHatOOB + s * nCasesXY);
+               ErrorHold(NULL);
+
+               /* The slot's results before its flag. */
+#ifdef _OPENMP
+#pragma omp flush
+#pragma omp atomic write
+#endif
+               Ring->Ready[s] = YES;
+
+               TakeNext = YES;
+          }
+     }
+
+     return;
+}
+
+/*******************************+++*******************************/
+static void BagTake(BagRing *Ring)
+/*****************************************************************/
+/*   Purpose:  Add the finished bags that are next in bag order  */
+/*             to the running aggregation, with each bag's held  */
+/*             messages (ErrorRelease), a progress line, its     */
+/*             columns in YPrediction if BagPreds, and the       */
+/*             checkpoints (BagPut).                             */
+/*                                                               */
+/*   Comment:  Called by the master thread only (see BagWorker). */
+/*             Shared parameters give no likelihood for a bag.   */
+/*                                                               */
+/*   2026.10.17: Created from the aggregation loop of Bag.       */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     boolean   Ready;
+     real      *NewCol;
+     size_t    b, m, s;
+     string    ColName, Suffix;
+
+     m = Ring->m;
+     for (b = Ring->nDone; b < BagIter; b++)
+     {
+          s = b % Ring->nRing;
+
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+          Ready = Ring->Ready[s];
+          if (!Ready)
+               break;
+
+#ifdef _OPENMP
+#pragma omp flush
+#endif
+          ErrorRelease(&Ring->ErrHeld[s]);
+
+          if (Ring->ErrBag[s] == OK)
+               Ring->nBags[Ring->j]++;
+
+          if (Ring->ErrBag[s] == OK && Ring->NegLogLike[s] != NA_REAL)
+               Output("%20s%5lu%7lu%16g\n", yName,
+                         (unsigned long) (b + 1),
+                         (unsigned long) Ring->nDistinct[s],
+                         -Ring->NegLogLike[s]);
+          else
+               Output("%20s%5lu%7lu%16s\n", yName,
+                         (unsigned long) (b + 1),
+                         (unsigned long) Ring->nDistinct[s], NOT_AVAIL);
+
+          BagAccum(m, Ring->YHatBag + s * m, Ring->SEBag + s * m,
+                    Ring->Mean, Ring->SumWt, Ring->MeanExact,
+                    Ring->nExact);
+          BagAccumOOB(Ring->YHatOOB + s * nCasesXY, Ring->MeanOOB,
+                    Ring->nOOB);
+
+          if (BagPreds)
+          {
+               Suffix = StrDup(StrFromSize_t(b + 1));
+
+               ColName = StrPaste(5, PRED, ".", yName, ".", Suffix);
+               NewCol = MatColAdd(ColName, &YPred);
+               AllocFree(ColName);
+               VecCopy(Ring->YHatBag + s * m, m, NewCol);
+
+               ColName = StrPaste(5, STD_ERR, ".", yName, ".", Suffix);
+               NewCol = MatColAdd(ColName, &YPred);
+               AllocFree(ColName);
+               VecCopy(Ring->SEBag + s * m, m, NewCol);
+
+               AllocFree(Suffix);
+          }
+
+          if (BagCheckInt > 0 && (b + 1) % BagCheckInt == 0 &&
+                    b + 1 < BagIter)
+          {
+               BagAggregate(m, Ring->Mean, Ring->SumWt,
+                         Ring->MeanExact, Ring->nExact, Ring->YHat,
+                         Ring->SE);
+               BagPut(Ring->j, b + 1, m, Ring->YHat, Ring->SE);
+          }
+
+          /* Free the slot, then let the threads refill it. */
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+          Ring->Ready[s] = NO;
+
+#ifdef _OPENMP
+#pragma omp flush
+#pragma omp atomic write
+#endif
+          Ring->nDone = b + 1;
+     }
+
+     return;
+}
+
+/*******************************+++*******************************/
+static int BagFitAll(KrigingModel *KrigMod, real *NegLogLike)
+/*****************************************************************/
+/*   Purpose:  Allocate KrigMod for all nCasesXY cases of the    */
+/*             current response (see DbIndexXY), fit it by       */
+/*             FitBest, and put the correlation matrix for the   */
+/*             fitted parameters in Chol, for KrigCorSub.        */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  The caller frees KrigMod.                         */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int            ErrNum;
+     Matrix         CorPar;
+     real           CondNum, CVRootMSE, ErrVar, SPVar;
+     real           *Beta;
+     unsigned       nEvals;
+
+     Beta = AllocReal(ModDF(&RegMod), NULL);
+     CorParAlloc(CorFamNum, ModDF(&SPMod), ModTermNames(&SPMod), &CorPar);
+
+     KrigModAlloc(nCasesXY, MatNumCols(&X), yName, &T, &RegMod, &SPMod,
+               CorFamNum, RanErr, KrigMod);
+     KrigModData(nCasesXY, IndexXY, &X, y, KrigMod);
+
+     SPVar = ErrVar = *NegLogLike = NA_REAL;
+     ErrNum = FitBest(KrigMod, nCasesXY, IndexXY, Tries, NO, Beta,
+               &CorPar, &SPVar, &ErrVar, NegLogLike, &CVRootMSE,
+               &nEvals, &CondNum);
+     if (ErrNum == OK)
+          BagCorMat(&CorPar, SPVar, ErrVar, KrigMod);
+
+     /* The bags need only Chol. */
+     KrigPairDistFree(KrigMod);
+
+     MatFree(&CorPar);
+     AllocFree(Beta);
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+static size_t BagSample(size_t nBag, size_t *Perm, size_t *BagPos)
+/*****************************************************************/
+/*   Purpose:  Draw nBag of the nCasesXY cases in IndexXY, with  */
+/*             replacement if BagReplace, and put the positions  */
+/*             in IndexXY of the distinct cases drawn into       */
+/*             BagPos.                                           */
+/*                                                               */
+/*   Returns:  The number of cases put in BagPos.                */
+/*                                                               */
+/*   Comment:  Perm is workspace of length nCasesXY.  The draws  */
+/*             use the calling thread's random-number sequence.  */
+/*             A case drawn more than once is put in BagPos      */
+/*             once.  Without random error, repeated cases would */
+/*             make the correlation matrix singular; with it,    */
+/*             they make it ill conditioned when the nugget is   */
+/*             small.  The number of draws of a case is not      */
+/*             used (e.g., as a smaller error variance).         */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: Positions in IndexXY rather than rows of X;     */
+/*               Distinct argument instead of RandomError.       */
+/*   2026.10.17: Always distinct cases; Distinct removed.        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    i, n;
+
+     if (BagReplace)
+     {
+          /* Perm counts the draws of each case. */
+          for (i = 0; i < nCasesXY; i++)
+               Perm[i] = 0;
+          for (i = 0; i < nBag; i++)
+               Perm[min(nCasesXY - 1,
+                         (size_t) (nCasesXY * RandUnif()))]++;
+          for (n = 0, i = 0; i < nCasesXY; i++)
+               if (Perm[i] > 0)
+                    BagPos[n++] = i;
+     }
+     else
+     {
+          /* The first nBag of a random permutation. */
+          for (i = 0; i < nCasesXY; i++)
+               Perm[i] = i;
+          PermRand(nCasesXY, Perm);
+          for (i = 0; i < nBag; i++)
+               BagPos[i] = Perm[i];
+          n = nBag;
+     }
+
+     return n;
+}
+
+/*******************************+++*******************************/
+static int BagFitPred(const int *Seed, size_t nBag,
+     const KrigingModel *Shared, size_t *nDistinct, real *NegLogLike,
+     real *YHat, real *SE, real *YHatOOB)
+/*****************************************************************/
+/*   Purpose:  Draw a bag of nBag cases for the current response */
+/*             (see DbIndexXY) from the three seeds in Seed, fit */
+/*             it, and predict XPrediction and the out-of-bag    */
+/*             cases (see BagOOB).                               */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  If Shared is NULL, the bag is fitted by FitBest.  */
+/*             Otherwise it takes the parameters of Shared (see  */
+/*             BagFitAll) and its correlation matrix is gathered */
+/*             from Shared's by KrigCorSub; *NegLogLike is NA.   */
+/*                                                               */
+/*             Called in parallel: all workspace is local, and   */
+/*             the globals are only read.  *nDistinct is the     */
+/*             number of cases fitted (see BagSample).  If the   */
+/*             bag cannot be fitted, YHat, SE, and YHatOOB are   */
+/*             NA.                                               */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: Draws its own bag; FitBest given the bag's      */
+/*               cases rather than through nCasesXY/IndexXY.     */
+/*   2026.10.17: Shared parameters.                              */
+/*   2026.10.17: Out-of-bag predictions.                         */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int            ErrNum;
+     KrigingModel   KrigMod;
+     Matrix         CorPar;
+     real           CondNum, CVRootMSE, ErrVar, SPVar;
+     real           *Beta;
+     size_t         i, n;
+     size_t         *BagIndex, *BagPos, *Perm;
+     unsigned       nEvals;
+
+     Perm     = AllocSize_t(nCasesXY, NULL);
+     BagPos   = AllocSize_t(nBag, NULL);
+     BagIndex = AllocSize_t(nBag, NULL);
+
+     RandInit(Seed[0], Seed[1], Seed[2]);
+     n = *nDistinct = BagSample(nBag, Perm, BagPos);
+     for (i = 0; i < n; i++)
+          BagIndex[i] = IndexXY[BagPos[i]];
+
+     KrigModAlloc(n, MatNumCols(&X), yName, &T, &RegMod, &SPMod,
+               CorFamNum, RanErr, &KrigMod);
+
+     *NegLogLike = NA_REAL;
+     if (Shared == NULL)
+     {
+          KrigModData(n, BagIndex, &X, y, &KrigMod);
+
+          Beta = AllocReal(ModDF(&RegMod), NULL);
+          CorParAlloc(CorFamNum, ModDF(&SPMod), ModTermNames(&SPMod),
+                    &CorPar);
+
+          SPVar = ErrVar = NA_REAL;
+          ErrNum = FitBest(&KrigMod, n, BagIndex, Tries, NO, Beta,
+                    &CorPar, &SPVar, &ErrVar, NegLogLike, &CVRootMSE,
+                    &nEvals, &CondNum);
+          if (ErrNum == OK)
+               BagCorMat(&CorPar, SPVar, ErrVar, &KrigMod);
+
+          MatFree(&CorPar);
+          AllocFree(Beta);
+     }
+     else
+     {
+          /* As KrigModData, but without the cache of distances: */
+          /* the correlations are already in Shared.             */
+          VecCopyIndex(n, BagIndex, y, NULL, KrigY(&KrigMod));
+          ModFMatRowIndex(&RegMod, n, BagIndex, &X, KrigF(&KrigMod));
+          ModFMatRowIndex(&SPMod,  n, BagIndex, &X, KrigG(&KrigMod));
+          KrigGSpacing(&KrigMod);
+
+          MatCopy(KrigCorPar(Shared), KrigCorPar(&KrigMod));
+          KrigMod.SigmaSq   = Shared->SigmaSq;
+          KrigMod.SPVarProp = Shared->SPVarProp;
+          KrigCorSub(KrigChol(Shared), BagPos, &KrigMod);
+          ErrNum = OK;
+     }
+
+     if (ErrNum == OK)
+          ErrNum = KrigDecompose(&KrigMod);
+
+     if (ErrNum == OK)
+          BagOOB(&KrigMod, n, BagPos, Perm, YHatOOB);
+     else
+          for (i = 0; i < nCasesXY; i++)
+               YHatOOB[i] = NA_REAL;
+
+     if (ErrNum == OK)
+          ErrNum = KrigPredSE(&KrigMod, &XPred, YHat, SE);
+     else
+          for (i = 0; i < MatNumRows(&XPred); i++)
+               YHat[i] = SE[i] = NA_REAL;
+
+     KrigModFree(&KrigMod);
+     AllocFree(Perm);
+     AllocFree(BagPos);
+     AllocFree(BagIndex);
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+static void BagOOB(KrigingModel *KrigMod, size_t n,
+     const size_t *BagPos, size_t *InBag, real *YHatOOB)
+/*****************************************************************/
+/*   Purpose:  Predict the current response's cases that are     */
+/*             not among the n in BagPos (see BagSample) from    */
+/*             KrigMod, which must be decomposed: YHatOOB[k] is  */
+/*             for case IndexXY[k], or NA if it is in the bag.   */
+/*                                                               */
+/*   Comment:  InBag is workspace of length nCasesXY.  Only      */
+/*             predictions, via PredYHatSE: O(n) per case.       */
+/*             If the predictions fail, YHatOOB is all NA.       */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     Matrix    XOOB;
+     real      *xRow, *YHat;
+     size_t    i, k, nOOB;
+
+     for (k = 0; k < nCasesXY; k++)
+     {
+          InBag[k]   = NO;
+          YHatOOB[k] = NA_REAL;
+     }
+     for (i = 0; i < n; i++)
+          InBag[BagPos[i]] = YES;
+
+     for (nOOB = 0, k = 0; k < nCasesXY; k++)
+          if (!InBag[k])
+               nOOB++;
+
+     if (nOOB == 0)
+          return;
+
+     MatAlloc(nOOB, MatNumCols(&X), RECT, &XOOB);
+     xRow = AllocReal(MatNumCols(&X), NULL);
+     YHat = AllocReal(nOOB, NULL);
+
+     for (i = 0, k = 0; k < nCasesXY; k++)
+          if (!InBag[k])
+          {
+               MatRow(&X, IndexXY[k], xRow);
+               MatRowPut(xRow, i++, &XOOB);
+          }
+
+     if (PredYHatSE(KrigMod, &XOOB, YHat, NULL) == OK)
+          for (i = 0, k = 0; k < nCasesXY; k++)
+               if (!InBag[k])
+                    YHatOOB[k] = YHat[i++];
+
+     MatFree(&XOOB);
+     AllocFree(xRow);
+     AllocFree(YHat);
+}
+
+/*******************************+++*******************************/
+static void BagAccumOOB(const real *YHatOOB, real *MeanOOB,
+     size_t *nOOB)
+/*****************************************************************/
+/*   Purpose:  Add one bag's predictions of the training cases,  */
+/*             YHatOOB (see BagOOB), to the running averages.    */
+/*                                                               */
+/*   Comment:  MeanOOB[k] is the plain average of the            */
+/*             predictions of case IndexXY[k] over the nOOB[k]   */
+/*             bags so far that left it out, as standard errors  */
+/*             are not computed.  NA's (cases in the bag) are    */
+/*             left out.                                         */
+/*                                                               */
+/*   2026.10.17: Created (from BagPutOOB).                       */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    k;
+
+     for (k = 0; k < nCasesXY; k++)
+          if (YHatOOB[k] != NA_REAL)
+          {
+               nOOB[k]++;
+               MeanOOB[k] += (YHatOOB[k] - MeanOOB[k]) / nOOB[k];
+          }
+}
+
+/*******************************+++*******************************/
+static void BagPutOOB(size_t j, real *MeanOOB, const size_t *nOOB)
+/*****************************************************************/
+/*   Purpose:  Put the out-of-bag errors for response j in       */
+/*             YDescription: OOBCases (the cases out of at least */
+/*             one bag), OOBRootMSE, OOBMaxErr, and              */
+/*             CaseOOBMaxErr.                                    */
+/*                                                               */
+/*   Comment:  MeanOOB and nOOB are from BagAccumOOB; MeanOOB[k] */
+/*             is set to NA if case IndexXY[k] was in every bag. */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: From the running averages of BagAccumOOB.       */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      *MaxErr, *RMSE, *yXY;
+     size_t    IndexMaxErr, k;
+     size_t    *nCases;
+     string    *CaseMaxErr;
+
+     nCases     = MatSize_tColAdd(OOB_CASES, &YDescrip);
+     RMSE       = MatColAdd(OOB_ROOT_MSE, &YDescrip);
+     MaxErr     = MatColAdd(OOB_MAX_ERR,  &YDescrip);
+     CaseMaxErr = MatStrColAdd(CASE_OOB_MAX_ERR, &YDescrip);
+
+     yXY = AllocReal(nCasesXY, NULL);
+     for (k = 0; k < nCasesXY; k++)
+          yXY[k] = y[IndexXY[k]];
+
+     nCases[j] = 0;
+     for (k = 0; k < nCasesXY; k++)
+          if (nOOB[k] > 0)
+               nCases[j]++;
+          else
+               MeanOOB[k] = NA_REAL;
+
+     RMSE[j] = RootMSE(nCasesXY, MeanOOB, yXY, &MaxErr[j],
+               &IndexMaxErr);
+     if (IndexMaxErr != INDEX_ERR)
+          CaseMaxErr[j] = StrReplace(MatRowName(&X, IndexXY[IndexMaxErr]),
+                    CaseMaxErr[j]);
+
+     AllocFree(yXY);
+}
+
+/*******************************+++*******************************/
+static void BagCorMat(const Matrix *CorPar, real SPVar, real ErrVar,
+     KrigingModel *KrigMod)
+/*****************************************************************/
+/*   Purpose:  Put the parameters fitted by FitBest in KrigMod,  */
+/*             and the correlation matrix in Chol (as in         */
+/*             FitTryCV).                                        */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     MatCopy(CorPar, KrigCorPar(KrigMod));
+     KrigMod->SigmaSq = SPVar + ErrVar;
+     if (KrigMod->SigmaSq > 0.0)
+          KrigMod->SPVarProp = SPVar / KrigMod->SigmaSq;
+
+     KrigCorMat(0, NULL, KrigMod);
+
+     return;
+}
+
+/*******************************+++*******************************/
+static void BagAccum(size_t m, const real *YHatBag, const real *SEBag,
+     real *Mean, real *SumWt, real *MeanExact, size_t *nExact)
+/*****************************************************************/
+/*   Purpose:  Add one bag's predictions at m points, YHatBag    */
+/*             and SEBag, to the running aggregation.            */
+/*                                                               */
+/*   Comment:  For point i, Mean[i] is the average of the        */
+/*             predictions so far with weights 1 / SE^2, and     */
+/*             SumWt[i] is the sum of the weights; both are      */
+/*             updated in one pass (West's weighted form of      */
+/*             Welford's algorithm), without a sum of weighted   */
+/*             predictions that could lose precision.  Bags with */
+/*             SE = 0 (point i is in the bag) are averaged       */
+/*             separately, in MeanExact[i] over nExact[i] bags.  */
+/*             NA's are left out.                                */
+/*                                                               */
+/*   2026.10.17: Created (replaces the sums in BagAggregate).    */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      Wt;
+     size_t    i;
+
+     for (i = 0; i < m; i++)
+     {
+          if (YHatBag[i] == NA_REAL || SEBag[i] == NA_REAL)
+               continue;
+          else if (SEBag[i] == 0.0)
+          {
+               nExact[i]++;
+               MeanExact[i] += (YHatBag[i] - MeanExact[i]) / nExact[i];
+          }
+          else
+          {
+               Wt = 1.0 / (SEBag[i] * SEBag[i]);
+               SumWt[i] += Wt;
+               Mean[i]  += (Wt / SumWt[i]) * (YHatBag[i] - Mean[i]);
+          }
+     }
+}
+
+/*******************************+++*******************************/
+static void BagAggregate(size_t m, const real *Mean, const real *SumWt,
+     const real *MeanExact, const size_t *nExact, real *YHat,
+     real *SE)
+/*****************************************************************/
+/*   Purpose:  Put the aggregated predictions and standard       */
+/*             errors at m points so far (see BagAccum) in YHat  */
+/*             and SE.                                           */
+/*                                                               */
+/*   Comment:  SE[i] is 1 / sqrt(sum of the weights).  If any    */
+/*             bag has SE = 0, YHat[i] is the plain average over */
+/*             those bags and SE[i] = 0.  If no bag has point i, */
+/*             both are NA.                                      */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: From the running aggregation.                   */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    i;
+
+     for (i = 0; i < m; i++)
+     {
+          if (nExact[i] > 0)
+          {
+               YHat[i] = MeanExact[i];
+               SE[i]   = 0.0;
+          }
+          else if (SumWt[i] > 0.0)
+          {
+               YHat[i] = Mean[i];
+               SE[i]   = 1.0 / sqrt(SumWt[i]);
+          }
+          else
+               YHat[i] = SE[i] = NA_REAL;
+     }
+}
+
+/*******************************+++*******************************/
+static void BagPut(size_t j, size_t nBags, size_t m, const real *YHat,
+     const real *SE)
+/*****************************************************************/
+/*   Purpose:  Put the predictions and standard errors at the m  */
+/*             points aggregated over the first nBags bags for   */
+/*             response j in YPrediction and, if YTrue is given, */
+/*             their errors in YDescription.                     */
+/*                                                               */
+/*   Comment:  After all BagIterations bags the columns are      */
+/*             Pred.y, SE.y, RootMSE, etc.; at a checkpoint they */
+/*             are Pred.y.Bags5, SE.y.Bags5, RootMSE.Bags5, etc. */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      *MaxErr, *RMSE;
+     size_t    IndexMaxErr;
+     string    BagsStr, ColName, Suffix;
+     string    *CaseMaxErr;
+
+     if (nBags == BagIter)
+          Suffix = StrDup("");
+     else
+     {
+          BagsStr = StrDup(StrFromSize_t(nBags));
+          Suffix = StrPaste(2, ".Bags", BagsStr);
+          AllocFree(BagsStr);
+     }
+
+     ColName = StrPaste(4, PRED, ".", yName, Suffix);
+     VecCopy(YHat, m, MatColAdd(ColName, &YPred));
+     AllocFree(ColName);
+
+     ColName = StrPaste(4, STD_ERR, ".", yName, Suffix);
+     VecCopy(SE, m, MatColAdd(ColName, &YPred));
+     AllocFree(ColName);
+
+     if (yTrue != NULL)
+     {
+          ColName = StrPaste(2, ROOT_MSE, Suffix);
+          RMSE = MatColAdd(ColName, &YDescrip);
+          AllocFree(ColName);
+
+          ColName = StrPaste(2, MAX_ERR, Suffix);
+          MaxErr = MatColAdd(ColName, &YDescrip);
+          AllocFree(ColName);
+
+          ColName = StrPaste(2, CASE_MAX_ERR, Suffix);
+          CaseMaxErr = MatStrColAdd(ColName, &YDescrip);
+          AllocFree(ColName);
+
+          RMSE[j] = RootMSE(m, YHat, yTrue, &MaxErr[j], &IndexMaxErr);
+          if (IndexMaxErr != INDEX_ERR)
+               CaseMaxErr[j] = StrReplace(MatRowName(&XPred, IndexMaxErr),
+                         CaseMaxErr[j]);
+     }
+
+     AllocFree(Suffix);
+}
@@ -18,6 +18,10 @@
 #include "kriging.h"
 #include "alex.h"
 
+#ifdef _OPENMP
+     #include <omp.h>
+#endif
+
 extern boolean      ErrorSave;
 extern string       ErrorVar;
 
@@ -34,6 +38,8 @@ extern Matrix       YDescrip;
 
 extern real         *y;
 extern size_t       CorFamNum;
+extern size_t       CVFolds;
+extern size_t       CVMethodNum;
 extern size_t       nCasesXY;
 extern size_t       *IndexXY;
 extern string       yName;
@@ -42,6 +48,13 @@ static string       SummaryStats[] = {VARIABLE, TRANSFORMATION,
                          CASES, CV_ROOT_MSE, CV_MAX_ERR,
                          CASE_CV_MAX_ERR};
 
+/* Minimum number of cases per thread in CalcCVPerm. */
+#define CV_PAR_MIN  40
+
+static int CVPermBlock(KrigingModel *KrigMod, const Matrix *C,
+     Matrix *FTilde, real *YTilde, size_t iFirst, size_t iEnd,
+     real *YHatCV, real *SE);
+
 /*******************************+++*******************************/
 int CrossValidate(void)
 /*****************************************************************/
@@ -150,6 +163,281 @@ int CalcCV(KrigingModel *KrigMod, real *YHatCV, real *SE)
 /*                                                               */
 /* Args:       KrigMod   Input: Kriging model without            */
 /*                       decompositions.                         */
+/*                       Output: Decompositions for all n cases. */
+/*             YHatCV    Output: Cross-validation predictions.   */
+/*             SE        Output: Standard errors (computed only  */
+/*                       if SE != NULL).                         */
+/*                                                               */
+/* Returns:    OK or an error number.                            */
+/*                                                               */
+/* Comment:    Calling routine must allocate space for YHatCV    */
+/*             and SE.                                           */
+/*             If 1 < CVFolds < n, CalcCVFolds is used instead;  */
+/*             otherwise, if CVMethodNum is CV_METHOD_DELETION,  */
+/*             CalcCVPerm.                                       */
+/*             Closed form from one decomposition of all n       */
+/*             cases: with                                       */
+/*                  P = Inverse(C) - Inverse(C) F                */
+/*                      Inverse(F' Inverse(C) F) F' Inverse(C),  */
+/*             the leave-one-out residual for case i is          */
+/*             (P Y)[i] / P[i, i] and its mean squared error is  */
+/*             SigmaSq / P[i, i] (Dubrule, 1983), as from        */
+/*             CalcCVPerm.  As the Cholesky factor of C is       */
+/*             Chol and Inverse(Chol') F = QR,                   */
+/*                  P Y = Inverse(Chol) ResTilde,                */
+/*                  P[i, i] = Inverse(C)[i, i] - ||row i of      */
+/*                            Inverse(Chol) Q||^2.               */
+/*             Standard errors include contribution from epsilon */
+/*             in predicted observation; SigmaSq is not          */
+/*             recomputed.                                       */
+/*                                                               */
+/* 2026.10.17: Closed form; rotations moved to CalcCVPerm.       */
+/*                                                               */
+/* Version:    2026.10.17                                        */
+/*****************************************************************/
+{
+     int       ErrNum;
+     Matrix    *Chol, *Q;
+     real      *PDiag, *u, *w, *Y;
+     size_t    i, j, k, n;
+
+     Y    = KrigY(KrigMod);
+     Chol = KrigChol(KrigMod);
+     Q    = KrigQ(KrigMod);
+
+     n = MatNumRows(Q);
+     k = MatNumCols(Q);
+
+     if (CVFolds > 1 && CVFolds < n)
+          return CalcCVFolds(KrigMod, CVFolds, YHatCV, SE);
+     else if (CVMethodNum == CV_METHOD_DELETION)
+          return CalcCVPerm(KrigMod, YHatCV, SE);
+
+     if (n == 0)
+          return OK;
+     else if (n == 1)
+     {
+          YHatCV[0] = NA_REAL;
+          if (SE != NULL)
+              SE[0] = NA_REAL;
+          return OK;
+     }
+
+     PDiag = AllocReal(n, NULL);
+     u     = AllocReal(n, NULL);
+     w     = AllocReal(n, NULL);
+
+     /* Decompositions for all n cases. */
+     KrigCorMat(0, NULL, KrigMod);
+     ErrNum = KrigDecompose(KrigMod);
+
+     /* Diagonal of Inverse(C), less the squared elements of */
+     /* each column of Inverse(Chol) Q.                      */
+     if (ErrNum == OK)
+          ErrNum = TriCholInvDiag(Chol, PDiag);
+     for (j = 0; j < k && ErrNum == OK; j++)
+     {
+          ErrNum = TriBackSolve(Chol, MatCol(Q, j), w);
+          for (i = 0; i < n; i++)
+               PDiag[i] -= w[i] * w[i];
+     }
+
+     /* u = P Y. */
+     if (ErrNum == OK)
+          ErrNum = TriBackSolve(Chol, KrigMod->ResTilde, u);
+
+     for (i = 0; i < n && ErrNum == OK; i++)
+     {
+          /* P[i, i] is zero if F without case i is not of full */
+          /* rank, or (numerically) if C is ill-conditioned.     */
+          if (PDiag[i] <= 0.0)
+          {
+               Error("Cannot perform QR decomposition.\n");
+               ErrNum = NUMERIC_ERR;
+          }
+          else
+          {
+               YHatCV[i] = Y[i] - u[i] / PDiag[i];
+               if (SE != NULL)
+                    SE[i] = sqrt(KrigMod->SigmaSq / PDiag[i]);
+          }
+     }
+
+     if (ErrNum != OK)
+          for (i = 0; i < n; i++)
+          {
+               YHatCV[i] = NA_REAL;
+               if (SE != NULL)
+                    SE[i] = NA_REAL;
+          }
+
+     AllocFree(PDiag);
+     AllocFree(u);
+     AllocFree(w);
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+int CalcCVFolds(KrigingModel *KrigMod, size_t nFolds, real *YHatCV,
+     real *SE)
+/*****************************************************************/
+/* Purpose:    Compute K-fold cross-validation predictions and,  */
+/*             optionally, their standard errors: case i is in   */
+/*             fold i mod nFolds, and the cases in a fold are    */
+/*             predicted from the cases in the other folds.      */
+/*                                                               */
+/* Args:       KrigMod   Input: Kriging model without            */
+/*                       decompositions.                         */
+/*                       Output: Decompositions for all n cases. */
+/*             nFolds    Number of folds, 1 < nFolds <= n.       */
+/*             YHatCV    Output: Cross-validation predictions.   */
+/*             SE        Output: Standard errors (computed only  */
+/*                       if SE != NULL).                         */
+/*                                                               */
+/* Returns:    OK or an error number.                            */
+/*                                                               */
+/* Comment:    Folds are assigned deterministically, not at      */
+/*             random: if the cases are sorted, so are the       */
+/*             folds.                                            */
+/*             The block form of the identities in CalcCV: for   */
+/*             the cases S in a fold, the prediction errors are  */
+/*             Inverse(P[S, S]) (P Y)[S], with covariance        */
+/*             SigmaSq Inverse(P[S, S]).  Inverse(C) is computed */
+/*             once from Chol (TriCholInverse), and              */
+/*             W = Inverse(Chol) Q; then, for each fold, the     */
+/*             Schur complement                                  */
+/*                  P[S, S] = Inverse(C)[S, S] - W[S] W[S]'      */
+/*             is formed and Cholesky decomposed.  Setting up    */
+/*             costs O(n^3) for all n cases, and then a fold of  */
+/*             m cases costs O(m^3 + m^2 k).                     */
+/*             Standard errors include contribution from epsilon */
+/*             in predicted observation; SigmaSq is not          */
+/*             recomputed.                                       */
+/*                                                               */
+/* 2026.10.17: Created.                                          */
+/*                                                               */
+/* Version:    2026.10.17                                        */
+/*****************************************************************/
+{
+     int       ErrNum;
+     Matrix    CInv, PSS, W;
+     Matrix    *Chol, *Q;
+     real      Sum;
+     real      *d, *e, *u, *Y;
+     size_t    a, b, Fold, i, j, k, m, mMax, n;
+     size_t    *Case;
+
+     Y    = KrigY(KrigMod);
+     Chol = KrigChol(KrigMod);
+     Q    = KrigQ(KrigMod);
+
+     n = MatNumRows(Q);
+     k = MatNumCols(Q);
+
+     CodeCheck(nFolds > 1 && nFolds <= n);
+
+     mMax = (n + nFolds - 1) / nFolds;
+
+     MatAllocDense(n, n, UP_TRIANG, &CInv);
+     MatAlloc(n, k, RECT, &W);
+     MatAllocDense(mMax, mMax, UP_TRIANG, &PSS);
+     Case = AllocSize_t(mMax, NULL);
+     d    = AllocReal(mMax, NULL);
+     e    = AllocReal(mMax, NULL);
+     u    = AllocReal(n, NULL);
+
+     /* Decompositions for all n cases. */
+     KrigCorMat(0, NULL, KrigMod);
+     ErrNum = KrigDecompose(KrigMod);
+
+     if (ErrNum == OK)
+          ErrNum = TriCholInverse(Chol, &CInv);
+
+     /* u = P Y, and W = Inverse(Chol) Q. */
+     if (ErrNum == OK)
+          ErrNum = TriBackSolve(Chol, KrigMod->ResTilde, u);
+     for (j = 0; j < k && ErrNum == OK; j++)
+          ErrNum = TriBackSolve(Chol, MatCol(Q, j), MatCol(&W, j));
+
+     for (Fold = 0; Fold < nFolds && ErrNum == OK; Fold++)
+     {
+          /* Cases in this fold. */
+          for (m = 0, i = Fold; i < n; i += nFolds)
+               Case[m++] = i;
+
+          /* P[S, S], upper triangle. */
+          MatPutNumRows(&PSS, m);
+          MatPutNumCols(&PSS, m);
+          for (b = 0; b < m; b++)
+               for (a = 0; a <= b; a++)
+               {
+                    Sum = MatElem(&CInv, Case[a], Case[b]);
+                    for (j = 0; j < k; j++)
+                         Sum -= MatElem(&W, Case[a], j)
+                                   * MatElem(&W, Case[b], j);
+                    MatPutElem(&PSS, a, b, Sum);
+               }
+
+          /* P[S, S] is singular if F without the fold is not */
+          /* of full rank.                                    */
+          if (TriCholesky(&PSS, 0, &PSS) != OK)
+          {
+               Error("Cannot perform QR decomposition.\n");
+               ErrNum = NUMERIC_ERR;
+               break;
+          }
+
+          /* Prediction errors e = Inverse(P[S, S]) (P Y)[S]. */
+          for (a = 0; a < m; a++)
+               d[a] = u[Case[a]];
+          ErrNum = TriForSolve(&PSS, d, 0, e);
+          if (ErrNum == OK)
+               ErrNum = TriBackSolve(&PSS, e, e);
+          if (ErrNum == OK && SE != NULL)
+               ErrNum = TriCholInvDiag(&PSS, d);
+
+          if (ErrNum == OK)
+               for (a = 0; a < m; a++)
+               {
+                    YHatCV[Case[a]] = Y[Case[a]] - e[a];
+                    if (SE != NULL)
+                         SE[Case[a]] = sqrt(KrigMod->SigmaSq * d[a]);
+               }
+     }
+
+     if (ErrNum != OK)
+          for (i = 0; i < n; i++)
+          {
+               YHatCV[i] = NA_REAL;
+               if (SE != NULL)
+                    SE[i] = NA_REAL;
+          }
+
+     MatPutNumRows(&PSS, mMax);
+     MatPutNumCols(&PSS, mMax);
+
+     MatFree(&CInv);
+     MatFree(&W);
+     MatFree(&PSS);
+     AllocFree(Case);
+     AllocFree(d);
+     AllocFree(e);
+     AllocFree(u);
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+int CalcCVPerm(KrigingModel *KrigMod, real *YHatCV, real *SE)
+/*****************************************************************/
+/* Purpose:    As CalcCV, but by deleting each case in turn:     */
+/*             its column of the Cholesky factor is moved to the */
+/*             end by TriPerm and the regression is re-fitted.   */
+/*             This is the reference for CalcCV.                 */
+/*                                                               */
+/* Args:       KrigMod   Input: Kriging model without            */
+/*                       decompositions.                         */
 /*                       Output: Decompositions are garbage.     */
 /*             YHatCV    Output: Cross-validation predictions.   */
 /*             SE        Output: Standard errors (computed only  */
@@ -163,31 +451,31 @@ int CalcCV(KrigingModel *KrigMod, real *YHatCV, real *SE)
 /*             KrigMod decompositions are changed.               */
 /*             Standard errors include contribution from epsilon */
 /*             in predicted observation.                         */
+/*             Given the factor of C for all n cases, the cases  */
+/*             are independent.  If compiled with OpenMP, each   */
+/*             thread takes a contiguous block of cases and its  */
+/*             own copies of the factor, FTilde, and YTilde (see */
+/*             CVPermBlock).                                     */
 /* 1995.02.21: SigmaSq not recomputed.                           */
 /* 1996.04.12: Temporary output showing progress.                */
+/* 2026.10.16: C and FTilde have MAT_DENSE storage.              */
+/* 2026.10.17: Renamed from CalcCV.                              */
+/* 2026.10.17: Blocks of cases processed concurrently.           */
 /*                                                               */
-/* Version:    1996.04.12                                        */
+/* Version:    2026.10.17                                        */
 /*****************************************************************/
 {
      int       ErrNum;
+     int       *ErrBlock;
      Matrix    C, FTilde;
-     Matrix    *Chol, *F, *Q, *R;
-     real      c, s, t;
-     real      *Col, *Beta, *f, *r, *RBeta, *ResTilde, *Y, *YTilde;
-     size_t    i, ii, j, k, m, n;
+     Matrix    *Chol, *F;
+     real      *Y, *YTilde;
+     size_t    i, k, n, nBlocks;
+     long      b;
 
      Y    = KrigY(KrigMod);
      F    = KrigF(KrigMod);
      Chol = KrigChol(KrigMod);
-     Q    = KrigQ(KrigMod);
-     R    = KrigR(KrigMod);
-
-     /* Use workspace in KrigMod. */
-     f        = KrigMod->fRow;
-     r        = KrigMod->r;
-     RBeta    = KrigMod->RBeta;
-     Beta     = KrigMod->Beta;
-     ResTilde = KrigMod->ResTilde;
 
      n = MatNumRows(F);
      k = MatNumCols(F);
@@ -202,12 +490,10 @@ int CalcCV(KrigingModel *KrigMod, real *YHatCV, real *SE)
           return OK;
      }
 
-     MatAlloc(n, n, UP_TRIANG, &C);
-     MatAlloc(n, k, RECT, &FTilde);
+     MatAllocDense(n, n, UP_TRIANG, &C);
+     MatAllocDense(n, k, RECT, &FTilde);
      YTilde = AllocReal(n, NULL);
 
-     MatPutNumRows(Q, n - 1);
-
      /* Put correlation matrix in C. */
      KrigCorMat(0, NULL, KrigMod);
      MatCopy(Chol, &C);
@@ -225,8 +511,144 @@ int CalcCV(KrigingModel *KrigMod, real *YHatCV, real *SE)
      if (ErrNum == OK)
           ErrNum = KrigSolve(Chol, F, Y, &FTilde, YTilde);
 
+     nBlocks = 1;
+#ifdef _OPENMP
+     if (!omp_in_parallel() && n >= 2 * CV_PAR_MIN)
+          nBlocks = min((size_t) omp_get_max_threads(), n / CV_PAR_MIN);
+#endif
+     ErrBlock = AllocInt(nBlocks, NULL);
+
+     if (ErrNum == OK && nBlocks == 1)
+          /* Chol, FTilde, and YTilde can be overwritten. */
+          ErrBlock[0] = CVPermBlock(KrigMod, &C, &FTilde, YTilde, 0,
+                    n, YHatCV, SE);
+
+     else if (ErrNum == OK)
+     {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) num_threads(nBlocks)
+#endif
+          for (b = 0; b < (long) nBlocks; b++)
+          {
+               KrigingModel   BlockMod;
+               Matrix         BlockF;
+               real           *BlockY;
+
+               /* BlockMod shares the data and parameters of */
+               /* KrigMod, with its own decompositions and   */
+               /* workspace.                                 */
+               BlockMod = *KrigMod;
+               MatAllocDense(n, n, UP_TRIANG, KrigChol(&BlockMod));
+               MatAllocDense(n, k, RECT, KrigQ(&BlockMod));
+               MatAlloc(k, k, UP_TRIANG, KrigR(&BlockMod));
+               BlockMod.RBeta    = AllocReal(k, NULL);
+               BlockMod.ResTilde = AllocReal(n, NULL);
+               BlockMod.fRow     = AllocReal(k, NULL);
+               BlockMod.r        = AllocReal(n, NULL);
+
+               MatCopy(Chol, KrigChol(&BlockMod));
+               MatAllocDense(n, k, RECT, &BlockF);
+               MatCopy(&FTilde, &BlockF);
+               BlockY = AllocReal(n, NULL);
+               VecCopy(YTilde, n, BlockY);
+
+               ErrBlock[b] = CVPermBlock(&BlockMod, &C, &BlockF,
+                         BlockY, (size_t) b * n / nBlocks,
+                         (size_t) (b + 1) * n / nBlocks, YHatCV, SE);
+
+               MatFree(KrigChol(&BlockMod));
+               MatFree(KrigQ(&BlockMod));
+               MatFree(KrigR(&BlockMod));
+               AllocFree(BlockMod.RBeta);
+               AllocFree(BlockMod.ResTilde);
+               AllocFree(BlockMod.fRow);
+               AllocFree(BlockMod.r);
+               MatFree(&BlockF);
+               AllocFree(BlockY);
+          }
+     }
+
+     /* First error, in case order. */
+     for (b = 0; b < (long) nBlocks && ErrNum == OK; b++)
+          ErrNum = ErrBlock[b];
+
+     OutputTemp("");
+
+     if (ErrNum != OK)
+          for (i = 0; i < n; i++)
+          {
+               YHatCV[i] = NA_REAL;
+               if (SE != NULL)
+                    SE[i] = NA_REAL;
+          }
+
+     MatFree(&C);
+     MatFree(&FTilde);
+     AllocFree(YTilde);
+     AllocFree(ErrBlock);
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+static int CVPermBlock(KrigingModel *KrigMod, const Matrix *C,
+     Matrix *FTilde, real *YTilde, size_t iFirst, size_t iEnd,
+     real *YHatCV, real *SE)
+/*****************************************************************/
+/* Purpose:    Cross validate cases iFirst,..., iEnd - 1 for     */
+/*             CalcCVPerm.                                       */
+/*                                                               */
+/* Args:       KrigMod   Input: the Cholesky factor of C for all */
+/*                       n cases.                                */
+/*                       Output: Decompositions are garbage.     */
+/*             C         The correlation matrix.                 */
+/*             FTilde,   Input: Inverse(Chol') F and             */
+/*             YTilde    Inverse(Chol') Y for all n cases.       */
+/*                       Output: garbage.                        */
+/*                                                               */
+/* Returns:    OK or an error number.                            */
+/*                                                               */
+/* Comment:    The cases are deleted in the order iEnd - 1,...,  */
+/*             iFirst, each moved to the last column of the      */
+/*             factor, so that cases before iFirst never move.   */
+/*             Order[j] is the case in column j.                 */
+/*                                                               */
+/* 2026.10.17: Created from the loop in CalcCVPerm.              */
+/*                                                               */
+/* Version:    2026.10.17                                        */
+/*****************************************************************/
+{
+     int       ErrNum;
+     Matrix    *Chol, *F, *Q, *R;
+     real      c, s, t;
+     real      *Col, *f, *r, *RBeta, *ResTilde;
+     size_t    i, ii, j, k, m, n;
+     size_t    *Order;
+
+     F    = KrigF(KrigMod);
+     Chol = KrigChol(KrigMod);
+     Q    = KrigQ(KrigMod);
+     R    = KrigR(KrigMod);
+
+     /* Use workspace in KrigMod. */
+     f        = KrigMod->fRow;
+     r        = KrigMod->r;
+     RBeta    = KrigMod->RBeta;
+     ResTilde = KrigMod->ResTilde;
+
+     n = MatNumRows(F);
+     k = MatNumCols(F);
+
+     Order = AllocSize_t(n, NULL);
+     for (j = 0; j < n; j++)
+          Order[j] = j;
+
+     MatPutNumRows(Q, n - 1);
+
      /* Delete case i and predict Y[i]. */
-     for (i = n - 1, ii = 0; ii < n && ErrNum == OK; ii++, i--)
+     ErrNum = OK;
+     for (i = iEnd - 1, ii = iFirst; ii < iEnd && ErrNum == OK;
+               ii++, i--)
      {
           OutputTemp("Cross validating variable: %s  Run: %d",
                     yName, i + 1);
@@ -243,19 +665,21 @@ int CalcCV(KrigingModel *KrigMod, real *YHatCV, real *SE)
                YTilde[j]   = t;
                for (m = 0; m < k; m++)
                {
-                    Col      = MatCol(&FTilde, m);
+                    Col      = MatCol(FTilde, m);
                     t        =  c * Col[j] + s * Col[j+1];
                     Col[j+1] = -s * Col[j] + c * Col[j+1];
                     Col[j]   = t;
                }
+
+               Order[j]   = Order[j+1];
+               Order[j+1] = i;
           }
 
-          /* Correlations between case i and the other cases.  */
-          /* Note that cases after i are now in reverse order. */
-          for (j = 0; j < i; j++)
-               r[j] = MatElem(&C, j, i);
-          for (j = 0; j < n - 1 - i; j++)
-               r[i+j] = MatElem(&C, i, n - 1 - j);
+          /* Correlations between case i and the other cases, */
+          /* in the order of the columns of Chol.             */
+          for (j = 0; j < n - 1; j++)
+               r[j] = (Order[j] < i) ? MatElem(C, Order[j], i)
+                                     : MatElem(C, i, Order[j]);
 
           /* Linear model terms for case i. */
           MatRow(F, i, f);
@@ -263,10 +687,10 @@ int CalcCV(KrigingModel *KrigMod, real *YHatCV, real *SE)
           /* Pretend we have only n - 1 cases. */
           MatPutNumRows(Chol, n - 1);
           MatPutNumCols(Chol, n - 1);
-          MatPutNumRows(&FTilde, n - 1);
+          MatPutNumRows(FTilde, n - 1);
 
           /* Gram-Schmidt QR orthogonalization of FTilde. */
-          if (QRLS(&FTilde, YTilde, Q, R, RBeta, ResTilde) != OK)
+          if (QRLS(FTilde, YTilde, Q, R, RBeta, ResTilde) != OK)
           {
                Error("Cannot perform QR decomposition.\n");
                ErrNum = NUMERIC_ERR;
@@ -286,37 +710,22 @@ int CalcCV(KrigingModel *KrigMod, real *YHatCV, real *SE)
                }
                */
 
-               if (SE != NULL)
-               {
-                    /* Standard error required.             */
-                    /* KrigMod->SigmaSq is not updated.     */
-                    /* RAve = 1.0 for epsilon contribution. */
-                    ErrNum = KrigYHatSE(KrigMod, 1.0, f, r,
-                              &YHatCV[i], &SE[i]);
-               }
-               else
-                    /* No standard error. */
-                    ErrNum = KrigYHatSE(KrigMod, 1.0, f, r,
-                              &YHatCV[i], NULL);
+               /* Standard error required if SE != NULL.  */
+               /* KrigMod->SigmaSq is not updated.        */
+               /* RAve = 1.0 for epsilon contribution.    */
+               ErrNum = KrigYHatSE(KrigMod, 1.0, f, r, &YHatCV[i],
+                         (SE != NULL) ? &SE[i] : NULL);
           }
 
           /* Restore sizes of Chol and FTilde. */
           MatPutNumRows(Chol, n);
           MatPutNumCols(Chol, n);
-          MatPutNumRows(&FTilde, n);
+          MatPutNumRows(FTilde, n);
      }
 
-     OutputTemp("");
-
-     if (ErrNum != OK)
-          for (i = 0; i < n; i++)
-               YHatCV[i] = SE[i] = NA_REAL;
-
      MatPutNumRows(Q, n);
 
-     MatFree(&C);
-     MatFree(&FTilde);
-     AllocFree(YTilde);
+     AllocFree(Order);
 
      return ErrNum;
 }
@@ -18,11 +18,15 @@
 #include "kriging.h"
 #include "alex.h"
 
+#ifdef _OPENMP
+     #include <omp.h>
+#endif
+
 extern size_t       nPointers;
 
 extern boolean      ErrorSave;
 extern string       ErrorVar;
-extern size_t       ErrorTry;
+extern THREAD_LOCAL size_t ErrorTry;
 
 extern boolean      RanErr;
 
@@ -36,6 +40,7 @@ extern Matrix       X;
 extern Matrix       YDescrip;
 
 extern real         CritLogLikeDiff;
+extern real         CVLogLikeMargin;
 extern real         LogLikeTol;
 extern real         *y;
 extern size_t       CorFamNum;
@@ -48,6 +53,14 @@ extern string       yName;
 static string       SummaryStats[] = {VARIABLE, TRANSFORMATION,
                          CASES, LOG_LIKE, CV_ROOT_MSE, COND_NUM};
 
+static int FitTry(KrigingModel *KrigMod, size_t Try, const int *Seed,
+     real SPVarStart, real ErrVarStart, real *Beta, real *CorParVec,
+     real *SPVar, real *ErrVar, real *NegLogLike, unsigned *nEvals,
+     real *CondNum, size_t *Iter);
+
+static int FitTryCV(KrigingModel *KrigMod, const real *CorParVec,
+     real SPVar, real ErrVar, real *YHatCV, real *CVRootMSE);
+
 /*******************************+++*******************************/
 int Fit(void)
 /*****************************************************************/
@@ -59,8 +72,10 @@ int Fit(void)
 /*   1996.04.05: Completed removed (temporary output in krmle)   */
 /*   1996.04.14: KrigModAlloc/KrigModData; DbIndexXY             */
 /*   2009.05.07: Multiple correlation families                   */
+/*   2026.10.17: Fitted models saved to the FittedModel file.    */
 /*****************************************************************/
 {
+     FILE           *ModFile;
      int            ErrNum;
      KrigingModel   KrigMod;
      Matrix         CorPar;
@@ -87,6 +102,8 @@ int Fit(void)
      /* for one response.                           */
      CorParAlloc(CorFamNum, ModDF(&SPMod), ModTermNames(&SPMod), &CorPar);
 
+     ModFile = FittedModelOpen(YES);
+
      Output("%20s%5s%11s%16s\n", "Variable", "Try", "Iteration",
                "LogLikelihood");
 
@@ -106,8 +123,8 @@ int Fit(void)
                     &SPMod, CorFamNum, RanErr, &KrigMod);
           KrigModData(nCasesXY, IndexXY, &X, y, &KrigMod);
 
-          ErrNum = FitBest(&KrigMod, Tries, Beta, &CorPar,
-                    &SPVar[j], &ErrVar[j], &NegLogLike,
+          ErrNum = FitBest(&KrigMod, nCasesXY, IndexXY, Tries, YES,
+                    Beta, &CorPar, &SPVar[j], &ErrVar[j], &NegLogLike,
                     &CVRootMSE[j], &nEvals, &CondNum[j]);
 
           TotEvals += nEvals;
@@ -132,9 +149,20 @@ int Fit(void)
                          NewCol);
           }
 
+          /* Decompositions for the fitted parameters, */
+          /* as Predict would set them up.             */
+          if (ModFile != NULL && ErrNum == OK &&
+                    KrigModSetUp(&SPModMat, yName, SPVar[j],
+                    ErrVar[j], &KrigMod) == OK)
+               KrigModWrite(ModFile, &KrigMod,
+                         KrigDataHash(nCasesXY, IndexXY, &X, y));
+
           KrigModFree(&KrigMod);
      }
 
+     if (ModFile != NULL)
+          fclose(ModFile);
+
      Output("\n");
 
      OutputSummary(&YDescrip, NumStr(SummaryStats), SummaryStats);
@@ -148,32 +176,195 @@ int Fit(void)
 }
 
 /*******************************+++*******************************/
-int FitBest(KrigingModel *KrigMod, size_t Tries, real *Beta,
-     Matrix *CorPar, real *SPVar, real *ErrVar, real *NegLogLike,
-     real *CVRootMSE, unsigned *nEvals, real *CondNum)
+int FitBest(KrigingModel *KrigMod, size_t nCases,
+     const size_t *RowIndex, size_t Tries, boolean Progress,
+     real *Beta, Matrix *CorPar, real *SPVar, real *ErrVar,
+     real *NegLogLike, real *CVRootMSE, unsigned *nEvals,
+     real *CondNum)
 /*****************************************************************/
-/* Purpose:    Choose best of several MLE tries.                 */
+/* Purpose:    Choose best of several MLE tries for KrigMod,     */
+/*             whose data are rows RowIndex[0],...,              */
+/*             RowIndex[nCases - 1] of X and y.                  */
 /*                                                               */
 /* Returns:    OK or an error condition.                         */
 /*                                                               */
+/* Comment:    The tries are independent.  Each has its own      */
+/*             random-number sequence, seeded in turn from the   */
+/*             main sequence, and the best is chosen in try      */
+/*             order, so the result does not depend on how many  */
+/*             threads run the tries (OpenMP).  Threads other    */
+/*             than the first fit their own copy of KrigMod,     */
+/*             which reads KrigMod's cache of pairwise distances */
+/*             (KrigPairDistShare) instead of building another.  */
+/*             Cross validation is only for the tries that can   */
+/*             be chosen.  Under the likelihood criterion, that  */
+/*             is the best try (or, if its cross validation      */
+/*             fails, the next best, etc.).  Under the cross-    */
+/*             validation criterion, it is the tries with log    */
+/*             likelihood within CVLogLikeMargin of the best.    */
+/*                                                               */
 /* 1996.03.07: First try starts from existing model parameters   */
 /*             if they are available.                            */
 /* 1996.04.05: Completed removed (temporary output in krmle).    */
 /* 1999.04.23: Compare models via user-defined criterion.        */
+/* 2026.10.17: Tries run concurrently by FitTry, one random-     */
+/*             number sequence per try; progress lines output    */
+/*             here in try order.                                */
+/* 2026.10.17: Cross validation only for tries that can be       */
+/*             chosen (FitTryCV).                                */
+/* 2026.10.17: nCases and RowIndex instead of nCasesXY and       */
+/*             IndexXY, and progress lines only if Progress, so  */
+/*             that Bag can fit several bags at once.  Inside a  */
+/*             parallel region the tries run in this thread.     */
+/* 2026.10.17: Copies of KrigMod share its cache of pairwise     */
+/*             distances.                                        */
 /*                                                               */
-/* Version:    1999.04.23                                        */
+/* Version:    2026.10.17                                        */
 /*****************************************************************/
 {
      boolean   Better;
-     int       ErrNum, ErrThisTry;
-     Matrix    RegCorPar;
-     real      CondNumTry, CVRootMSETry, MaxErr;
-     real      NegLogLikeTry;
-     real      *YHatCV;
-     size_t    IndexMaxErr, j;
-     unsigned  nEvalsTry;
+     int       ErrNum, xSave, ySave, zSave;
+     int       *ErrTry, *Seed;
+     KrigingModel   *ThreadMod;
+     real      ErrVarStart, NegLogLikeBest, SPVarStart;
+     real      *BetaTry, *CondNumTry, *CorParTry, *CVRootMSETry;
+     real      *ErrVarTry, *NegLogLikeTry, *SPVarTry, *YHatCV;
+     size_t    c, j, jBest, k, m, nCands, nCorPars, nMods;
+     size_t    *Cand, *IterTry;
+     unsigned  *nEvalsTry;
+
+     k        = ModDF(KrigRegMod(KrigMod));
+     nCorPars = MatNumRows(CorPar) * MatNumCols(CorPar);
+
+#ifdef _OPENMP
+     nMods = omp_in_parallel() ? 1 :
+               min(Tries, (size_t) omp_get_max_threads());
+#else
+     nMods = 1;
+#endif
+     nMods = max(nMods, 1);
+
+     /* Kriging models for threads other than the first. */
+     ThreadMod = (KrigingModel *) AllocGeneric(nMods - 1,
+               sizeof(KrigingModel), NULL);
+     for (m = 0; m < nMods - 1; m++)
+     {
+          KrigModAlloc(nCases, MatNumCols(&X), yName, &T, &RegMod,
+                    &SPMod, CorFamNum, RanErr, &ThreadMod[m]);
+
+          /* As KrigModData, but the cache of distances is */
+          /* KrigMod's, which has the same G.              */
+          VecCopyIndex(nCases, RowIndex, y, NULL, KrigY(&ThreadMod[m]));
+          ModFMatRowIndex(&RegMod, nCases, RowIndex, &X,
+                    KrigF(&ThreadMod[m]));
+          ModFMatRowIndex(&SPMod,  nCases, RowIndex, &X,
+                    KrigG(&ThreadMod[m]));
+          KrigGSpacing(&ThreadMod[m]);
+          KrigPairDistShare(KrigMod, &ThreadMod[m]);
+     }
+
+     /* Results for each try. */
+     ErrTry        = AllocInt(Tries, NULL);
+     Seed          = AllocInt(3 * Tries, NULL);
+     BetaTry       = AllocReal(Tries * k, NULL);
+     CondNumTry    = AllocReal(Tries, NULL);
+     CorParTry     = AllocReal(Tries * nCorPars, NULL);
+     CVRootMSETry  = AllocReal(Tries, NULL);
+     ErrVarTry     = AllocReal(Tries, NULL);
+     NegLogLikeTry = AllocReal(Tries, NULL);
+     SPVarTry      = AllocReal(Tries, NULL);
+     IterTry       = AllocSize_t(Tries, NULL);
+     Cand          = AllocSize_t(Tries, NULL);
+     nEvalsTry     = AllocGeneric(Tries, sizeof(unsigned), NULL);
+
+     /* Cross-validation predictions for each thread. */
+     YHatCV = AllocReal(nMods * nCases, NULL);
+
+     /* Seeds for the tries' random-number sequences. */
+     for (j = 0; j < 3 * Tries; j++)
+          Seed[j] = RandSeed();
+     RandGetState(&xSave, &ySave, &zSave);
+
+     /* Starting variances for the first try. */
+     SPVarStart  = *SPVar;
+     ErrVarStart = *ErrVar;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) private(m) \
+          num_threads(nMods) if (nMods > 1)
+#endif
+     for (j = 0; j < Tries; j++)
+     {
+#ifdef _OPENMP
+          m = omp_get_thread_num();
+#else
+          m = 0;
+#endif
+          ErrTry[j] = FitTry((m == 0) ? KrigMod : &ThreadMod[m-1],
+                    j + 1, Seed + 3 * j, SPVarStart, ErrVarStart,
+                    BetaTry + j * k, CorParTry + j * nCorPars,
+                    &SPVarTry[j], &ErrVarTry[j], &NegLogLikeTry[j],
+                    &nEvalsTry[j], &CondNumTry[j], &IterTry[j]);
+     }
 
-     YHatCV = AllocReal(nCasesXY, NULL);
+     /* The main sequence continues as if the tries */
+     /* had not used it.                            */
+     RandInit(xSave, ySave, zSave);
+
+     NegLogLikeBest = REAL_MAX;
+     for (j = 0; j < Tries; j++)
+     {
+          CVRootMSETry[j] = NA_REAL;
+          if (ErrTry[j] == OK && NegLogLikeTry[j] < NegLogLikeBest)
+               NegLogLikeBest = NegLogLikeTry[j];
+     }
+
+     if (ModCompCritNum == MOD_COMP_CRIT_CV)
+     {
+          /* Cross validate the tries within CVLogLikeMargin */
+          /* of the best log likelihood, concurrently.       */
+          nCands = 0;
+          for (j = 0; j < Tries; j++)
+               if (ErrTry[j] == OK && NegLogLikeTry[j] - NegLogLikeBest
+                         <= CVLogLikeMargin)
+                    Cand[nCands++] = j;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) private(j, m) \
+          num_threads(nMods) if (nMods > 1 && nCands > 1)
+#endif
+          for (c = 0; c < nCands; c++)
+          {
+#ifdef _OPENMP
+               m = omp_get_thread_num();
+#else
+               m = 0;
+#endif
+               j = Cand[c];
+               ErrTry[j] = FitTryCV((m == 0) ? KrigMod :
+                         &ThreadMod[m-1], CorParTry + j * nCorPars,
+                         SPVarTry[j], ErrVarTry[j],
+                         YHatCV + m * nCases, &CVRootMSETry[j]);
+          }
+     }
+     else
+     {
+          /* Cross validate the best try by likelihood (the */
+          /* first in try order if tied); if that fails,    */
+          /* the next best, and so on.                      */
+          do
+          {
+               jBest = Tries;
+               for (j = 0; j < Tries; j++)
+                    if (ErrTry[j] == OK && (jBest == Tries ||
+                              NegLogLikeTry[j] < NegLogLikeTry[jBest]))
+                         jBest = j;
+          } while (jBest < Tries &&
+                    (ErrTry[jBest] = FitTryCV(KrigMod,
+                    CorParTry + jBest * nCorPars, SPVarTry[jBest],
+                    ErrVarTry[jBest], YHatCV,
+                    &CVRootMSETry[jBest])) != OK);
+     }
 
      ErrNum = !OK;
      *CVRootMSE = REAL_MAX;
@@ -182,43 +373,26 @@ int FitBest(KrigingModel *KrigMod, size_t Tries, real *Beta,
      *CondNum = NA_REAL;
      for (j = 0; j < Tries; j++)
      {
-          /* Try number for error matrix. */
-          ErrorTry = j + 1;
-
-          MLEStart(KrigMod, &RegCorPar);
-
-          if (j == 0)
-          {
-               /* First try: If SPModMat contains correlation   */
-               /* parameters, then use them as starting values. */
-               CorParExtract(&SPModMat, yName, NO,
-                         KrigCorPar(KrigMod));
-
-               if (!RanErr && *SPVar != NA_REAL && *ErrVar != NA_REAL)
-                    KrigMod->SPVarProp = *SPVar / (*SPVar + *ErrVar);
-          }
-
-          ErrThisTry = MLEFit(&RegCorPar, KrigMod, LogLikeTol,
-                    CritLogLikeDiff, j + 1, &NegLogLikeTry,
-                    &CondNumTry, &nEvalsTry);
-          MatFree(&RegCorPar);
+          if (Progress && NegLogLikeTry[j] != NA_REAL)
+               Output("%20s%5d%11d%16g\n", yName, j + 1, IterTry[j],
+                         -NegLogLikeTry[j]);
+          else if (Progress)
+               Output("%20s%5d%11d%16s\n", yName, j + 1, IterTry[j],
+                         NOT_AVAIL);
 
           Better = FALSE;
-          if (ErrThisTry == OK &&
-                    (ErrThisTry = CalcCV(KrigMod, YHatCV, NULL))
-                              == OK)
+          if (ErrTry[j] == OK)
           {
-               CVRootMSETry = RootMSE(nCasesXY, YHatCV, KrigY(KrigMod),
-                         &MaxErr, &IndexMaxErr);
                switch (ModCompCritNum)
                {
                     case MOD_COMP_CRIT_CV:
-                         if (CVRootMSETry < *CVRootMSE)
+                         if (CVRootMSETry[j] != NA_REAL &&
+                                   CVRootMSETry[j] < *CVRootMSE)
                               Better = TRUE;
                          break;          
 
                     case MOD_COMP_CRIT_LIKE:
-                         if (NegLogLikeTry < *NegLogLike)
+                         if (NegLogLikeTry[j] < *NegLogLike)
                               Better = TRUE;
                          break;     
 
@@ -227,29 +401,131 @@ int FitBest(KrigingModel *KrigMod, size_t Tries, real *Beta,
                }          
           }
                
-          if (ErrThisTry == OK && Better)                 
+          if (ErrTry[j] == OK && Better)                 
           {
                /* One good try is sufficient. */
                ErrNum = OK;
 
                /* Best parameters so far. */
 
-               *CVRootMSE = CVRootMSETry;
-               VecCopy(KrigMod->Beta,
-                         ModDF(KrigRegMod(KrigMod)), Beta);
+               *CVRootMSE = CVRootMSETry[j];
+               VecCopy(BetaTry + j * k, k, Beta);
 
-               MatCopy(KrigCorPar(KrigMod), CorPar);
+               MatUnStack(CorParTry + j * nCorPars, NO, CorPar);
 
-               *SPVar  = KrigMod->SigmaSq * KrigMod->SPVarProp;
-               *ErrVar = KrigMod->SigmaSq
-                         * (1.0 - KrigMod->SPVarProp);
-               *NegLogLike = NegLogLikeTry;
-               *CondNum    = CondNumTry;
+               *SPVar      = SPVarTry[j];
+               *ErrVar     = ErrVarTry[j];
+               *NegLogLike = NegLogLikeTry[j];
+               *CondNum    = CondNumTry[j];
           }
-          *nEvals += nEvalsTry;
+          *nEvals += nEvalsTry[j];
      }
 
+     for (m = 0; m < nMods - 1; m++)
+          KrigModFree(&ThreadMod[m]);
+     AllocFree(ThreadMod);
+
+     AllocFree(ErrTry);
+     AllocFree(Seed);
+     AllocFree(BetaTry);
+     AllocFree(CondNumTry);
+     AllocFree(CorParTry);
+     AllocFree(CVRootMSETry);
+     AllocFree(ErrVarTry);
+     AllocFree(NegLogLikeTry);
+     AllocFree(SPVarTry);
+     AllocFree(IterTry);
+     AllocFree(Cand);
+     AllocFree(nEvalsTry);
      AllocFree(YHatCV);
 
      return ErrNum;
 }
+
+/*******************************+++*******************************/
+static int FitTry(KrigingModel *KrigMod, size_t Try, const int *Seed,
+     real SPVarStart, real ErrVarStart, real *Beta, real *CorParVec,
+     real *SPVar, real *ErrVar, real *NegLogLike, unsigned *nEvals,
+     real *CondNum, size_t *Iter)
+/*****************************************************************/
+/* Purpose:    One MLE try for FitBest: start at random          */
+/*             parameters (from the random-number sequence given */
+/*             by Seed) and fit.                                 */
+/*                                                               */
+/* Returns:    OK or an error condition.                         */
+/*                                                               */
+/* Comment:    The fitted parameters are copied to Beta,         */
+/*             CorParVec (CorPar stacked), SPVar, and ErrVar.    */
+/*             If Try is 1 and SPModMat contains correlation     */
+/*             parameters, then they are the starting values.    */
+/*                                                               */
+/* 2026.10.17: Created from the body of the loop in FitBest.     */
+/* 2026.10.17: Cross validation moved to FitTryCV.               */
+/*****************************************************************/
+{
+     int       ErrNum;
+     Matrix    RegCorPar;
+
+     /* Try number for error matrix. */
+     ErrorTry = Try;
+
+     RandInit(Seed[0], Seed[1], Seed[2]);
+
+     MLEStart(KrigMod, &RegCorPar);
+
+     if (Try == 1)
+     {
+          /* First try: If SPModMat contains correlation   */
+          /* parameters, then use them as starting values. */
+          CorParExtract(&SPModMat, yName, NO, KrigCorPar(KrigMod));
+
+          if (!RanErr && SPVarStart != NA_REAL && ErrVarStart != NA_REAL)
+               KrigMod->SPVarProp = SPVarStart
+                         / (SPVarStart + ErrVarStart);
+     }
+
+     ErrNum = MLEFit(&RegCorPar, KrigMod, LogLikeTol, CritLogLikeDiff,
+               Try, NegLogLike, CondNum, nEvals, Iter);
+     MatFree(&RegCorPar);
+
+     /* Fitted parameters. */
+     VecCopy(KrigMod->Beta, ModDF(KrigRegMod(KrigMod)), Beta);
+     MatStack(KrigCorPar(KrigMod), NO, CorParVec);
+     *SPVar  = KrigMod->SigmaSq * KrigMod->SPVarProp;
+     *ErrVar = KrigMod->SigmaSq * (1.0 - KrigMod->SPVarProp);
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+static int FitTryCV(KrigingModel *KrigMod, const real *CorParVec,
+     real SPVar, real ErrVar, real *YHatCV, real *CVRootMSE)
+/*****************************************************************/
+/* Purpose:    Cross validate the parameters fitted by one try   */
+/*             for FitBest: CorParVec (CorPar stacked), SPVar,   */
+/*             and ErrVar.                                       */
+/*                                                               */
+/* Returns:    OK or an error condition.                         */
+/*                                                               */
+/* Comment:    The try's parameters are put in KrigMod, which    */
+/*             need not be the model that fitted them.           */
+/*                                                               */
+/* 2026.10.17: Created from FitTry.                              */
+/*****************************************************************/
+{
+     int       ErrNum;
+     real      MaxErr;
+     size_t    IndexMaxErr;
+
+     MatUnStack(CorParVec, NO, KrigCorPar(KrigMod));
+     KrigMod->SigmaSq = SPVar + ErrVar;
+     if (KrigMod->SigmaSq > 0.0)
+          KrigMod->SPVarProp = SPVar / KrigMod->SigmaSq;
+
+     ErrNum = CalcCV(KrigMod, YHatCV, NULL);
+     if (ErrNum == OK)
+          *CVRootMSE = RootMSE(MatNumRows(KrigChol(KrigMod)), YHatCV,
+                    KrigY(KrigMod), &MaxErr, &IndexMaxErr);
+
+     return ErrNum;
+}
@@ -18,11 +18,14 @@
 #include "kriging.h"
 #include "alex.h"
 
+extern THREAD_LOCAL int ErrorSeverityLevel;
+
 extern boolean      ErrorSave;
 extern string       ErrorVar;
 
 extern boolean      RanErr;
 extern boolean      GenPredCoefs;
+extern boolean      PredSE;
 
 extern LinModel     RegMod;
 extern LinModel     SPMod;
@@ -31,6 +34,7 @@ extern Matrix       PredCoef;
 extern Matrix       SPModMat;
 extern Matrix       T;
 extern Matrix       X;
+extern Matrix       XDescrip;
 extern Matrix       XPred;
 extern Matrix       YPred;
 extern Matrix       YDescrip;
@@ -40,11 +44,19 @@ extern real         *yTrue;
 extern size_t       CorFamNum;
 extern size_t       nCasesXY;
 extern size_t       *IndexXY;
+extern size_t       PredChunk;
+extern string       FittedModel;
+extern string       InDir;
+extern string       OutDir;
+extern string       XPredFile;
+extern string       YPredFile;
 extern string       yName;
 
 static string       SummaryStats[] = {VARIABLE, TRANSFORMATION,
                          CASES, ROOT_MSE, MAX_ERR, CASE_MAX_ERR};
 
+static int PredictStream(void);
+
 /*******************************+++*******************************/
 int Predict(void)
 /*****************************************************************/
@@ -57,9 +69,16 @@ int Predict(void)
 /*   1096.04.04: X and y include NA's.                           */
 /*   1996.04.14: KrigModAlloc/KrigModData; DbIndexXY.            */
 /*   2009.05.07: Multiple correlation families                   */
+/*   2026.10.17: Parameters and decompositions from the          */
+/*               FittedModel file if it has them for the data.   */
+/*   2026.10.17: Set-up moved to PredModSetUp.                   */
+/*   2026.10.17: XPredictionFile streamed by PredictStream.      */
+/*   2026.10.17: Standard errors only if PredSE (PredYHatSE).    */
+/*   2026.10.17: Stale SE.y set to NA if not PredSE.             */
 /*****************************************************************/
 {
      boolean        NewXs;
+     FILE           *ModFile;
      int            ErrNum, ErrReturn;
      KrigingModel   KrigMod;
      real           *ErrVar, *MaxErr, *NewCol, *ResTildeTilde;
@@ -68,6 +87,9 @@ int Predict(void)
      string         ColName;
      string         *CaseMaxErr;
 
+     if (XPredFile != NULL && stricmp(XPredFile, NOT_AVAIL) != 0)
+          return PredictStream();
+
      /* Are there new x's at which to predict? */
      m = MatNumRows(&XPred);
      NewXs = (m > 0);
@@ -87,6 +109,8 @@ int Predict(void)
      /* Add a column to the YDescrip matrix. */
      /* MatPutText(&YDescrip, Y_DESCRIP_TITLE); */
 
+     ModFile = FittedModelOpen(NO);
+
      /* Compute predictions/coefficients for each response. */
      ErrReturn = OK;
      ErrorSave = YES;
@@ -102,18 +126,16 @@ int Predict(void)
           /* Set up kriging model. */
           KrigModAlloc(nCasesXY, MatNumCols(&X), yName, &T, &RegMod,
                     &SPMod, CorFamNum, RanErr, &KrigMod);
-          KrigModData(nCasesXY, IndexXY, &X, y, &KrigMod);
 
-          /* SPModMat contains the correlation parameters. */
-          ErrNum = KrigModSetUp(&SPModMat, yName, SPVar[j],
+          ErrNum = PredModSetUp(ModFile, SPVar[j],
                     (ErrVar != NULL) ? ErrVar[j] : 0.0, &KrigMod);
 
           if (NewXs && ErrNum == OK)
           {
                yHat = AllocReal(m, NULL);
-               SE   = AllocReal(m, NULL);
+               SE   = (PredSE) ? AllocReal(m, NULL) : NULL;
 
-               ErrNum = KrigPredSE(&KrigMod, &XPred, yHat, SE);
+               ErrNum = PredYHatSE(&KrigMod, &XPred, yHat, SE);
 
                /* Put predictions and standard errors in YPred. */
                if (ErrNum == OK)
@@ -123,10 +145,15 @@ int Predict(void)
                     AllocFree(ColName);
                     VecCopy(yHat, m, NewCol);
 
+                    /* Without standard errors, NAs replace any */
+                    /* left by an earlier Predict.              */
                     ColName = StrPaste(3, STD_ERR, ".", yName);
-                    NewCol = MatColAdd(ColName, &YPred);
+                    if (SE != NULL)
+                         VecCopy(SE, m, MatColAdd(ColName, &YPred));
+                    else if ( (NewCol = MatColFind(&YPred, ColName,
+                              NO)) != NULL)
+                         VecInit(NA_REAL, m, NewCol);
                     AllocFree(ColName);
-                    VecCopy(SE, m, NewCol);
 
                     if (yTrue != NULL)
                     {
@@ -180,6 +207,9 @@ int Predict(void)
                ErrReturn = ErrNum;
      }
 
+     if (ModFile != NULL)
+          fclose(ModFile);
+
      OutputTemp("");
 
      OutputSummary(&YDescrip, NumStr(SummaryStats), SummaryStats);
@@ -187,6 +217,425 @@ int Predict(void)
      return ErrReturn;
 }
 
+/*******************************+++*******************************/
+static int PredictStream(void)
+/*****************************************************************/
+/*   Purpose:  Predict at the x's in XPredictionFile, reading    */
+/*             PredictionChunk rows at a time, and append their  */
+/*             predictions and standard errors to                */
+/*             YPredictionFile.                                  */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  Memory is bounded by the chunk size, however many */
+/*             points there are.  XPredictionFile must have one  */
+/*             block of columns (as written by MatWrite);        */
+/*             YPredictionFile is written exactly as MatWrite    */
+/*             would write YPrediction, to OutputDirectory or    */
+/*             the screen as by DbMatWrite.  Until the end the   */
+/*             rows are kept in a temporary file (see            */
+/*             MatWriteStart).                                   */
+/*             XPrediction, YTrue, and prediction coefficients   */
+/*             are not used.                                     */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: YPredictionFile in MatWrite's format; Screen.   */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     boolean        CaseLabels, Finished, Writing;
+     boolean        *Ready;
+     DbMatrix       DChunk;
+     FILE           *InpFile, *OutFile;
+     int            ErrNum, ErrReturn;
+     KrigingModel   *KrigMod;
+     Matrix         Chunk, Raw, YChunk;
+     size_t         j, jPred, m, nMods, nPoints, nXVars;
+     size_t         *nCats;
+     string         ColName, DirFileName;
+     string         *xName;
+
+     if (YPredFile == NULL || stricmp(YPredFile, NOT_AVAIL) == 0)
+     {
+          Error("%s is needed with %s.\n", Y_PRED_FILE, X_PRED_FILE);
+          return INPUT_ERR;
+     }
+
+     /* Models for all responses are resident. */
+     nMods   = MatNumRows(&YDescrip);
+     KrigMod = (KrigingModel *) AllocGeneric(nMods,
+               sizeof(KrigingModel), NULL);
+     Ready   = (boolean *) AllocGeneric(nMods, sizeof(boolean), NULL);
+
+     ErrorSave = YES;
+     ErrReturn = (PredModsSetUp(KrigMod, Ready) > 0) ? OK : INPUT_ERR;
+     ErrorVar = NULL;
+
+     /* Pred.y and, if PredSE, StdErr.y for each response. */
+     MatAllocate(0, 0, RECT, REAL, NULL, YES, &YChunk);
+     MatPutText(&YChunk, Y_PRED_TITLE "\n\n");
+     for (j = 0; j < nMods; j++)
+     {
+          if (!Ready[j])
+               continue;
+
+          ColName = StrPaste(3, PRED, ".", KrigYName(&KrigMod[j]));
+          MatColAdd(ColName, &YChunk);
+          AllocFree(ColName);
+
+          if (!PredSE)
+               continue;
+
+          ColName = StrPaste(3, STD_ERR, ".", KrigYName(&KrigMod[j]));
+          MatColAdd(ColName, &YChunk);
+          AllocFree(ColName);
+     }
+
+     /* Open the files as for XPrediction and YPrediction. */
+     InpFile = OutFile = NULL;
+     if (ErrReturn == OK)
+     {
+          if (stricmp(InDir, DEF_IN_DIR) != 0)
+          {
+               DirFileName = StrPaste(3, InDir, DIR_SEP, XPredFile);
+               InpFile = FileOpen(DirFileName, "r");
+               AllocFree(DirFileName);
+          }
+          else
+               InpFile = FileOpen(XPredFile, "r");
+
+          if (stricmp(YPredFile, SCREEN) == 0)
+               OutFile = stdout;
+          else
+          {
+               DirFileName = StrPaste(3, OutDir, DIR_SEP, YPredFile);
+               OutFile = FileOpen(DirFileName, "w");
+               AllocFree(DirFileName);
+          }
+
+          if (InpFile == NULL || OutFile == NULL)
+               ErrReturn = FILE_ERR;
+     }
+
+     MatInit(RECT, REAL, YES, &Raw);
+     Writing = (ErrReturn == OK &&
+               (ErrReturn = MatReadStart(InpFile, &Raw, &CaseLabels))
+               == OK && (ErrReturn = MatWriteStart(&YChunk)) == OK);
+
+     /* Each chunk is processed as XPrediction would be. */
+     DChunk   = *DbMatFind(X_PRED, YES);
+     DChunk.M = &Chunk;
+     MatInit(RECT, REAL, YES, &Chunk);
+
+     nXVars = MatNumRows(&XDescrip);
+     xName  = MatStrColFind(&XDescrip, VARIABLE, NO);
+     nCats  = MatSize_tColFind(&XDescrip, NUM_CATS, NO);
+
+     nPoints  = 0;
+     Finished = (ErrReturn != OK);
+     while (!Finished)
+     {
+          ErrNum = MatReadRows(InpFile, CaseLabels, PredChunk, &Raw,
+                    &Finished);
+
+          if (ErrNum == OK && (m = MatNumRows(&Raw)) > 0)
+          {
+               MatDup(&Raw, &Chunk);
+
+               DChunk.IsProcessed = NO;
+               ErrNum = DbProcessDescrip(X_DESCRIP, &XDescrip, &DChunk);
+               if (ErrNum == OK)
+                    ErrNum = DbMatCatCols(nXVars, xName, nCats, &Chunk);
+          }
+          else
+               m = 0;
+
+          if (ErrNum != OK)
+          {
+               ErrReturn = ErrNum;
+               break;
+          }
+          else if (m == 0)
+               continue;
+
+          MatReAlloc(m, MatNumCols(&YChunk), &YChunk);
+          VecStrCopy(MatRowNames(&Chunk), m, MatRowNames(&YChunk));
+
+          for (jPred = 0, j = 0; j < nMods; j++)
+          {
+               if (!Ready[j])
+                    continue;
+
+               ErrorVar = KrigYName(&KrigMod[j]);
+               ErrNum = PredYHatSE(&KrigMod[j], &Chunk,
+                         MatCol(&YChunk, jPred),
+                         (PredSE) ? MatCol(&YChunk, jPred + 1) : NULL);
+               if (ErrNum != OK)
+                    ErrReturn = ErrNum;
+               jPred += (PredSE) ? 2 : 1;
+          }
+
+          if ( (ErrNum = MatWriteRows(&YChunk)) != OK)
+          {
+               ErrReturn = ErrNum;
+               Finished  = YES;
+          }
+
+          /* Free the row labels newest first (see AllocStrFree). */
+          MatReAlloc(0, MatNumCols(&YChunk), &YChunk);
+          MatFree(&Chunk);
+
+          nPoints += m;
+          OutputTemp("Predicted %lu points", (unsigned long) nPoints);
+     }
+
+     OutputTemp("");
+
+     if (Writing && (ErrNum = MatWriteEnd(&YChunk, OutFile)) != OK)
+          ErrReturn = ErrNum;
+
+     if (InpFile != NULL)
+          fclose(InpFile);
+     if (OutFile != NULL && OutFile != stdout)
+          fclose(OutFile);
+
+     MatFree(&Raw);
+     MatFree(&Chunk);
+     MatFree(&YChunk);
+
+     /* The names are freed with the models. */
+     ErrorVar = NULL;
+     PredModsFree(KrigMod, Ready);
+     AllocFree(KrigMod);
+     AllocFree(Ready);
+
+     Output("%lu point(s) in %s predicted to %s.\n",
+               (unsigned long) nPoints, XPredFile, YPredFile);
+
+     return ErrReturn;
+}
+
+/*******************************+++*******************************/
+int PredYHatSE(KrigingModel *KrigMod, const Matrix *XPred,
+     real *YHat, real *SE)
+/*****************************************************************/
+/*   Purpose:  Compute predictions at the rows of XPred, and     */
+/*             their standard errors if SE != NULL.              */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  Without standard errors, Inv(C) * GLS residuals   */
+/*             are computed once by KrigPredSetUp, and KrigPred  */
+/*             needs only the correlations and two dot products  */
+/*             per point: O(n) instead of the O(n * n)           */
+/*             triangular solves per point in KrigPredSE.  The   */
+/*             predictions agree with KrigPredSE's to rounding   */
+/*             error.                                            */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int       ErrNum;
+     real      *ResTildeTilde;
+     size_t    i;
+
+     if (SE != NULL)
+          return KrigPredSE(KrigMod, XPred, YHat, SE);
+
+     ResTildeTilde = AllocReal(MatNumRows(KrigChol(KrigMod)), NULL);
+
+     if ( (ErrNum = KrigPredSetUp(KrigMod, ResTildeTilde)) == OK)
+          KrigPred(KrigMod, XPred, ResTildeTilde, YHat);
+     else
+          for (i = 0; i < MatNumRows(XPred); i++)
+               YHat[i] = NA_REAL;
+
+     AllocFree(ResTildeTilde);
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+size_t PredModsSetUp(KrigingModel *KrigMod, boolean *Ready)
+/*****************************************************************/
+/*   Purpose:  Set up the kriging model of every response for    */
+/*             prediction (see PredModSetUp): KrigMod[j] for row */
+/*             j of YDescrip, if Ready[j] is YES on return.      */
+/*                                                               */
+/*   Returns:  The number of models set up.                      */
+/*                                                               */
+/*   Comment:  KrigMod and Ready must have as many elements as   */
+/*             YDescrip has rows.  Free with PredModsFree.       */
+/*                                                               */
+/*   2026.10.17: Created from Serve.                             */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     FILE      *ModFile;
+     real      *ErrVar, *SPVar;
+     size_t    j, nReady;
+
+     ErrVar = MatColFind(&YDescrip, ERR_VAR, NO);
+     SPVar  = MatColFind(&YDescrip, SP_VAR, YES);
+
+     ModFile = FittedModelOpen(NO);
+
+     nReady = 0;
+     for (j = 0; j < MatNumRows(&YDescrip); j++)
+     {
+          Ready[j] = NO;
+
+          if (DbIndexXY(j) == 0)
+               continue;
+
+          OutputTemp("Setting up variable: %s", yName);
+
+          ErrorVar = yName;
+
+          /* yName is replaced for the next response. */
+          KrigModAlloc(nCasesXY, MatNumCols(&X), StrDup(yName), &T,
+                    &RegMod, &SPMod, CorFamNum, RanErr, &KrigMod[j]);
+
+          if (PredModSetUp(ModFile, SPVar[j],
+                    (ErrVar != NULL) ? ErrVar[j] : 0.0, &KrigMod[j])
+                    == OK)
+          {
+               Ready[j] = YES;
+               nReady++;
+          }
+          else
+          {
+               AllocFree(KrigYName(&KrigMod[j]));
+               KrigModFree(&KrigMod[j]);
+          }
+     }
+
+     if (ModFile != NULL)
+          fclose(ModFile);
+
+     OutputTemp("");
+
+     return nReady;
+}
+
+/*******************************+++*******************************/
+void PredModsFree(KrigingModel *KrigMod, const boolean *Ready)
+/*****************************************************************/
+/*   Purpose:  Free the models set up by PredModsSetUp.          */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    j;
+
+     for (j = 0; j < MatNumRows(&YDescrip); j++)
+          if (Ready[j])
+          {
+               AllocFree(KrigYName(&KrigMod[j]));
+               KrigModFree(&KrigMod[j]);
+          }
+}
+
+/*******************************+++*******************************/
+int PredModSetUp(FILE *ModFile, real SPVar, real ErrVar,
+     KrigingModel *KrigMod)
+/*****************************************************************/
+/*   Purpose:  Set up the kriging model for the current response */
+/*             (see DbIndexXY) for prediction: read from the     */
+/*             fitted-model file ModFile if it has the model for */
+/*             these data, otherwise from the data, SPModMat,    */
+/*             SPVar, and ErrVar.                                */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  KrigMod must be allocated by KrigModAlloc.        */
+/*             ModFile may be NULL.  A saved model is used only  */
+/*             if its parameters and model terms are those in    */
+/*             SPModMat, SPVar, ErrVar, and the current models.  */
+/*                                                               */
+/*   2026.10.17: Created from Predict.                           */
+/*   2026.10.17: Saved model checked against the parameters.     */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int       ErrNum, ErrSevSave;
+
+     /* SPModMat contains the correlation parameters, */
+     /* which a saved model must also have.           */
+     ErrNum = CorParSetUp(&SPModMat, yName, SPVar, ErrVar, KrigMod);
+     if (ErrNum != OK)
+          return ErrNum;
+
+     ErrNum = !OK;
+     if (ModFile != NULL)
+     {
+          /* The fitted model, if saved for these data. */
+          ErrNum = KrigModRead(ModFile,
+                    KrigDataHash(nCasesXY, IndexXY, &X, y), KrigMod);
+          if (ErrNum == INCOMPAT_ERR)
+          {
+               ErrSevSave = ErrorSeverityLevel;
+               ErrorSeverityLevel = SEV_WARNING;
+               Error("%s %s has no model for these data, model "
+                         "terms, and parameters.\n", FITTED_MODEL,
+                         FittedModel);
+               ErrorSeverityLevel = ErrSevSave;
+          }
+     }
+
+     if (ErrNum != OK)
+     {
+          /* As KrigModSetUp, with the parameters already set up. */
+          KrigModData(nCasesXY, IndexXY, &X, y, KrigMod);
+          KrigCorMat(0, NULL, KrigMod);
+          ErrNum = KrigDecompose(KrigMod);
+     }
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+FILE *FittedModelOpen(boolean Write)
+/*****************************************************************/
+/*   Purpose:  Open the fitted-model file named by the           */
+/*             FittedModel scalar, in OutDir for writing or      */
+/*             InDir for reading (as for matrices).              */
+/*                                                               */
+/*   Returns:  The file, or NULL if FittedModel is not set or    */
+/*             the file cannot be opened (see KrigFileOpen).     */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     FILE      *File;
+     string    DirFileName;
+
+     if (FittedModel == NULL || stricmp(FittedModel, NOT_AVAIL) == 0)
+          return NULL;
+
+     if (Write)
+          DirFileName = StrPaste(3, OutDir, DIR_SEP, FittedModel);
+     else if (stricmp(InDir, DEF_IN_DIR) != 0)
+          DirFileName = StrPaste(3, InDir, DIR_SEP, FittedModel);
+     else
+          DirFileName = StrDup(FittedModel);
+
+     File = KrigFileOpen(DirFileName, Write);
+
+     AllocFree(DirFileName);
+
+     return File;
+}
+
 /*******************************+++*******************************/
 void OutputSummary(Matrix *Summ, size_t nCols,
           const string *ColName)
@@ -0,0 +1,552 @@
+/*****************************************************************/
+/*   ROUTINES TO SERVE PREDICTIONS OVER A LOCAL SOCKET           */
+/*                                                               */
+/*   Started by "gasp --serve <socket> JobFile", the Serve verb  */
+/*   keeps the kriging model for each response resident and      */
+/*   answers binary requests on the Unix-domain socket.  Every   */
+/*   message is a header of SERVE_HEAD reals followed by data,   */
+/*   all reals in the byte order of the server.                  */
+/*                                                               */
+/*   Request header: command, response, m, d.                    */
+/*        SERVE_PREDICT: predict response (row of YDescription,  */
+/*        from 0) at m points; d must be the number of columns   */
+/*        of X.  The m * d x values follow, point by point, on   */
+/*        the scale of X (after any transformations).            */
+/*        SERVE_STATUS:  no data; the reply has the status.      */
+/*        SERVE_STOP:    no data; Serve returns after replying.  */
+/*                                                               */
+/*   Reply header: OK or an error number, rows, columns, 0.      */
+/*        The rows x columns matrix follows by columns: for      */
+/*        SERVE_PREDICT, the m predictions then their m          */
+/*        standard errors (NA for points with NA's); for         */
+/*        SERVE_STATUS, one row of SERVE_STAT_LEN values (see    */
+/*        ServeStatus).  After an error reply to an invalid      */
+/*        request the connection is closed.                      */
+/*                                                               */
+/*   Copyright (c) William J. Welch 2026.                        */
+/*   All rights reserved.                                        */
+/*****************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "define.h"
+#include "implem.h"
+#include "matrix.h"
+#include "lib.h"
+#include "model.h"
+#include "kriging.h"
+#include "alex.h"
+
+#ifdef UNIX_DEFINED
+     #include <errno.h>
+     #include <fcntl.h>
+     #include <poll.h>
+     #include <signal.h>
+     #include <unistd.h>
+     #include <sys/socket.h>
+     #include <sys/stat.h>
+     #include <sys/un.h>
+#endif
+
+#ifdef _OPENMP
+     #include <omp.h>
+#endif
+
+extern boolean      ErrorSave;
+
+extern Matrix       X;
+extern Matrix       YDescrip;
+
+extern size_t       ServerThreads;
+
+/* Socket named on the command line (see main). */
+string              ServeSocket = NULL;
+
+#ifdef UNIX_DEFINED
+
+/* Milliseconds between checks for SERVE_STOP while waiting. */
+#define SERVE_POLL_MS    100
+
+/* Latencies (ms) of the last SERVE_LAT_MAX requests. */
+#define SERVE_LAT_MAX    10000
+
+static boolean      Stopped;
+static real         *Latency;
+static size_t       nServed, nPoints, nThreads, nReady;
+
+static void ServeWorker(int Listen, size_t nMods,
+     const KrigingModel *KrigMod, const boolean *Ready);
+static int ServeRequest(int Conn, size_t nMods,
+     KrigingModel *KrigMod, const boolean *Ready);
+static void ServeStatus(real *Status);
+static boolean ServeStopped(void);
+static int ServeRead(int Conn, size_t n, real *v);
+static int ServeWrite(int Conn, size_t n, const real *v);
+static real ServeClock(void);
+
+#endif
+
+/*******************************+++*******************************/
+int Serve(void)
+/*****************************************************************/
+/*   Purpose:  Set up the kriging model of every response and    */
+/*             serve predictions on ServeSocket until a          */
+/*             SERVE_STOP request.                               */
+/*                                                               */
+/*   Returns:  OK or an error condition.                         */
+/*                                                               */
+/*   Comment:  With OpenMP, ServerThreads workers (all threads   */
+/*             if 0) each take a client at a time; otherwise     */
+/*             clients are served one at a time.                 */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+#ifdef UNIX_DEFINED
+     boolean             *Ready;
+     int                 ErrNum, Listen;
+     KrigingModel        *KrigMod;
+     real                Status[SERVE_STAT_LEN];
+     size_t              nMods;
+     struct sockaddr_un  Addr;
+     struct stat         Info;
+
+     if (ServeSocket == NULL)
+     {
+          Error("No socket: start with %s <socket> to serve.\n",
+                    SERVE_OPTION);
+          return INPUT_ERR;
+     }
+     else if (strlen(ServeSocket) >= sizeof(Addr.sun_path))
+     {
+          Error("Socket name %s is too long.\n", ServeSocket);
+          return INPUT_ERR;
+     }
+
+     /* Resident models, indexed by row of YDescrip. */
+     nMods   = MatNumRows(&YDescrip);
+     KrigMod = (KrigingModel *) AllocGeneric(nMods,
+               sizeof(KrigingModel), NULL);
+     Ready   = (boolean *) AllocGeneric(nMods, sizeof(boolean), NULL);
+
+     ErrorSave = YES;
+     nReady = PredModsSetUp(KrigMod, Ready);
+
+     /* Set-up messages now; later ones as they occur. */
+     ErrorMatOut();
+
+     ErrNum = OK;
+     Listen = -1;
+     if (nReady == 0)
+     {
+          Error("No models to serve.\n");
+          ErrNum = INPUT_ERR;
+     }
+     else
+     {
+          /* A write to a closed client must not end the server. */
+          signal(SIGPIPE, SIG_IGN);
+
+          /* Remove only a socket left by an earlier server. */
+          if (stat(ServeSocket, &Info) == 0 && S_ISSOCK(Info.st_mode))
+               unlink(ServeSocket);
+
+          memset(&Addr, 0, sizeof(Addr));
+          Addr.sun_family = AF_UNIX;
+          strcpy(Addr.sun_path, ServeSocket);
+
+          /* Non-blocking: workers poll the listening socket, */
+          /* and only one gets each client.                   */
+          if ( (Listen = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 ||
+                    bind(Listen, (struct sockaddr *) &Addr,
+                    sizeof(Addr)) != 0 ||
+                    listen(Listen, SOMAXCONN) != 0 ||
+                    fcntl(Listen, F_SETFL, O_NONBLOCK) != 0)
+          {
+               Error("Cannot listen on socket %s.\n", ServeSocket);
+               ErrNum = FILE_ERR;
+          }
+     }
+
+     if (ErrNum == OK)
+     {
+          nThreads = 1;
+#ifdef _OPENMP
+          nThreads = (ServerThreads > 0) ? ServerThreads :
+                    (size_t) omp_get_max_threads();
+#endif
+
+          Stopped = NO;
+          nServed = nPoints = 0;
+          Latency = AllocReal(SERVE_LAT_MAX, NULL);
+
+          Output("Serving %u model(s) on %s with %u thread(s).\n",
+                    (unsigned) nReady, ServeSocket,
+                    (unsigned) nThreads);
+          fflush(stdout);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(nThreads)
+#endif
+          ServeWorker(Listen, nMods, KrigMod, Ready);
+
+          ServeStatus(Status);
+          Output("Served %lu request(s) for %lu point(s); "
+                    "latency p50 %.3g ms, p99 %.3g ms.\n",
+                    (unsigned long) nServed, (unsigned long) nPoints,
+                    Status[4], Status[5]);
+
+          AllocFree(Latency);
+     }
+
+     if (Listen >= 0)
+     {
+          close(Listen);
+          unlink(ServeSocket);
+     }
+
+     PredModsFree(KrigMod, Ready);
+     AllocFree(KrigMod);
+     AllocFree(Ready);
+
+     return ErrNum;
+#else
+     Error("%s needs Unix-domain sockets.\n", SERVE_OPTION);
+     return INPUT_ERR;
+#endif
+}
+
+#ifdef UNIX_DEFINED
+
+/*******************************+++*******************************/
+static void ServeWorker(int Listen, size_t nMods,
+     const KrigingModel *KrigMod, const boolean *Ready)
+/*****************************************************************/
+/*   Purpose:  Accept clients and answer their requests until    */
+/*             stopped.                                          */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int            Conn;
+     KrigingModel   *WorkMod;
+     size_t         j;
+     struct pollfd  Poll;
+
+     /* Each worker shares the data, parameters, and */
+     /* decompositions of the resident models, with  */
+     /* its own workspace.                           */
+     WorkMod = (KrigingModel *) AllocGeneric(nMods,
+               sizeof(KrigingModel), NULL);
+     for (j = 0; j < nMods; j++)
+          if (Ready[j])
+          {
+               WorkMod[j] = KrigMod[j];
+               WorkMod[j].xRow = AllocReal(MatNumCols(&X), NULL);
+               WorkMod[j].gRow = AllocReal(
+                         ModDF(KrigSPMod(&KrigMod[j])), NULL);
+          }
+
+     while (!ServeStopped())
+     {
+          Poll.fd     = Listen;
+          Poll.events = POLLIN;
+          if (poll(&Poll, 1, SERVE_POLL_MS) <= 0)
+               continue;
+
+          /* Another worker may have taken the client. */
+          if ( (Conn = accept(Listen, NULL, NULL)) < 0)
+               continue;
+
+          /* Some systems pass on O_NONBLOCK. */
+          fcntl(Conn, F_SETFL, 0);
+
+          while (ServeRequest(Conn, nMods, WorkMod, Ready) == OK)
+               ;
+
+          close(Conn);
+     }
+
+     for (j = 0; j < nMods; j++)
+          if (Ready[j])
+          {
+               AllocFree(WorkMod[j].xRow);
+               AllocFree(WorkMod[j].gRow);
+          }
+     AllocFree(WorkMod);
+}
+
+/*******************************+++*******************************/
+static int ServeRequest(int Conn, size_t nMods,
+     KrigingModel *KrigMod, const boolean *Ready)
+/*****************************************************************/
+/*   Purpose:  Read one request from Conn and reply.             */
+/*                                                               */
+/*   Returns:  OK, or an error condition if the connection is    */
+/*             to be closed.                                     */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int       ErrNum;
+     Matrix    XPred;
+     real      Start;
+     real      Head[SERVE_HEAD], Reply[SERVE_HEAD];
+     real      Status[SERVE_STAT_LEN];
+     real      *Out, *x;
+     size_t    Cmd, d, i, j, l, m;
+
+     if (ServeRead(Conn, SERVE_HEAD, Head) != OK)
+          return FILE_ERR;
+
+     Start = ServeClock();
+
+     VecInit(0.0, SERVE_HEAD, Reply);
+
+     for (l = 0; l < 4; l++)
+          if (!(Head[l] >= 0.0 && Head[l] <= (real) SERVE_MAX_POINTS
+                    && Head[l] == floor(Head[l])))
+               break;
+
+     Cmd = (l < 4) ? 0 : (size_t) Head[0];
+     j   = (size_t) Head[1];
+     m   = (size_t) Head[2];
+     d   = (size_t) Head[3];
+
+     if (Cmd == SERVE_STATUS)
+     {
+          ServeStatus(Status);
+          Reply[0] = OK;
+          Reply[1] = 1.0;
+          Reply[2] = SERVE_STAT_LEN;
+          ErrNum = ServeWrite(Conn, SERVE_HEAD, Reply);
+          if (ErrNum == OK)
+               ErrNum = ServeWrite(Conn, SERVE_STAT_LEN, Status);
+          return ErrNum;
+     }
+     else if (Cmd == SERVE_STOP)
+     {
+#ifdef _OPENMP
+#pragma omp critical (ServeStats)
+#endif
+          Stopped = YES;
+
+          Reply[0] = OK;
+          ServeWrite(Conn, SERVE_HEAD, Reply);
+          return FILE_ERR;
+     }
+     else if (Cmd != SERVE_PREDICT || j >= nMods || !Ready[j] ||
+               d != MatNumCols(&X))
+     {
+          Reply[0] = INPUT_ERR;
+          ServeWrite(Conn, SERVE_HEAD, Reply);
+          return INPUT_ERR;
+     }
+
+     x   = AllocReal(m * d, NULL);
+     Out = AllocReal(2 * m, NULL);
+
+     if ( (ErrNum = ServeRead(Conn, m * d, x)) == OK)
+     {
+          /* Points are the rows of XPred. */
+          MatAlloc(m, d, RECT, &XPred);
+          for (l = 0; l < d; l++)
+               for (i = 0; i < m; i++)
+                    MatPutElem(&XPred, i, l, x[i * d + l]);
+
+          Reply[0] = KrigPredSE(&KrigMod[j], &XPred, Out, Out + m);
+          Reply[1] = m;
+          Reply[2] = 2.0;
+
+          MatFree(&XPred);
+
+          ErrNum = ServeWrite(Conn, SERVE_HEAD, Reply);
+          if (ErrNum == OK)
+               ErrNum = ServeWrite(Conn, 2 * m, Out);
+     }
+
+     AllocFree(x);
+     AllocFree(Out);
+
+     if (ErrNum == OK)
+     {
+#ifdef _OPENMP
+#pragma omp critical (ServeStats)
+#endif
+          {
+               Latency[nServed % SERVE_LAT_MAX] = ServeClock() - Start;
+               nServed++;
+               nPoints += m;
+          }
+     }
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+static void ServeStatus(real *Status)
+/*****************************************************************/
+/*   Purpose:  Put the status in Status: models, threads,        */
+/*             requests, points, and the median (p50) and 99th   */
+/*             percentile (p99) latencies (ms) of the last       */
+/*             SERVE_LAT_MAX prediction requests.                */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      *Sorted;
+     size_t    nLat;
+
+     Sorted = AllocReal(SERVE_LAT_MAX, NULL);
+
+#ifdef _OPENMP
+#pragma omp critical (ServeStats)
+#endif
+     {
+          Status[0] = nReady;
+          Status[1] = nThreads;
+          Status[2] = nServed;
+          Status[3] = nPoints;
+          nLat = min(nServed, SERVE_LAT_MAX);
+          VecCopy(Latency, nLat, Sorted);
+     }
+
+     /* Nearest-rank percentiles. */
+     if (nLat > 0)
+     {
+          QuickReal(nLat, Sorted);
+          Status[4] = Sorted[(nLat - 1) / 2];
+          Status[5] = Sorted[(size_t) ceil(0.99 * nLat) - 1];
+     }
+     else
+          Status[4] = Status[5] = NA_REAL;
+
+     AllocFree(Sorted);
+}
+
+/*******************************+++*******************************/
+static boolean ServeStopped(void)
+/*****************************************************************/
+/*   Purpose:  Has a SERVE_STOP request been received?           */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     boolean   Stop;
+
+#ifdef _OPENMP
+#pragma omp critical (ServeStats)
+#endif
+     Stop = Stopped;
+
+     return Stop;
+}
+
+/*******************************+++*******************************/
+static int ServeRead(int Conn, size_t n, real *v)
+/*****************************************************************/
+/*   Purpose:  Read n reals from Conn into v.                    */
+/*                                                               */
+/*   Returns:  OK, or FILE_ERR if the client has closed the      */
+/*             connection or the server is stopping.             */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     char           *Buf;
+     long           Got;
+     size_t         Done, Len;
+     struct pollfd  Poll;
+
+     Buf  = (char *) v;
+     Len  = n * sizeof(real);
+     Done = 0;
+     while (Done < Len)
+     {
+          if (ServeStopped())
+               return FILE_ERR;
+
+          Poll.fd     = Conn;
+          Poll.events = POLLIN;
+          if (poll(&Poll, 1, SERVE_POLL_MS) == 0)
+               continue;
+
+          Got = (long) read(Conn, Buf + Done, Len - Done);
+          if (Got < 0 && errno == EINTR)
+               continue;
+          else if (Got <= 0)
+               return FILE_ERR;
+
+          Done += (size_t) Got;
+     }
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+static int ServeWrite(int Conn, size_t n, const real *v)
+/*****************************************************************/
+/*   Purpose:  Write n reals in v to Conn.                       */
+/*                                                               */
+/*   Returns:  OK, or FILE_ERR if the client has gone.           */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     const char     *Buf;
+     long           Put;
+     size_t         Done, Len;
+
+     Buf  = (const char *) v;
+     Len  = n * sizeof(real);
+     Done = 0;
+     while (Done < Len)
+     {
+          Put = (long) write(Conn, Buf + Done, Len - Done);
+          if (Put < 0 && errno == EINTR)
+               continue;
+          else if (Put <= 0)
+               return FILE_ERR;
+
+          Done += (size_t) Put;
+     }
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+static real ServeClock(void)
+/*****************************************************************/
+/*   Purpose:  Return a monotonic time in milliseconds.          */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     struct timespec Now;
+
+     clock_gettime(CLOCK_MONOTONIC, &Now);
+
+     return (real) Now.tv_sec * 1000.0 + (real) Now.tv_nsec / 1.0e6;
+}
+
+#endif
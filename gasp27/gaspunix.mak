@@ -1,28 +1,43 @@
 # makefile for ACED/GaSP
 
 aced     = aced.o acedeval.o acedlhs.o acedoptd.o
-gasp     = gasp.o gaspcv.o gaspfit.o gasppred.o gaspvis.o
+gasp     = gasp.o gaspbag.o gaspcv.o gaspfit.o gasppred.o gaspserv.o gaspvis.o
 crit     = crit.o critcens.o critcov.o critd.o critg.o \
         critmaxd.o critmind.o critrff.o critutil.o
 database = db.o dbmanip.o dbmat.o dbmatcom.o dbmatleg.o dbscalar.o
 design   = desall.o desfed.o deslhs.o desseq.o desutil.o
-kriging  = krcor.o kriging.o krmatern.o krmle.o krpowexp.o krpred.o
+kriging  = krcor.o kriging.o krmatern.o krmle.o krpowexp.o krpred.o \
+        krsave.o
 lib      = liballoc.o libbufin.o libfile.o libin.o liblist.o libmath.o \
-        libout.o libperm.o libprob.o librandn.o libreg.o \
+        libout.o libperm.o libprob.o librandn.o libreg.o libsimd.o \
         libsort.o libstr.o libtempl.o libvec.o
-matrix   = matalloc.o matblas.o matcopy.o mateig.c matio.o matqr.o \
-        matsym.o mattri.o matutil.o
-minimize = min.o mincont.o minone.o minpow.o minsimp.o minxtrap.o
+matrix   = matalloc.o matblas.o matcopy.o mateig.o matio.o matlapack.o \
+        matqr.o matsym.o mattri.o matutil.o
+minimize = min.o mincont.o minlbfgs.o minone.o minpow.o minsimp.o \
+        minxtrap.o
 model    = model.o modfn.o modparse.o
 
+# Compiler flags.  For a multithreaded build use OpenMP, e.g.
+#    make -f gaspunix.mak CFLAGS="-O2 -fopenmp" LDFLAGS=-fopenmp
+CFLAGS   = -O2
+LDFLAGS  =
+
+# Linear-algebra backend.  The default is the C code in matblas.c,
+# mattri.c, etc.  For BLAS/LAPACK (e.g. OpenBLAS or reference
+# LAPACK), remove any old .o files and use, e.g.,
+#    make -f gaspunix.mak LAPACK=-DLAPACK_DEFINED \
+#         LAPACKLIB="-llapack -lblas"
+LAPACK    =
+LAPACKLIB =
+
 # Make executables (lm is math library;
 # only standard-library functions are used).
 
 gasp: $(gasp) run.o dumcrit.o $(database) $(kriging) \
                 $(lib) $(matrix) $(minimize) $(model)
 	gcc $(gasp) run.o dumcrit.o $(database) $(kriging) \
-		$(lib) $(matrix) $(minimize) $(model) -o gasp -lm
+		$(lib) $(matrix) $(minimize) $(model) $(LDFLAGS) -o gasp $(LAPACKLIB) -lm
 
 # Implicit rule for compiling .c to .o files.
 .c.o:
-	gcc -c -Wall $<
+	gcc -c -Wall $(CFLAGS) $(LAPACK) $<
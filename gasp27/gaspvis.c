@@ -19,7 +19,7 @@
 #include "alex.h"
 
 extern boolean      ErrorSave;
-extern int          ErrorSeverityLevel;
+extern THREAD_LOCAL int ErrorSeverityLevel;
 extern string       ErrorVar;
 
 extern boolean      RanErr;
@@ -539,8 +539,9 @@ int CompSSTot(KrigingModel *KrigMod, const Matrix *PredReg,
 /* 1996.03.25: Averaging w.r.t. groups of variables.             */
 /* 1999.03.29: Cholesky decomposition of frfr replaced by eigen  */
 /*             decomposition.                                    */
+/* 2026.10.17: frfr has MAT_DENSE storage (for MatEig).          */
 /*                                                               */
-/* Version:    1999.03.29                                        */
+/* Version:    2026.10.17                                        */
 /*****************************************************************/
 {
      int       ErrNum;
@@ -556,7 +557,7 @@ int CompSSTot(KrigingModel *KrigMod, const Matrix *PredReg,
 
      /* Allocations:                                            */
      /* frfr is RECT because it is overwritten by eigenvectors. */
-     MatAlloc(k + n, k + n, RECT, &frfr);
+     MatAllocDense(k + n, k + n, RECT, &frfr);
      MatAlloc(k + n, k + n, SYM,  &frfrj);
 
      /* Workspace in KrigMod. */
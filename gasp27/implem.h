@@ -36,6 +36,20 @@ typedef double      real;
 #define LN_MAX      (700.0)        /* Approx. ln(REAL_MAX) */
 #define LN_MIN      (-700.0)       /* Approx. ln(REAL_MIN) */
 
+/* SIMD (AVX2/AVX-512) kernels for exp, log, and pow in libsimd.c, */
+/* chosen at run time.  Comment out for scalar code only.          */
+#if defined(__GNUC__) && defined(__x86_64__)
+     #define SIMD_DEFINED
+#endif
+
+/* Storage class for static data that must be private to each    */
+/* thread when compiled with OpenMP (e.g., parallel MLE tries).   */
+#ifdef _OPENMP
+     #define THREAD_LOCAL   _Thread_local
+#else
+     #define THREAD_LOCAL
+#endif
+
 #define DEF_IN_DIR   "."  /* Default directory for input files. */
 #define DEF_OUT_DIR  "."  /* Default directory for output files. */
 
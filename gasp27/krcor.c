@@ -9,6 +9,7 @@
 /*   All rights reserved.                                        */
 /*****************************************************************/
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -254,4 +255,163 @@ void KrigCorVec
           VecMultScalar(KrigMod->SPVarProp, n, r);
 }
 
+/*******************************+++*******************************/
+void KrigCorPair
+(
+     size_t       j,         /* Row j of G: the correlations     */
+                             /* with rows 0,..., j - 1 of G are  */
+                             /* computed.                        */
+     size_t       nActive,   /* Number of active terms.          */
+     const size_t *Active,   /* Indices of the active terms,     */
+                             /* which must be cached.            */
+     boolean      applySPVarProp,  /* Should correlations be     */
+                                   /* multiplied by SPVarProp?   */
+     const KrigingModel *KrigMod,
+     real         *r
+)
+/*****************************************************************/
+/* Purpose: As KrigCorVec for row j of G and the first j rows of */
+/*          G, but from the cache of distances.                  */
+/*                                                               */
+/* 2026.10.16: Created                                           */
+/*****************************************************************/
+{
+     CodeCheck(KrigPairDist(KrigMod) != NULL && Active != NULL);
+
+     if (KrigCorFam(KrigMod) == COR_FAM_POW_EXP)
+          PECorPair(j, nActive, Active, KrigCorPar(KrigMod),
+                    KrigMod->PairDist, KrigMod->PairLogDist, r);
+     else if (KrigCorFam(KrigMod) == COR_FAM_MATERN)
+          MaternCorPair(j, nActive, Active, KrigCorPar(KrigMod),
+                    KrigMod->PairDist, r);
+
+     if (applySPVarProp && KrigMod->SPVarProp < 1.0)
+          VecMultScalar(KrigMod->SPVarProp, j, r);
+}
+
+/*******************************+++*******************************/
+void KrigCorGrad
+(
+     size_t       nActive,   /* Number of active terms           */
+                             /* (only used if Active != NULL).   */
+     const size_t *Active,   /* If != NULL, then contains the    */
+                             /* indices of the active terms.     */
+     const Matrix *A,        /* A[i, j], i < j, weights the      */
+                             /* correlation of rows i and j.     */
+     const KrigingModel *KrigMod,
+     real         *Grad      /* Output: derivatives.             */
+)
+/*****************************************************************/
+/* Purpose: Compute the derivatives of                           */
+/*          sum over i < j of A[i, j] * log(R[i, j]),            */
+/*          where R is the correlation matrix for the rows of G, */
+/*          with respect to the correlation parameters of the    */
+/*          active terms.  The derivative for parameter l of the */
+/*          kk'th active term is Grad[kk * MatNumCols(CorPar) +  */
+/*          l], as CorPar is stacked by rows in MLEFit.          */
+/*                                                               */
+/* Comment: Derivatives with respect to a discrete parameter     */
+/*          (Matern deriv) are returned as zero.                 */
+/*          The distances are from the cache if there is one,    */
+/*          and otherwise from G.                                */
+/*                                                               */
+/* 2026.10.17: Created                                           */
+/*****************************************************************/
+{
+     const Matrix *CorPar, *G;
+     real      *d, *DistCol, *GCol, *LogD, *LogDistCol;
+     size_t    i, i0, j, k, kk, m, n, nPars;
+
+     CorPar = KrigCorPar(KrigMod);
+     G      = KrigG(KrigMod);
+     n      = MatNumRows(G);
+     nPars  = MatNumCols(CorPar);
+
+     if (Active == NULL)
+          nActive = MatNumCols(G);
+
+     /* Allocations. */
+     DistCol    = AllocReal(n, NULL);
+     LogDistCol = AllocReal(n, NULL);
+
+     VecInit(0.0, nActive * nPars, Grad);
+
+     for (j = 1; j < n; j++)
+          for (kk = 0; kk < nActive; kk++)
+          {
+               k = (Active == NULL) ? kk : Active[kk];
+
+               /* Distances between row j and rows 0,..., j - 1. */
+               if (KrigPairDist(KrigMod) != NULL &&
+                         KrigMod->PairDist[k] != NULL)
+                    d = KrigMod->PairDist[k] + KrigPairOffset(0, j);
+               else
+               {
+                    GCol = MatCol(G, k);
+                    for (i = 0; i < j; i++)
+                         DistCol[i] = fabs(GCol[j] - GCol[i]);
+                    d = DistCol;
+               }
+
+               if (KrigCorFam(KrigMod) == COR_FAM_POW_EXP)
+               {
+                    if (d != DistCol)
+                         LogD = KrigMod->PairLogDist[k]
+                                   + KrigPairOffset(0, j);
+                    else
+                    {
+                         /* As in KrigPairDistSetUp. */
+                         for (i0 = 0; i0 < j; i0 += VEC_CHUNK)
+                         {
+                              m = min(VEC_CHUNK, j - i0);
+                              VecLog(m, d + i0, LogDistCol + i0);
+                         }
+                         for (i = 0; i < j; i++)
+                              if (d[i] == 0.0)
+                                   LogDistCol[i] = -REAL_MAX;
+                         LogD = LogDistCol;
+                    }
+
+                    PEGradInc(j, d, LogD, MatElem(CorPar, k, 0),
+                              MatElem(CorPar, k, 1), MatCol(A, j),
+                              Grad + kk * nPars);
+               }
+               else if (KrigCorFam(KrigMod) == COR_FAM_MATERN)
+                    MaternGradInc(j, d, MatElem(CorPar, k, 0),
+                              MatElem(CorPar, k, 1), MatCol(A, j),
+                              Grad + kk * nPars);
+          }
+
+     AllocFree(DistCol);
+     AllocFree(LogDistCol);
+}
+
+/*******************************+++*******************************/
+void KrigExpNeg(size_t n, const real *w, real *e)
+/*****************************************************************/
+/* Purpose: e[i] = exp(-w[i]), i = 0,..., n - 1, with e[i] = 1   */
+/*          for w[i] < EPSILON.                                  */
+/*                                                               */
+/* Comment: The exponentials are computed by VecExp, a chunk at  */
+/*          a time.  e may be the same as w.                     */
+/*                                                               */
+/* 2026.10.16: Created                                           */
+/*****************************************************************/
+{
+     real      x[VEC_CHUNK];
+     size_t    i, i0, m;
+
+     for (i0 = 0; i0 < n; i0 += VEC_CHUNK)
+     {
+          m = min(VEC_CHUNK, n - i0);
+
+          for (i = 0; i < m; i++)
+               x[i] = -w[i0 + i];
 
+          VecExp(m, x, x);
+
+          for (i = 0; i < m; i++)
+               /* Bug in exp(x) for certain small values of x! */
+               e[i0 + i] = (w[i0 + i] < EPSILON) ? 1.0 : x[i];
+     }
+}
@@ -28,6 +28,9 @@ void KrigModAlloc(size_t nCases, size_t nXVars, const string yName,
 /*                                                               */
 /*   1996.04.14: Some code moved to KrigModData.                 */
 /*   2009.05.14: Multiple correlation families                   */
+/*   2026.10.16: Chol and Q have MAT_DENSE storage.              */
+/*   2026.10.16: PairDist and PairLogDist initialized.           */
+/*   2026.10.17: PairDistShared initialized.                     */
 /*****************************************************************/
 {
      size_t    kReg, kSP;
@@ -54,10 +57,16 @@ void KrigModAlloc(size_t nCases, size_t nXVars, const string yName,
      KrigMod->MaxSteps = AllocSize_t(kSP, NULL);
      MatAlloc(nCases, kSP, RECT, KrigDist(KrigMod));
 
+     /* Set up by KrigModData. */
+     KrigMod->PairDist       = NULL;
+     KrigMod->PairLogDist    = NULL;
+     KrigMod->PairDistShared = NO;
+
      CorParAlloc(CorFam, kSP, ModTermNames(SPMod), KrigCorPar(KrigMod));
 
-     MatAlloc(nCases, nCases, UP_TRIANG, KrigChol(KrigMod));
-     MatAlloc(nCases, kReg,   RECT,      KrigQ(KrigMod));
+     /* Workspaces for the decomposition are contiguous. */
+     MatAllocDense(nCases, nCases, UP_TRIANG, KrigChol(KrigMod));
+     MatAllocDense(nCases, kReg,   RECT,      KrigQ(KrigMod));
      MatAlloc(kReg,   kReg,   UP_TRIANG, KrigR(KrigMod));
 
      KrigMod->RBeta    = AllocReal(kReg, NULL);
@@ -85,8 +94,9 @@ void KrigModAllocT(KrigingModel *KrigMod)
 /*             transformations T.                                */
 /*                                                               */
 /*   96.04.04: KrigMod->Y reallocated instead of allocated.      */
+/*   2026.10.16: Chol (and hence C) has MAT_DENSE storage.       */
 /*                                                               */
-/*   Version:  1996.04.04                                        */
+/*   Version:  2026.10.16                                        */
 /*****************************************************************/
 {
      Matrix    *C, *Chol, *F, *T;
@@ -121,7 +131,7 @@ void KrigModAllocT(KrigingModel *KrigMod)
      *C = *Chol;
 
      /* Chol is t x t. */
-     MatAlloc(t, t, UP_TRIANG, Chol);
+     MatAllocDense(t, t, UP_TRIANG, Chol);
 }
 
 /*******************************+++*******************************/
@@ -130,8 +140,9 @@ void KrigModFree(KrigingModel *KrigMod)
 /*   Purpose:  Free kriging model.                               */
 /*                                                               */
 /*   96.04.04: KrigMod->Y freed.                                 */
+/*   2026.10.16: Cache of pairwise distances freed.              */
 /*                                                               */
-/*   Version:  1996.04.04                                        */
+/*   Version:  2026.10.16                                        */
 /*****************************************************************/
 {
      AllocFree(KrigY(KrigMod));
@@ -142,6 +153,7 @@ void KrigModFree(KrigingModel *KrigMod)
      MatFree(KrigSteps(KrigMod));
      AllocFree(KrigMod->MaxSteps);
      MatFree(KrigDist(KrigMod));
+     KrigPairDistFree(KrigMod);
 
      MatFree(KrigCorPar(KrigMod));
 
@@ -188,9 +200,12 @@ void KrigModFreeT(KrigingModel *KrigMod)
 void KrigModData(size_t nCases, const size_t *RowIndex,
      const Matrix *X, const real *y, KrigingModel *KrigMod)
 /*****************************************************************/
-/*   Purpose:  Set up y, F, G, and call KrigGSpacing.            */
+/*   Purpose:  Set up y, F, G, and call KrigGSpacing and         */
+/*             KrigPairDistSetUp.                                */
 /*                                                               */
-/*   Version:  1996.04.14                                        */
+/*   2026.10.16: KrigPairDistSetUp called.                       */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
 /*****************************************************************/
 {
      /* CritAMSE etc. do not have y at design stage. */
@@ -203,6 +218,7 @@ void KrigModData(size_t nCases, const size_t *RowIndex,
                KrigG(KrigMod));
 
      KrigGSpacing(KrigMod);
+     KrigPairDistSetUp(KrigMod);
 
      return;
 }
@@ -239,13 +255,21 @@ void KrigGSpacing(KrigingModel *KrigMod)
 /*****************************************************************/
 /*   Purpose:  Set up Steps and MaxSteps.                        */
 /*                                                               */
-/*   Version:  1995 January 16                                   */
+/*   Comment:  A column is regularly spaced if its values lie on */
+/*             a lattice with at most KRIG_STEPS_MULT * (n - 1)  */
+/*             steps; not every level need be present.           */
+/*                                                               */
+/*   2026.10.17: Step from KrigLatticeStep instead of the        */
+/*               minimum gap, which had to be at least           */
+/*               range / (n - 1); Dist re-allocated if needed.   */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
      Matrix    *G;
-     real      Eps, Gap, s, ss, StepLen;
-     real      *DistCol, *GCol, *r;
-     size_t    i, j, n;
+     real      Eps, Range, s, ss;
+     real      *DistCol, *GCol, *r, *StepLen;
+     size_t    i, j, n, NumSteps, MaxMaxSteps;
      size_t    *StepsCol, *MaxSteps;
 
      Eps = sqrt(EPSILON);
@@ -255,29 +279,35 @@ void KrigGSpacing(KrigingModel *KrigMod)
 
      MaxSteps = KrigMod->MaxSteps;
 
+     /* Allocation. */
+     StepLen = AllocReal(MatNumCols(G), NULL);
+
      /* Workspace. */
      r = KrigMod->r;
 
-     for (j = 0; j < MatNumCols(G); j++)
+     for (MaxMaxSteps = 0, j = 0; j < MatNumCols(G); j++)
      {
+          MaxSteps[j] = 0;
+
           GCol = MatCol(G, j);
           VecCopy(GCol, n, r);
           QuickReal(n, r);
 
-          /* Find StepLen, the minimum nonzero gap. */
-          for (StepLen = r[n-1] - r[0], i = 1; i < n; i++)
-               if ( (Gap = r[i] - r[i-1]) > 0.0)
-                    StepLen = min(StepLen, Gap);
+          Range      = r[n-1] - r[0];
+          StepLen[j] = KrigLatticeStep(n, r, Eps * Range);
 
-          MaxSteps[j] = 0;
-          if (StepLen == 0.0 ||
-                    StepLen < (r[n-1] - r[0]) / (n - 1) - Eps)
+          if (StepLen[j] == 0.0 ||
+                    Range / StepLen[j] > KRIG_STEPS_MULT * (n - 1) + 0.5)
                continue;
 
+          /* Round StepLen so that Range is a whole number of steps. */
+          NumSteps   = (size_t) floor(Range / StepLen[j] + 0.5);
+          StepLen[j] = Range / NumSteps;
+
           StepsCol = MatSize_tCol(KrigSteps(KrigMod), j);
           for (i = 0; i < n; i++)
           {
-               s  = (GCol[i] - r[0]) / StepLen;
+               s  = (GCol[i] - r[0]) / StepLen[j];
                ss = floor(s + Eps);
                if (ApproxEq(s, ss, Eps, 0.0))
                {
@@ -291,13 +321,217 @@ void KrigGSpacing(KrigingModel *KrigMod)
                }
           }
 
+          MaxMaxSteps = max(MaxSteps[j], MaxMaxSteps);
+     }
+
+     if (MaxMaxSteps > MatNumRows(KrigDist(KrigMod)))
+          MatReAlloc(MaxMaxSteps, MatNumCols(G), KrigDist(KrigMod));
+
+     for (j = 0; j < MatNumCols(G); j++)
           if (MaxSteps[j] > 0)
           {
                DistCol = MatCol(KrigDist(KrigMod), j);
                for (i = 0; i < MaxSteps[j]; i++)
-                    DistCol[i] = (i + 1) * StepLen;
+                    DistCol[i] = (i + 1) * StepLen[j];
           }
+
+     AllocFree(StepLen);
+}
+
+/*******************************+++*******************************/
+real KrigLatticeStep(size_t n, const real *r, real Tol)
+/*****************************************************************/
+/*   Purpose:  Find the common step of the sorted values         */
+/*             r[0],..., r[n-1], i.e., the approximate greatest  */
+/*             common divisor of the gaps, to within Tol.        */
+/*                                                               */
+/*   Returns:  The step, or 0.0 if r[n-1] = r[0] or the step is  */
+/*             less than Tol.                                    */
+/*                                                               */
+/*   Comment:  Euclid's algorithm with the nearest remainder,    */
+/*             which at least halves at each iteration; a        */
+/*             remainder <= Tol is taken as zero.  The caller    */
+/*             checks every value is on the lattice.             */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      a, b, Gap, Rem, Step;
+     size_t    i;
+
+     for (Step = 0.0, i = 1; i < n; i++)
+     {
+          if ( (Gap = r[i] - r[i-1]) <= Tol)
+               continue;
+
+          if (Step == 0.0)
+          {
+               Step = Gap;
+               continue;
+          }
+
+          /* Step becomes gcd(Step, Gap). */
+          a = max(Step, Gap);
+          b = min(Step, Gap);
+          while (b > Tol)
+          {
+               Rem = fabs(a - b * floor(a / b + 0.5));
+               a   = b;
+               b   = Rem;
+          }
+          Step = a;
      }
+
+     return (Step > Tol) ? Step : 0.0;
+}
+
+/*******************************+++*******************************/
+void KrigPairDistSetUp(KrigingModel *KrigMod)
+/*****************************************************************/
+/*   Purpose:  Set up the cache of pairwise distances for the    */
+/*             irregularly spaced columns of G.                  */
+/*                                                               */
+/*   Comment:  G does not change during fitting, only the        */
+/*             correlation parameters, so KrigCorC can compute   */
+/*             correlations from PairDist instead of G.  For the */
+/*             power-exponential family, PairLogDist allows      */
+/*             |d| ** (2 - Alpha) to be computed as              */
+/*             exp((2 - Alpha) * log|d|), which is much faster   */
+/*             than pow.                                         */
+/*             No cache (PairDist = NULL) if it would need more  */
+/*             than KRIG_PAIR_DIST_MAX reals; KrigCorC then      */
+/*             works from G.                                     */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     boolean   Logs;
+     Matrix    *G;
+     real      *d, *GCol, *LogD;
+     size_t    i, j, k, kSP, n, nCached, nPairs;
+
+     KrigPairDistFree(KrigMod);
+
+     G   = KrigG(KrigMod);
+     n   = MatNumRows(G);
+     kSP = MatNumCols(G);
+
+     if (n < 2)
+          return;
+
+     nPairs = n * (n - 1) / 2;
+     Logs   = (KrigCorFam(KrigMod) == COR_FAM_POW_EXP);
+
+     for (nCached = 0, k = 0; k < kSP; k++)
+          if (KrigMod->MaxSteps[k] == 0)
+               nCached++;
+
+     if (nCached == 0 || nPairs > KRIG_PAIR_DIST_MAX
+               / (nCached * (Logs ? 2 : 1)))
+          return;
+
+     KrigMod->PairDist = (real **) AllocGeneric(kSP, sizeof(real *),
+               NULL);
+     if (Logs)
+          KrigMod->PairLogDist = (real **) AllocGeneric(kSP,
+                    sizeof(real *), NULL);
+
+     for (k = 0; k < kSP; k++)
+     {
+          KrigMod->PairDist[k] = NULL;
+          if (Logs)
+               KrigMod->PairLogDist[k] = NULL;
+
+          if (KrigMod->MaxSteps[k] > 0)
+               /* Regularly spaced: see KrigCorC. */
+               continue;
+
+          GCol = MatCol(G, k);
+          d = KrigMod->PairDist[k] = AllocReal(nPairs, NULL);
+          for (j = 1; j < n; j++)
+               for (i = 0; i < j; i++)
+                    d[KrigPairOffset(i, j)] = fabs(GCol[j] - GCol[i]);
+
+          if (Logs)
+          {
+               LogD = KrigMod->PairLogDist[k] = AllocReal(nPairs, NULL);
+               for (i = 0; i < nPairs; i++)
+                    LogD[i] = (d[i] > 0.0) ? log(d[i]) : -REAL_MAX;
+          }
+     }
+
+     return;
+}
+
+/*******************************+++*******************************/
+void KrigPairDistFree(KrigingModel *KrigMod)
+/*****************************************************************/
+/*   Purpose:  Free the cache of pairwise distances.             */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*   2026.10.17: A shared cache is only detached.                */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    k, kSP;
+
+     if (KrigMod->PairDistShared)
+     {
+          KrigMod->PairDist       = NULL;
+          KrigMod->PairLogDist    = NULL;
+          KrigMod->PairDistShared = NO;
+          return;
+     }
+
+     kSP = MatNumCols(KrigG(KrigMod));
+
+     if (KrigMod->PairDist != NULL)
+     {
+          for (k = 0; k < kSP; k++)
+               AllocFree(KrigMod->PairDist[k]);
+          AllocFree(KrigMod->PairDist);
+          KrigMod->PairDist = NULL;
+     }
+
+     if (KrigMod->PairLogDist != NULL)
+     {
+          for (k = 0; k < kSP; k++)
+               AllocFree(KrigMod->PairLogDist[k]);
+          AllocFree(KrigMod->PairLogDist);
+          KrigMod->PairLogDist = NULL;
+     }
+
+     return;
+}
+
+/*******************************+++*******************************/
+void KrigPairDistShare(const KrigingModel *From, KrigingModel *To)
+/*****************************************************************/
+/*   Purpose:  Make To read the cache of pairwise distances of   */
+/*             From instead of having its own.                   */
+/*                                                               */
+/*   Comment:  To must have the same G as From.  FitBest uses    */
+/*             this for its per-thread copies of the model, so   */
+/*             that the cache, by far their largest workspace,   */
+/*             is not duplicated.                                */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     KrigPairDistFree(To);
+
+     To->PairDist       = From->PairDist;
+     To->PairLogDist    = From->PairLogDist;
+     To->PairDistShared = (From->PairDist != NULL);
+
+     return;
 }
 
 /*******************************+++*******************************/
@@ -375,12 +609,15 @@ void KrigCorC
 /* 1995.07.27: Created?                                          */
 /* 2009.05.14: KrigCorVec replaces PECor, and CorParIsActive     */
 /*             replaces PEIsActive (multiple correlation         */
-/*             families)                                         */                       
+/*             families)                                         */
+/* 2026.10.16: KrigCorPair used for the irregularly spaced       */
+/*             columns if the distances are cached.              */                       
+/* 2026.10.17: Cor allocated, as MaxSteps may be >= n.           */
 /*****************************************************************/
 {
      Matrix    *CorPar;
      real      *Cor, *CCol, *gRow;
-     size_t    i, j, k, kk, n, NumActiveIrreg, StepsDiff;
+     size_t    i, j, k, kk, n, MaxMaxSteps, NumActiveIrreg, StepsDiff;
      size_t    *ActiveIrreg, *MaxSteps, *StepsCol;
 
      CorPar = KrigCorPar(KrigMod);
@@ -392,31 +629,38 @@ void KrigCorC
      if (Active == NULL)
           nActive = MatNumCols(KrigG(KrigMod));
 
-     /* Allocations. */
+     /* Allocation. */
      ActiveIrreg = AllocSize_t(nActive, NULL);
 
-     /* Workspace of length n. */
-     Cor = KrigMod->w1;
-
      /* ActiveIrreg indexes the G columns with irregular spacing. */
-     for (NumActiveIrreg = 0, kk = 0; kk < nActive; kk++)
+     for (NumActiveIrreg = 0, MaxMaxSteps = 0, kk = 0; kk < nActive;
+               kk++)
      {
           k = (Active == NULL) ? kk : Active[kk];
           if (MaxSteps[k] == 0)
                /* Irregular spacing. */
                ActiveIrreg[NumActiveIrreg++] = k;
+          MaxMaxSteps = max(MaxSteps[k], MaxMaxSteps);
      }
 
+     /* Allocation: possible correlations for a regular column. */
+     Cor = AllocReal(MaxMaxSteps + 1, NULL);
+
      MatPutElem(C, 0, 0, 1.0);
 
      /* Irregularly spaced G columns. */
      for (j = 1; j < n; j++)
      {
-          MatRow(KrigG(KrigMod), j, gRow);
-
           /* Only have j correlations in column j. */
-          KrigCorVec(gRow, KrigG(KrigMod), j, NumActiveIrreg,
-                    ActiveIrreg, YES, KrigMod, MatCol(C, j));
+          if (KrigPairDist(KrigMod) != NULL)
+               KrigCorPair(j, NumActiveIrreg, ActiveIrreg, YES,
+                         KrigMod, MatCol(C, j));
+          else
+          {
+               MatRow(KrigG(KrigMod), j, gRow);
+               KrigCorVec(gRow, KrigG(KrigMod), j, NumActiveIrreg,
+                         ActiveIrreg, YES, KrigMod, MatCol(C, j));
+          }
           MatPutElem(C, j, j, 1.0);
      }
 
@@ -458,6 +702,58 @@ void KrigCorC
      }
 
      AllocFree(ActiveIrreg);
+     AllocFree(Cor);
+
+     return;
+}
+
+/*******************************+++*******************************/
+void KrigCorSub
+(
+     const Matrix *C,        /* Upper triangle of the correlation*/
+                             /* matrix for a larger set of cases.*/
+     const size_t *Index,    /* Case i of KrigMod is case        */
+                             /* Index[i] of C.                   */
+     KrigingModel *KrigMod
+)
+/*****************************************************************/
+/*   Purpose:  Put the correlation matrix into Chol by gathering */
+/*             the cases' rows and columns of C, which must be   */
+/*             for the same correlation parameters and           */
+/*             SPVarProp.                                        */
+/*                                                               */
+/*   Comment:  Index may repeat a case (with random error): the  */
+/*             correlation between the repeats is SPVarProp.     */
+/*             Costs O(n^2) instead of KrigCorMat's O(n^2 k).    */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     Matrix    *Chol;
+     real      *CholCol;
+     size_t    i, j, n;
+
+     CodeCheck(KrigT(KrigMod) == NULL || MatNumCols(KrigT(KrigMod)) == 0);
+
+     Chol = KrigChol(KrigMod);
+     n    = MatNumRows(Chol);
+
+     for (j = 0; j < n; j++)
+     {
+          CholCol = MatCol(Chol, j);
+          for (i = 0; i < j; i++)
+          {
+               if (Index[i] == Index[j])
+                    CholCol[i] = KrigMod->SPVarProp;
+               else if (Index[i] < Index[j])
+                    CholCol[i] = MatCol(C, Index[j])[Index[i]];
+               else
+                    CholCol[i] = MatCol(C, Index[i])[Index[j]];
+          }
+          CholCol[j] = 1.0;
+     }
 
      return;
 }
@@ -527,13 +823,9 @@ int KrigSolve(const Matrix *Chol, const Matrix *F, const real *Y,
           Matrix *FTilde, real *YTilde)
 {
      int       ErrNum;
-     size_t    j;
 
      /* Solve Chol' FTilde = F for FTilde */
-     ErrNum = OK;
-     for (j = 0; j < MatNumCols(F) && ErrNum == OK; j++)
-          ErrNum = TriForSolve(Chol, MatCol(F, j), 0,
-                    MatCol(FTilde, j));
+     ErrNum = TriForSolveMat(Chol, F, FTilde);
 
      /* Solve Chol' YTilde = Y for YTilde; */
      if (ErrNum == OK)
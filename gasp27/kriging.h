@@ -33,11 +33,29 @@ typedef struct
      size_t    *MaxSteps;     /* MaxSteps[j] is the maximum */
                               /* of column j of Steps.      */
      Matrix    Dist;          /* Dist[i,j] = (i + 1) * (step length) */
-                              /* for i = 0,..., MaxSteps[j] - 1.     */
+                              /* for i = 0,..., MaxSteps[j] - 1;     */
+                              /* it has at least nCases rows.        */
 
      /* If the spacing in column j of G is irregular, */
      /* then MaxSteps[j] = 0.                         */
 
+     /* Cache of distances for the irregularly spaced columns */
+     /* of G, which do not change with the correlation        */
+     /* parameters (see KrigPairDistSetUp).                   */
+
+     real      **PairDist;    /* If != NULL, PairDist[k] holds  */
+                              /* |G[i,k] - G[j,k]| for i < j,   */
+                              /* packed by columns j (see       */
+                              /* KrigPairOffset), or is NULL if */
+                              /* column k is regularly spaced.  */
+     real      **PairLogDist; /* Logs of the PairDist distances */
+                              /* (power-exponential family      */
+                              /* only; otherwise NULL).         */
+     boolean   PairDistShared;
+                              /* YES if the cache belongs to    */
+                              /* another model and is only read */
+                              /* (see KrigPairDistShare).       */
+
      /* Fitted values of kriging-model parameters. */
 
      Matrix    CorPar;        /* Correlation parameters. */
@@ -83,6 +101,7 @@ typedef struct
 #define KrigG(M)         (&(M)->G)
 #define KrigSteps(M)     (&(M)->Steps)
 #define KrigDist(M)      (&(M)->Dist)
+#define KrigPairDist(M)  ((M)->PairDist)
 
 #define KrigCorPar(M)    (&(M)->CorPar)
 
@@ -95,6 +114,11 @@ typedef struct
 #define COR_FAM_POW_EXP  0
 #define COR_FAM_MATERN   1
 
+/* Optimizers for the likelihood (MinAlgNum). */
+#define MIN_ALG_NAMES    {POWELL, LBFGS}
+#define MIN_ALG_POWELL   0
+#define MIN_ALG_LBFGS    1
+
 /* krcorpar.c: */
 
 /*******************************+++*******************************/
@@ -209,9 +233,68 @@ void KrigCorVec
 /*             points in the first n rows of G.                  */
 /*****************************************************************/
 
+/*******************************+++*******************************/
+void KrigCorPair
+(
+     size_t       j,         /* Row j of G: the correlations     */
+                             /* with rows 0,..., j - 1 of G are  */
+                             /* computed.                        */
+     size_t       nActive,   /* Number of active terms.          */
+     const size_t *Active,   /* Indices of the active terms,     */
+                             /* which must be cached.            */
+     boolean      applySPVarProp,  /* Should correlations be     */
+                                   /* multiplied by SPVarProp?   */
+     const KrigingModel *KrigMod,
+     real         *r
+);
+/*****************************************************************/
+/* Purpose: As KrigCorVec for row j of G and the first j rows of */
+/*          G, but from the cache of distances.                  */
+/*****************************************************************/
+
+/*******************************+++*******************************/
+void KrigCorGrad
+(
+     size_t       nActive,   /* Number of active terms           */
+                             /* (only used if Active != NULL).   */
+     const size_t *Active,   /* If != NULL, then contains the    */
+                             /* indices of the active terms.     */
+     const Matrix *A,        /* A[i, j], i < j, weights the      */
+                             /* correlation of rows i and j.     */
+     const KrigingModel *KrigMod,
+     real         *Grad      /* Output: derivatives.             */
+);
+/*****************************************************************/
+/* Purpose: Compute the derivatives of                           */
+/*          sum over i < j of A[i, j] * log(R[i, j]),            */
+/*          where R is the correlation matrix for the rows of G, */
+/*          with respect to the correlation parameters of the    */
+/*          active terms (stacked by rows, one row per active    */
+/*          term).                                               */
+/*****************************************************************/
+
+/*****************************************************************/
+void KrigExpNeg(size_t n, const real *w, real *e);
+/*****************************************************************/
+/* Purpose: e[i] = exp(-w[i]), i = 0,..., n - 1, with e[i] = 1   */
+/*          for w[i] < EPSILON.                                  */
+/*****************************************************************/
+
 
 /* kriging.c: */
 
+/* Element of row i, column j of the packed pairwise distances. */
+#define KrigPairOffset(i, j)  ((j) * ((j) - 1) / 2 + (i))
+
+/* Maximum number of reals in the cache of pairwise distances. */
+#define KRIG_PAIR_DIST_MAX  16777216
+
+/* A column of G (n rows, i.e., cases, replicates included) is   */
+/* treated as regularly spaced if its lattice has at most        */
+/* KRIG_STEPS_MULT * (n - 1) steps, i.e., is at most             */
+/* KRIG_STEPS_MULT times finer than n equally spaced levels.     */
+#define KRIG_STEPS_MULT  8
+
 /*******************************+++*******************************/
 void KrigModAlloc(size_t nCases, size_t nXVars, const string yName,
      const Matrix *T, const LinModel *RegMod,
@@ -244,7 +327,8 @@ void KrigModFreeT(KrigingModel *KrigMod);
 void KrigModData(size_t nCases, const size_t *RowIndex,
      const Matrix *X, const real *y, KrigingModel *KrigMod);
 /*****************************************************************/
-/*   Purpose:  Set up y, F, G, and call KrigGSpacing.            */
+/*   Purpose:  Set up y, F, G, and call KrigGSpacing and         */
+/*             KrigPairDistSetUp.                                */
 /*****************************************************************/
 
 /*****************************************************************/
@@ -260,6 +344,49 @@ int KrigModSetUp(const Matrix *CorPar, const string yName,
 void KrigGSpacing(KrigingModel *KrigMod);
 /*****************************************************************/
 /*   Purpose:  Set up Steps and MaxSteps.                        */
+/*                                                               */
+/*   Comment:  A column is regularly spaced if its values lie on */
+/*             a lattice, not necessarily with every level       */
+/*             present (e.g., a subset of a Latin hypercube).    */
+/*****************************************************************/
+
+/*****************************************************************/
+real KrigLatticeStep(size_t n, const real *r, real Tol);
+/*****************************************************************/
+/*   Purpose:  Find the common step of the sorted values         */
+/*             r[0],..., r[n-1], i.e., the approximate greatest  */
+/*             common divisor of the gaps, to within Tol.        */
+/*                                                               */
+/*   Returns:  The step, or 0.0 if r[n-1] = r[0] or the step is  */
+/*             less than Tol.                                    */
+/*****************************************************************/
+
+/*****************************************************************/
+void KrigPairDistSetUp(KrigingModel *KrigMod);
+/*****************************************************************/
+/*   Purpose:  Set up the cache of pairwise distances for the    */
+/*             irregularly spaced columns of G.                  */
+/*                                                               */
+/*   Comment:  No cache (PairDist = NULL) if it would need more  */
+/*             than KRIG_PAIR_DIST_MAX reals.                    */
+/*****************************************************************/
+
+/*****************************************************************/
+void KrigPairDistFree(KrigingModel *KrigMod);
+/*****************************************************************/
+/*   Purpose:  Free the cache of pairwise distances.             */
+/*                                                               */
+/*   Comment:  A shared cache is only detached.                  */
+/*****************************************************************/
+
+/*****************************************************************/
+void KrigPairDistShare(const KrigingModel *From, KrigingModel *To);
+/*****************************************************************/
+/*   Purpose:  Make To read the cache of pairwise distances of   */
+/*             From instead of having its own.                   */
+/*                                                               */
+/*   Comment:  To must have the same G as From, and From must    */
+/*             outlive To's use of the cache.                    */
 /*****************************************************************/
 
 /*****************************************************************/
@@ -291,6 +418,25 @@ void KrigCorC
 /*             KrigMod).                                         */
 /*****************************************************************/
 
+/*****************************************************************/
+void KrigCorSub
+(
+     const Matrix *C,        /* Upper triangle of the correlation*/
+                             /* matrix for a larger set of cases.*/
+     const size_t *Index,    /* Case i of KrigMod is case        */
+                             /* Index[i] of C.                   */
+     KrigingModel *KrigMod
+);
+/*****************************************************************/
+/*   Purpose:  Put the correlation matrix into Chol by gathering */
+/*             the cases' rows and columns of C, which must be   */
+/*             for the same correlation parameters and           */
+/*             SPVarProp.                                        */
+/*                                                               */
+/*   Comment:  Index may repeat a case (with random error).      */
+/*             Transformations T are not allowed.                */
+/*****************************************************************/
+
 /*****************************************************************/
 int KrigDecompose(KrigingModel *KrigMod);
 /*****************************************************************/
@@ -384,12 +530,18 @@ int MLEFit
      size_t       Try,
      real         *NegLogLike,/* Output: -log(likelihood).       */
      real         *CondNum,   /* Output: condition number.       */
-     unsigned     *TotFuncs   /* Output: likelihood evaluations. */
+     unsigned     *TotFuncs,  /* Output: likelihood evaluations. */
+     size_t       *Iter       /* Output: iteration count shown   */
+                              /* by FitBest.                     */
 );
 /*****************************************************************/
 /*   Purpose:  Fit regression and correlation parameters.        */
 /*                                                               */
 /*   Returns:  OK or error condition.                            */
+/*                                                               */
+/*   Comment:  The state of the fit is private to the calling    */
+/*             thread, so fits of separate kriging models may    */
+/*             run concurrently.                                 */
 /*****************************************************************/
 
 /*****************************************************************/
@@ -404,8 +556,8 @@ unsigned MLEOneTerm
 );
 /*****************************************************************/
 /*   Purpose:  Optimize correlation parameters for term          */
-/*             TermIndex (external), other parameters remaining  */
-/*             fixed.                                            */
+/*             TermIndex (in the context of the fit), other      */
+/*             parameters remaining fixed.                       */
 /*                                                               */
 /*   Returns:  Number of function evaluations.                   */
 /*****************************************************************/
@@ -419,7 +571,7 @@ real MLELike(void);
 /*   Returns:  -log(likelihood)                                  */
 /*                                                               */
 /*   Comment   Correct correlation matrix must be already loaded */
-/*             into ExtKrigMod->Chol.                            */
+/*             into the Chol of the fit's kriging model.         */
 /*****************************************************************/
 
 /*****************************************************************/
@@ -452,6 +604,40 @@ real MLELikeObj
 /*   Returns:  -log(likelihood)                                  */
 /*****************************************************************/
 
+/*****************************************************************/
+real MLELikeObjGrad
+(
+     real   *CorParVec,  /* Input: Correlation parameters        */
+                         /* arranged as a vector for all terms,  */
+                         /* followed by SPVarProp.               */
+     size_t NumPars,     /* Number of parameters.                */
+     real   *Grad        /* Output: gradient, unless NULL.       */
+);
+/*****************************************************************/
+/*   Purpose:  As MLELikeObj, and compute the gradient with      */
+/*             respect to CorParVec (for MinAnyXGrad).           */
+/*                                                               */
+/*   Returns:  -log(likelihood)                                  */
+/*****************************************************************/
+
+/*****************************************************************/
+void MLELikeGrad
+(
+     real   *Grad,           /* Output: derivatives with respect */
+                             /* to the correlation parameters    */
+                             /* (CorPar by rows).                */
+     real   *SPVarPropGrad   /* Output: derivative with respect  */
+                             /* to SPVarProp.                    */
+);
+/*****************************************************************/
+/*   Purpose:  Compute the gradient of -log(likelihood) after    */
+/*             MLELike.                                          */
+/*                                                               */
+/*   Comment:  The correlation matrix must have been copied to   */
+/*             CorMat of the fit before MLELike.  The gradient   */
+/*             is zero if MLELike failed.                        */
+/*****************************************************************/
+
 /*****************************************************************/
 real MLELikeScale
 (
@@ -516,12 +702,39 @@ void MaternCor(
 /*****************************************************************/
 
 /*******************************+++*******************************/
-void MaternCorOneDim(real h, const real *g, size_t n, real theta,
-          real deriv, real *Cor);
+void MaternCorPair(
+     size_t       j,         /* Row j of G.                      */
+     size_t       NumActive, /* Number of active terms.          */
+     const size_t *Active,   /* Indices of the active terms.     */
+     const Matrix *CorPar,   /* Correlation parameters.          */
+     real * const *PairDist, /* Cached distances (KrigingModel). */
+     real         *Cor       /* Output: correlations.            */
+);
+/*****************************************************************/
+/* Purpose:  As MaternCor for row j of G and the first j rows of */
+/*           G, from the cached distances.                       */
+/*****************************************************************/
+
+/*******************************+++*******************************/
+void MaternDistInc(const real *Dist, size_t n, real theta,
+          real deriv, real *WtDist, real *Poly);
+/*****************************************************************/
+/* Purpose:  For the 1-d Matern correlations from the distances  */
+/*           Dist[0],...,Dist[n-1], increment the weighted       */
+/*           distances WtDist[0],...,WtDist[n-1] and multiply    */
+/*           the polynomial factors Poly[0],...,Poly[n-1].  The  */
+/*           correlation over all dimensions is then             */
+/*           exp(-WtDist[i]) * Poly[i].                          */
+/*****************************************************************/
+
+/*******************************+++*******************************/
+void MaternGradInc(size_t n, const real *Dist, real theta,
+          real deriv, const real *A, real *Grad);
 /*****************************************************************/
-/* Purpose:  Multiply the correlations Cor[0],...,Cor[n-1] by    */
-/*           the 1-d Matern correlations from the distances      */
-/*            between h and g[0],...,g[n-1].                     */
+/* Purpose:  Increment Grad[0] by the derivative with respect to */
+/*           theta of A[0] * log(r[0]) + ... +                   */
+/*           A[n-1] * log(r[n-1]), where r[i] is the 1-d Matern  */
+/*           correlation for the distance Dist[i].               */
 /*****************************************************************/
 
 /*******************************+++*******************************/
@@ -633,6 +846,31 @@ void PEDistInc(real h, const real *g, size_t n, real Theta,
 /*             the distances between h and g[0],...,g[n-1].      */
 /*****************************************************************/
 
+/*****************************************************************/
+void PECorPair(
+     size_t       j,         /* Row j of G.                      */
+     size_t       NumActive, /* Number of active terms.          */
+     const size_t *Active,   /* Indices of the active terms.     */
+     const Matrix *CorPar,   /* Correlation parameters.          */
+     real * const *PairDist, /* Cached distances and their logs  */
+     real * const *PairLogDist,  /* (KrigingModel).              */
+     real         *Cor       /* Output: correlations.            */
+);
+/*****************************************************************/
+/*   Purpose:  As PECor for row j of G and the first j rows of   */
+/*             G, from the cached distances.                     */
+/*****************************************************************/
+
+/*****************************************************************/
+void PEGradInc(size_t n, const real *Dist, const real *LogDist,
+          real Theta, real Alpha, const real *A, real *Grad);
+/*****************************************************************/
+/*   Purpose:  Increment Grad[0] and Grad[1] by the derivatives  */
+/*             with respect to Theta and Alpha of                */
+/*             -Theta * (A[0] * |Dist[0]| ** (2 - Alpha) + ... + */
+/*             A[n-1] * |Dist[n-1]| ** (2 - Alpha)).             */
+/*****************************************************************/
+
 /*****************************************************************/
 unsigned PETest
 (
@@ -698,6 +936,9 @@ void KrigPred(KrigingModel *KrigMod, const Matrix *XPred,
 /*   Comment:  Calling routine must allocate space for YHat.     */
 /*****************************************************************/
 
+/* Points per tile in KrigPredSE. */
+#define KRIG_PRED_BLOCK  64
+
 /*****************************************************************/
 int KrigPredSE(KrigingModel *KrigMod, const Matrix *XPred,
           real *YHat, real *SE);
@@ -714,6 +955,7 @@ int KrigPredSE(KrigingModel *KrigMod, const Matrix *XPred,
 /*                                                               */
 /*   Comment:  Calling routine must allocate space for YHat and  */
 /*             SE.                                               */
+/*             Points are processed in tiles of KRIG_PRED_BLOCK. */
 /*****************************************************************/
 
 /*****************************************************************/
@@ -746,3 +988,80 @@ int KrigTilde(const KrigingModel *KrigMod, real *f, real *r);
 /*                                                               */
 /*   Returns:  OK or an error number.                            */
 /*****************************************************************/
+
+/*****************************************************************/
+int KrigTildeMat(const KrigingModel *KrigMod, Matrix *FTilde,
+          Matrix *RTilde);
+/*****************************************************************/
+/*   Purpose:  As KrigTilde, for several points: overwrite each  */
+/*             column of FTilde with fTilde and each column of   */
+/*             RTilde with rTilde.                               */
+/*                                                               */
+/*   Returns:  OK or an error number.                            */
+/*****************************************************************/
+
+
+/* krsave.c: */
+
+/* Fitted-model files (see krsave.c).  Items are multiples */
+/* of KRIG_FILE_ALIGN reals.                               */
+#define KRIG_FILE_ALIGN    (MAT_ALIGN / sizeof(real))
+#define KRIG_FILE_MAGIC    "GaSP.gfm"
+#define KRIG_FILE_VERSION  2
+#define KRIG_FILE_ORDER    1234567.0
+
+/*****************************************************************/
+FILE *KrigFileOpen(const string FileName, boolean Write);
+/*****************************************************************/
+/*   Purpose:  Open a fitted-model file for writing (the header  */
+/*             is written) or reading (the header is checked).   */
+/*                                                               */
+/*   Returns:  The file, or NULL (with an error message) if it   */
+/*             cannot be opened or is not a fitted-model file.   */
+/*****************************************************************/
+
+/*****************************************************************/
+ulong KrigDataHash(size_t nCases, const size_t *RowIndex,
+     const Matrix *X, const real *y);
+/*****************************************************************/
+/*   Purpose:  Return a hash of the data used by KrigModData:    */
+/*             rows RowIndex[0],..., RowIndex[nCases - 1] of X   */
+/*             and y.                                            */
+/*****************************************************************/
+
+/*****************************************************************/
+int KrigModWrite(FILE *File, const KrigingModel *KrigMod,
+     ulong DataHash);
+/*****************************************************************/
+/*   Purpose:  Append the record for KrigMod, which must have    */
+/*             its parameters and decompositions set up, to a    */
+/*             fitted-model file opened by KrigFileOpen.         */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*****************************************************************/
+
+/*****************************************************************/
+int KrigModRead(FILE *File, ulong DataHash, KrigingModel *KrigMod);
+/*****************************************************************/
+/*   Purpose:  Find the record for KrigYName(KrigMod) in a       */
+/*             fitted-model file opened by KrigFileOpen and put  */
+/*             its parameters and decompositions in KrigMod, as  */
+/*             KrigModData and KrigModSetUp would.               */
+/*                                                               */
+/*   Returns:  OK           if successful;                       */
+/*             INCOMPAT_ERR if there is no record for the        */
+/*                          response with DataHash, the          */
+/*                          dimensions, CorFam, RanErr, and      */
+/*                          model terms of KrigMod, and its      */
+/*                          parameters (KrigMod is unchanged);   */
+/*             FILE_ERR     if the file cannot be read (G and    */
+/*                          the decompositions are reset to      */
+/*                          zero).                               */
+/*                                                               */
+/*   Comment:  KrigMod must have been allocated by KrigModAlloc, */
+/*             and its parameters set up by CorParSetUp; they    */
+/*             must agree with the record's to within a relative */
+/*             KRIG_PAR_TOL.                                     */
+/*             Only what prediction needs is read: F, Y, and the */
+/*             spacing of G are not set up.                      */
+/*****************************************************************/
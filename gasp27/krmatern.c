@@ -25,6 +25,13 @@ extern real    ThetaStandMin;
 #define RELTOL      1.0e-10      /* Set small so won't be used. */
 #define MAXFUNCS    100
 
+/* MaternDistInc: the polynomial factors are evaluated at weighted */
+/* distances no larger than WT_DIST_MAX (the correlation is zero   */
+/* to machine precision beyond), and products larger than POLY_MAX */
+/* are moved into the exponent.                                    */
+#define WT_DIST_MAX (2.0 * LN_MAX)
+#define POLY_MAX    1.0e100
+
 /*******************************+++*******************************/
 void MaternAlloc
 (
@@ -181,53 +188,115 @@ void MaternCor(
 /*           points in the first n rows of G.                    */
 /*                                                               */
 /* 2009.05.08: Created                                           */
+/* 2026.10.17: One exp call per correlation (see MaternDistInc)  */
+/*             instead of one per dimension.                     */
 /*****************************************************************/
 {
-     real      *deriv, *theta;
-     size_t    i, ii;
+     real      Dist[VEC_CHUNK], Poly[VEC_CHUNK];
+     real      *deriv, *GCol, *theta;
+     size_t    i, i0, ii, k, m, NumTerms;
+
+     theta = MatCol(CorPar, 0);
+     deriv = MatCol(CorPar, 1);
+
+     NumTerms = (Active == NULL) ? MatNumCols(G) : NumActive;
+
+     /* The correlation is exp(-Cor) * Poly, where Cor sums the  */
+     /* weighted distances and Poly multiplies the polynomial    */
+     /* factors for deriv = 1 or 2 over the dimensions.          */
+     for (i0 = 0; i0 < n; i0 += VEC_CHUNK)
+     {
+          m = min(VEC_CHUNK, n - i0);
 
-     VecInit(1.0, n, Cor);
+          VecInit(0.0, m, Cor + i0);
+          VecInit(1.0, m, Poly);
+
+          for (ii = 0; ii < NumTerms; ii++)
+          {
+               k    = (Active == NULL) ? ii : Active[ii];
+               GCol = MatCol(G, k) + i0;
+               for (i = 0; i < m; i++)
+                    Dist[i] = fabs(g[k] - GCol[i]);
+               MaternDistInc(Dist, m, theta[k], deriv[k], Cor + i0,
+                         Poly);
+          }
+
+          KrigExpNeg(m, Cor + i0, Cor + i0);
+          for (i = 0; i < m; i++)
+               Cor[i0 + i] *= Poly[i];
+     }
+
+     return;
+}
+
+/*******************************+++*******************************/
+void MaternCorPair(
+     size_t       j,         /* Row j of G.                      */
+     size_t       NumActive, /* Number of active terms.          */
+     const size_t *Active,   /* Indices of the active terms.     */
+     const Matrix *CorPar,   /* Correlation parameters.          */
+     real * const *PairDist, /* Cached distances (KrigingModel). */
+     real         *Cor       /* Output: correlations.            */
+)
+/*****************************************************************/
+/* Purpose:  As MaternCor for row j of G and the first j rows of */
+/*           G, from the cached distances.                       */
+/*                                                               */
+/* 2026.10.16: Created                                           */
+/* 2026.10.17: One exp call per correlation.                     */
+/*****************************************************************/
+{
+     real      Poly[VEC_CHUNK];
+     real      *deriv, *theta;
+     size_t    i, i0, ii, k, m;
 
      theta = MatCol(CorPar, 0);
      deriv = MatCol(CorPar, 1);
 
-     /* This implementation multiplies together the 1-d         */
-     /* correlations.  It is inefficient because there is one   */
-     /* exp call for every dimension (compare with power exp).  */
-     /* Mathematically, we could have just one exp call for all */
-     /* dimensions, but I am concerned about underflow/overflow */
-     /* for deriv = 1 or 2.  The run-time penalty can be found  */
-     /* by running, say, Gaussian as a special cases of power   */
-     /* exp and Matern, and comparing.                          */
-
-     if (Active == NULL)
-          for (i = 0; i < MatNumCols(G); i++)
-               MaternCorOneDim(g[i], MatCol(G, i), n, theta[i],
-                         deriv[i], Cor);
-     else
+     for (i0 = 0; i0 < j; i0 += VEC_CHUNK)
+     {
+          m = min(VEC_CHUNK, j - i0);
+
+          VecInit(0.0, m, Cor + i0);
+          VecInit(1.0, m, Poly);
+
           for (ii = 0; ii < NumActive; ii++)
           {
-               i = Active[ii];
-               MaternCorOneDim(g[i], MatCol(G, i), n, theta[i],
-                              deriv[i], Cor);
+               k = Active[ii];
+               MaternDistInc(PairDist[k] + KrigPairOffset(i0, j), m,
+                         theta[k], deriv[k], Cor + i0, Poly);
           }
 
+          KrigExpNeg(m, Cor + i0, Cor + i0);
+          for (i = 0; i < m; i++)
+               Cor[i0 + i] *= Poly[i];
+     }
+
      return;
 }
 
-
 /*******************************+++*******************************/
-void MaternCorOneDim(real h, const real *g, size_t n, real theta,
-          real deriv, real *Cor)
+void MaternDistInc(const real *Dist, size_t n, real theta,
+          real deriv, real *WtDist, real *Poly)
 /*****************************************************************/
-/* Purpose:  Multiply the correlations Cor[0],...,Cor[n-1] by    */
-/*           the 1-d Matern correlations from the distances      */
-/*            between h and g[0],...,g[n-1].                     */
+/* Purpose:  For the 1-d Matern correlations from the distances  */
+/*           Dist[0],...,Dist[n-1], increment the weighted       */
+/*           distances WtDist[0],...,WtDist[n-1] and multiply    */
+/*           the polynomial factors Poly[0],...,Poly[n-1].  The  */
+/*           correlation over all dimensions is then             */
+/*           exp(-WtDist[i]) * Poly[i].                          */
 /*                                                               */
-/* 2009.05.08: Created                                           */
+/* Comment:  Each 1-d polynomial factor is at most exp of its    */
+/*           weighted distance, so WtDist[i] stays >= the log of */
+/*           Poly[i].  When Poly[i] exceeds POLY_MAX, its log is */
+/*           subtracted from WtDist[i] and Poly[i] is reset to 1 */
+/*           (the correlation is unchanged), so neither can      */
+/*           overflow.                                           */
+/*                                                               */
+/* 2026.10.17: Created from MaternCorOneDim                      */
 /*****************************************************************/
 {
-     real      wtDist;
+     real      w;
      size_t    i;
 
      if (theta == 0.0)
@@ -235,38 +304,87 @@ void MaternCorOneDim(real h, const real *g, size_t n, real theta,
 
      if (deriv == 0.0)
           /* Exponential correlation function. */
+          for (i = 0; i < n; i++)
+               WtDist[i] += theta * Dist[i];
+
+     else if (deriv == 1.0 || deriv == 2.0)
           for (i = 0; i < n; i++)
           {
-               wtDist = theta * fabs(h - g[i]);
-               /* Bug in exp(x) for certain small values of x! */
-               Cor[i] *= ((wtDist < EPSILON) ? 1.0 : exp(-wtDist));
+               w = theta * Dist[i];
+               WtDist[i] += w;
+               w = min(w, WT_DIST_MAX);
+               Poly[i] *= (deriv == 1.0) ? w + 1.0
+                         : w * w / 3 + w + 1.0;
+               if (Poly[i] > POLY_MAX)
+               {
+                    WtDist[i] -= log(Poly[i]);
+                    Poly[i] = 1.0;
+               }
           }
-     
+
+     else if (deriv == 3.0)
+          /* Gaussian correlation function. */
+          for (i = 0; i < n; i++)
+               /* Weighted squared distance. */
+               WtDist[i] += Dist[i] * (theta * Dist[i]);
+
+     else
+          CodeBug("Illegal deriv in MaternDistInc.\n");
+
+     return;
+}
+
+/*******************************+++*******************************/
+void MaternGradInc(size_t n, const real *Dist, real theta,
+          real deriv, const real *A, real *Grad)
+/*****************************************************************/
+/* Purpose:  Increment Grad[0] by the derivative with respect to */
+/*           theta of A[0] * log(r[0]) + ... +                   */
+/*           A[n-1] * log(r[n-1]), where r[i] is the 1-d Matern  */
+/*           correlation for the distance Dist[i].               */
+/*                                                               */
+/* Comment:  With w = theta * d, the derivative of log(r) is     */
+/*           -d, -d * w / (1 + w), and                           */
+/*           -d * w * (1 + w) / (3 + 3 * w + w * w) for deriv =  */
+/*           0, 1, and 2, and -d * d for the Gaussian (deriv =   */
+/*           3).  deriv is discrete, so Grad[1] is unchanged.    */
+/*                                                               */
+/* 2026.10.17: Created                                           */
+/*****************************************************************/
+{
+     real      d, Sum, w;
+     size_t    i;
+
+     Sum = 0.0;
+
+     if (deriv == 0.0)
+          for (i = 0; i < n; i++)
+               Sum += A[i] * Dist[i];
+
      else if (deriv == 1.0)
           for (i = 0; i < n; i++)
           {
-               wtDist = theta * fabs(h - g[i]);
-               Cor[i] *= ((wtDist < EPSILON) ? 1.0 : exp(-wtDist)) * (wtDist + 1.0);
+               d = Dist[i];
+               w = theta * d;
+               Sum += A[i] * d * w / (1.0 + w);
           }
 
      else if (deriv == 2.0)
           for (i = 0; i < n; i++)
           {
-               wtDist = theta * fabs(h - g[i]);
-               Cor[i] *= ((wtDist < EPSILON) ? 1.0 : exp(-wtDist)) * (wtDist * wtDist / 3 + wtDist + 1.0);
+               d = Dist[i];
+               w = theta * d;
+               Sum += A[i] * d * w * (1.0 + w) / (3.0 + w * (3.0 + w));
           }
 
      else if (deriv == 3.0)
-          /* Gaussian correlation function. */
           for (i = 0; i < n; i++)
-          {
-               wtDist = fabs(h - g[i]);
-               wtDist *= theta * wtDist; /* weighted squared distance */
-               Cor[i] *= ((wtDist < EPSILON) ? 1.0 : exp(-wtDist));
-          }
-     
+               Sum += A[i] * Dist[i] * Dist[i];
+
      else
-          CodeBug("Illegal deriv in MaternCorOneDim.\n");
+          CodeBug("Illegal deriv in MaternGradInc.\n");
+
+     Grad[0] -= Sum;
 
      return;
 }
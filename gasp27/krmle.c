@@ -21,8 +21,9 @@
 
 extern real    SPVarPropMax;
 extern real    SPVarPropMin;
+extern size_t  MinAlgNum;
 
-extern int     ErrorSeverityLevel;
+extern THREAD_LOCAL int ErrorSeverityLevel;
 extern size_t  nPointers;
 
 /* These parameters are used by the continuous-space optimizer. */
@@ -31,20 +32,41 @@ extern size_t  nPointers;
 #define RELTOL      1.0e-10      /* Set small so won't be used. */
 #define MAXFUNCS    100
 
-/* These variables are external for communication with the */
-/* objective functions, MLELikeObj and MLELikeUpdate, and  */
-/* MLELikeScale.                                           */
-static KrigingModel *ExtKrigMod;
-static Matrix       CPartial;
-static size_t       TermIndex;
-
-/* External to avoid repeated allocations in MLEOneTerm. */
-static Matrix  RegSub;
-static size_t  *Active = NULL;
-static real    *CorParRow = NULL;
-
-/* Communicates with MLELike (likelihood calculation). */
-static int     OptErr;
+/* The state of one fit, set up by MLEFit.  It communicates */
+/* with the objective functions, MLELikeObj, MLELikeUpdate,  */
+/* and MLELikeScale, which the optimizer calls with x only.  */
+typedef struct
+{
+     KrigingModel *KrigMod;
+     Matrix       CPartial;
+     size_t       TermIndex;
+
+     /* Allocated once per fit to avoid repeated */
+     /* allocations in MLEOneTerm.               */
+     Matrix       RegSub;
+     size_t       *Active;
+     real         *CorParRow;
+
+     /* Communicates with MLELike (likelihood calculation). */
+     int          OptErr;
+
+     /* Work space for the gradients from MLELikeGrad */
+     /* (LBFGSALG).                                    */
+     Matrix       CorMat;     /* Copy of the correlation matrix. */
+     Matrix       A;          /* Weights for KrigCorGrad.        */
+     real         *u;         /* Inverse(C) * GLS residuals.     */
+
+     /* Spectral form of CPartial for MLELikeScale: if Spectral, */
+     /* CPartial = V Diag(EigVal) V' and FY holds V'[F Y].       */
+     boolean      Spectral;
+     real         *EigVal;
+     Matrix       EigVec;     /* Work space for MatEigProject.   */
+     Matrix       FY;
+} MLEContext;
+
+/* The fit in progress on this thread.  Fits on different */
+/* threads (e.g., the tries in FitBest) are independent.  */
+static THREAD_LOCAL MLEContext *Ctx = NULL;
 
 /*******************************+++*******************************/
 void MLEStart(KrigingModel *KrigMod, Matrix *RegCorPar)
@@ -110,7 +132,9 @@ int MLEFit
      size_t       Try,
      real         *NegLogLike,/* Output: -log(likelihood).       */
      real         *CondNum,   /* Output: condition number.       */
-     unsigned     *TotFuncs   /* Output: likelihood evaluations. */
+     unsigned     *TotFuncs,  /* Output: likelihood evaluations. */
+     size_t       *Iter       /* Output: iteration count shown   */
+                              /* by FitBest.                     */
 )
 /*****************************************************************/
 /* Purpose:    Fit regression and correlation parameters.        */
@@ -126,18 +150,43 @@ int MLEFit
 /* 2009.05.14: CorParTest replaces PETest (multiple correlation  */
 /*             families)                                         */
 /* 2011.08.01: SPVarProp not optimized if support is FIXED       */
+/* 2026.10.16: CPartial has MAT_DENSE storage.                   */
+/* 2026.10.17: State of the fit in an MLEContext, so fits on     */
+/*             different threads are independent; the final      */
+/*             progress line is output by FitBest.               */
+/* 2026.10.17: L-BFGS with analytic gradients for all the        */
+/*             parameters together if MinAlgNum is MIN_ALG_LBFGS */
+/*             (and there are no transformations); Powell is     */
+/*             kept for the one-term optimizations.              */
+/* 2026.10.17: SPVarProp optimized via one eigen decomposition   */
+/*             of CPartial if there are no transformations.      */
+/* 2026.10.17: EigVec and FY have MAT_DENSE storage.             */
 /*****************************************************************/
 {
+     MLEContext Fit, *CtxSave;
+     boolean   SPSpectral;
+     int       MinAlg;
      real      AbsTol, CondChol, CondR, SPVarPropSave;
      real      NullNegLogLike, OldNegLogLike;
      real      *CorParVec;
      Matrix    RegSPVarProp;
-     Matrix    *Chol, *CorPar, *G;
-     size_t    i, Iter, j, kSP, nParsOneTerm, nPars;
+     Matrix    *Chol, *CorPar, *G, *T;
+     size_t    i, j, kSP, nParsOneTerm, nPars;
      size_t    *Perm, *SupportSave;
 
-     /* Copy to external. */
-     ExtKrigMod = KrigMod;
+     /* This fit's context for the objective functions. */
+     CtxSave = Ctx;
+     Ctx = &Fit;
+     Fit.KrigMod  = KrigMod;
+     Fit.Active   = NULL;
+     Fit.Spectral = NO;
+
+     /* The gradients are for the correlation matrix itself, */
+     /* not T'CT.                                            */
+     T = KrigT(KrigMod);
+     MinAlg = (MinAlgNum == MIN_ALG_LBFGS &&
+               (T == NULL || MatNumCols(T) == 0)) ?
+               LBFGSALG : POWELLALG;
 
      Chol   = KrigChol(KrigMod);
      CorPar = KrigCorPar(KrigMod);
@@ -149,20 +198,44 @@ int MLEFit
      /* Allocations. */
      nParsOneTerm = MatNumCols(CorPar);
      RegAlloc(1, &RegSPVarProp);
-     RegAlloc(nParsOneTerm, &RegSub);
-     MatAlloc(MatNumRows(Chol), MatNumCols(Chol), UP_TRIANG,
-               &CPartial);
+     RegAlloc(nParsOneTerm, &Fit.RegSub);
+     MatAllocDense(MatNumRows(Chol), MatNumCols(Chol), UP_TRIANG,
+               &Fit.CPartial);
      if (kSP > 1)
-          Active = AllocSize_t(kSP - 1, NULL);
-     CorParRow   = AllocReal(nParsOneTerm, NULL);
+          Fit.Active = AllocSize_t(kSP - 1, NULL);
+     Fit.CorParRow = AllocReal(nParsOneTerm, NULL);
      CorParVec   = AllocReal(nPars, NULL);
      Perm        = AllocSize_t(kSP, NULL);
      SupportSave = AllocSize_t(nPars, NULL);
+     if (MinAlg == LBFGSALG)
+     {
+          MatAllocDense(MatNumRows(Chol), MatNumCols(Chol), UP_TRIANG,
+                    &Fit.CorMat);
+          MatAllocDense(MatNumRows(Chol), MatNumCols(Chol), UP_TRIANG,
+                    &Fit.A);
+          Fit.u = AllocReal(MatNumRows(Chol), NULL);
+     }
 
      /* Region for optimizing SPVarProp. */
      MatCopySub(1, MatNumCols(RegCorPar), nPars - 1, 0, RegCorPar,
                0, 0, &RegSPVarProp);
 
+     /* C(SPVarProp) = SPVarProp * C + (1 - SPVarProp) * I has the */
+     /* eigenvectors of C, so given V'F and V'Y, MLELikeScale     */
+     /* needs only a QR of an n x k matrix per evaluation.  This   */
+     /* needs C itself, not T'CT.                                  */
+     SPSpectral = (KrigRanErr(KrigMod) &&
+               RegSupport(&RegSPVarProp, 0) != FIXED &&
+               (T == NULL || MatNumCols(T) == 0));
+     if (SPSpectral)
+     {
+          Fit.EigVal = AllocReal(MatNumRows(Chol), NULL);
+          MatAllocDense(MatNumRows(Chol), MatNumCols(Chol), RECT,
+                    &Fit.EigVec);
+          MatAllocDense(MatNumRows(Chol), MatNumCols(KrigF(KrigMod)) + 1,
+                    RECT, &Fit.FY);
+     }
+
      ErrorSeverityLevel = SEV_WARNING;
 
      /* Get starting likelihood. */
@@ -171,13 +244,13 @@ int MLEFit
      *TotFuncs = 1;
 
      /* Do until converged. */
-     Iter = 1;
+     *Iter = 1;
      AbsTol = (kSP > 1 || KrigRanErr(KrigMod)) ? 1.0 : LogLikeTol;
      do
      {
           OutputTemp("%20s%5d%11d%16g", KrigYName(KrigMod), Try,
-                    Iter, -(*NegLogLike));
-          Iter++;
+                    *Iter, -(*NegLogLike));
+          (*Iter)++;
 
           OldNegLogLike = *NegLogLike;
 
@@ -189,15 +262,16 @@ int MLEFit
 
           for (i = 0; i < kSP; i++)
           {
-               TermIndex = Perm[i];
+               Fit.TermIndex = Perm[i];
 
                /* Optimize correlation parameters */
                /* for term TermIndex.             */
                *TotFuncs += MLEOneTerm(AbsTol, RegCorPar,
                          NegLogLike);
 
-               *TotFuncs += CorParTest(KrigCorFam(KrigMod), RegCorPar, TermIndex,
-                         AbsTol, CritLogLikeDiff, CorPar, NegLogLike);
+               *TotFuncs += CorParTest(KrigCorFam(KrigMod), RegCorPar,
+                         Fit.TermIndex, AbsTol, CritLogLikeDiff, CorPar,
+                         NegLogLike);
           }
 
           if (KrigRanErr(KrigMod) && RegSupport(&RegSPVarProp, 0) != FIXED)
@@ -210,7 +284,7 @@ int MLEFit
 
                /* Then copy Chol to CPartial. */
                /* Change using KrigCorMatC. */
-               MatCopy(Chol, &CPartial);
+               MatCopy(Chol, &Fit.CPartial);
 
                /* BUG?  Why start with no error variance??? */
                /* What if SPVarProp in some [a, b] ???      */
@@ -219,10 +293,28 @@ int MLEFit
                NullNegLogLike = MLELike();
                *TotFuncs += 1;
 
+               if (SPSpectral)
+               {
+                    /* Upper triangle of CPartial to EigVec, and */
+                    /* [F Y] to FY, for MatEigProject.           */
+                    for (j = 0; j < MatNumCols(Chol); j++)
+                         VecCopy(MatCol(&Fit.CPartial, j), j + 1,
+                                   MatCol(&Fit.EigVec, j));
+                    for (j = 0; j < MatNumCols(KrigF(KrigMod)); j++)
+                         VecCopy(MatCol(KrigF(KrigMod), j),
+                                   MatNumRows(Chol), MatCol(&Fit.FY, j));
+                    VecCopy(KrigMod->Y, MatNumRows(Chol),
+                              MatCol(&Fit.FY, j));
+
+                    Fit.Spectral = (MatEigProject(&Fit.EigVec,
+                              Fit.EigVal, &Fit.FY) == OK);
+               }
+
                /* Optimize SPVarProp. */
                *TotFuncs += MinAnyX(MLELikeScale, AbsTol, RELTOL,
                          MAXFUNCS, &RegSPVarProp, 1, POWELLALG,
                          &KrigMod->SPVarProp, NegLogLike);
+               Fit.Spectral = NO;
 
                if (NullNegLogLike - *NegLogLike < CritLogLikeDiff)
                {
@@ -249,9 +341,14 @@ int MLEFit
                          RegPutSupport(RegCorPar, i, FIXED);
                }
 
-               *TotFuncs += MinAnyX(MLELikeObj, AbsTol, RELTOL,
-                         MAXFUNCS, RegCorPar, nPars, POWELLALG,
-                         CorParVec, NegLogLike);
+               if (MinAlg == LBFGSALG)
+                    *TotFuncs += MinAnyXGrad(MLELikeObjGrad, AbsTol,
+                              RELTOL, MAXFUNCS, RegCorPar, nPars,
+                              CorParVec, NegLogLike);
+               else
+                    *TotFuncs += MinAnyX(MLELikeObj, AbsTol, RELTOL,
+                              MAXFUNCS, RegCorPar, nPars, POWELLALG,
+                              CorParVec, NegLogLike);
 
                MatUnStack(CorParVec, NO, CorPar);
                KrigMod->SPVarProp = CorParVec[nPars-1];
@@ -265,15 +362,13 @@ int MLEFit
      } while (AbsTol >= LogLikeTol && (kSP > 1 || KrigRanErr(KrigMod)));
 
      OutputTemp("");
-     Output("%20s%5d%11d%16g\n", KrigYName(KrigMod), Try,
-                    Iter, -(*NegLogLike));
 
      /* Make sure working arrays correspond to optimum,  */
      /* then compute betas, etc.                         */
      ErrorSeverityLevel = SEV_ERROR;
      KrigCorMat(0, NULL, KrigMod);
      *NegLogLike = MLELike();
-     if (OptErr != OK)
+     if (Fit.OptErr != OK)
      {
           Error(NUMERIC_ERR_TXT);
           for (j = 0; j < MatNumCols(CorPar); j++)
@@ -289,17 +384,30 @@ int MLEFit
      *CondNum = max(CondChol, CondR);
 
      MatFree(&RegSPVarProp);
-     MatFree(&RegSub);
-     MatFree(&CPartial);
+     MatFree(&Fit.RegSub);
+     MatFree(&Fit.CPartial);
+     if (MinAlg == LBFGSALG)
+     {
+          MatFree(&Fit.CorMat);
+          MatFree(&Fit.A);
+          AllocFree(Fit.u);
+     }
+     if (SPSpectral)
+     {
+          AllocFree(Fit.EigVal);
+          MatFree(&Fit.EigVec);
+          MatFree(&Fit.FY);
+     }
 
-     if (kSP > 1)
-          AllocFree(Active);
-     AllocFree(CorParRow);
+     AllocFree(Fit.Active);
+     AllocFree(Fit.CorParRow);
      AllocFree(CorParVec);
      AllocFree(Perm);
      AllocFree(SupportSave);
 
-     return OptErr;
+     Ctx = CtxSave;
+
+     return Fit.OptErr;
 }
 
 /*******************************+++*******************************/
@@ -314,24 +422,34 @@ unsigned MLEOneTerm
 )
 /*****************************************************************/
 /*   Purpose:  Optimize correlation parameters for term          */
-/*             TermIndex (external), other parameters remaining  */
-/*             fixed.                                            */
+/*             TermIndex (in the context of the fit), other      */
+/*             parameters remaining fixed.                       */
 /*                                                               */
 /*   Returns:  Number of function evaluations.                   */
 /*                                                               */
 /*   96.05.27: Active, CorParRow, and RegSub not allocated here. */
+/*   2026.10.17: State from the MLEContext of the fit.           */
 /*                                                               */
-/*   Version:  1996.05.27                                        */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
-     Matrix    *CorPar;
+     KrigingModel *KrigMod;
+     Matrix    *CorPar, *RegSub;
      real      SPVarPropSave;
-     size_t    j, kSP, nParsOneTerm;
+     real      *CorParRow;
+     size_t    j, kSP, nParsOneTerm, TermIndex;
+     size_t    *Active;
      unsigned  NumFuncs;
 
-     CorPar = KrigCorPar(ExtKrigMod);
+     KrigMod   = Ctx->KrigMod;
+     RegSub    = &Ctx->RegSub;
+     Active    = Ctx->Active;
+     CorParRow = Ctx->CorParRow;
+     TermIndex = Ctx->TermIndex;
+
+     CorPar = KrigCorPar(KrigMod);
 
-     kSP            = MatNumCols(KrigG(ExtKrigMod));
+     kSP            = MatNumCols(KrigG(KrigMod));
      nParsOneTerm = MatNumCols(CorPar);
 
      /* Load row TermIndex of CorPar into row vector CorParRow. */
@@ -340,10 +458,10 @@ unsigned MLEOneTerm
      /* Load corresponding regions into RegSub. */
      MatCopySub(nParsOneTerm, MatNumCols(RegCorPar),
                 nParsOneTerm * TermIndex, 0, RegCorPar, 0, 0,
-                &RegSub);
+                RegSub);
 
      for(j = 0; j < nParsOneTerm; j++)
-          if (RegSupport(&RegSub, j) != FIXED)
+          if (RegSupport(RegSub, j) != FIXED)
                break;
      if (j == nParsOneTerm)
            /* All parameters are fixed. */
@@ -360,16 +478,16 @@ unsigned MLEOneTerm
 
                /* Scaling will be applied to the correlations */
                /* for TermIndex.                              */
-               SPVarPropSave = ExtKrigMod->SPVarProp;
-               ExtKrigMod->SPVarProp = 1.0;
-               KrigCorMat(kSP - 1, Active, ExtKrigMod);
-               ExtKrigMod->SPVarProp = SPVarPropSave;
-               MatCopy(KrigChol(ExtKrigMod), &CPartial);
+               SPVarPropSave = KrigMod->SPVarProp;
+               KrigMod->SPVarProp = 1.0;
+               KrigCorMat(kSP - 1, Active, KrigMod);
+               KrigMod->SPVarProp = SPVarPropSave;
+               MatCopy(KrigChol(KrigMod), &Ctx->CPartial);
           }
 
           /* Optimize parameters for term TermIndex. */
           NumFuncs = MinAnyX(MLELikeUpdate, AbsTol, RELTOL, MAXFUNCS,
-                    &RegSub, nParsOneTerm, POWELLALG, CorParRow,
+                    RegSub, nParsOneTerm, POWELLALG, CorParRow,
                     NegLogLike);
 
           /* Load CorParRow back into row TermIndex of CorPar. */
@@ -389,32 +507,35 @@ real MLELike()
 /*   Returns:  -log(likelihood)                                  */
 /*                                                               */
 /*   Comment   Correct correlation matrix must be already loaded */
-/*             into ExtKrigMod->Chol.                            */
+/*             into the Chol of the fit's kriging model.         */
 /*                                                               */
 /*   Version:  1995 February 14                                  */
 /*****************************************************************/
 {
+     KrigingModel *KrigMod;
      int       d2;
      real      d1, NegLogLike;
      size_t    n;
 
+     KrigMod = Ctx->KrigMod;
+
      /* Get basic decompositions. */
-     if ( (OptErr = KrigDecompose(ExtKrigMod)) != OK)
+     if ( (Ctx->OptErr = KrigDecompose(KrigMod)) != OK)
           /* Have to be careful not to overflow. */
           return sqrt(REAL_MAX);
 
      /* Chol does not have zeros on diagonal, so d1 > 0.0. */
-     TriDet(KrigChol(ExtKrigMod), &d1, &d2);
-     n = MatNumRows(KrigChol(ExtKrigMod));
-     ExtKrigMod->SigmaSq = VecSS(ExtKrigMod->ResTilde, n) / n;
+     TriDet(KrigChol(KrigMod), &d1, &d2);
+     n = MatNumRows(KrigChol(KrigMod));
+     KrigMod->SigmaSq = VecSS(KrigMod->ResTilde, n) / n;
      NegLogLike = log(d1) + d2 * log(10.0)
-               + 0.5 * n * log(ExtKrigMod->SigmaSq);
+               + 0.5 * n * log(KrigMod->SigmaSq);
 
      /* Put in all constants - especially n. */
 
      /*
      Output("d1 = %g  d2 = %d  SigmaSq = %g  LogLike = %g\n",
-          d1, d2, ExtKrigMod->SigmaSq, -NegLogLike);
+          d1, d2, KrigMod->SigmaSq, -NegLogLike);
      */
 
      return NegLogLike;
@@ -438,20 +559,22 @@ real MLELikeUpdate
 /*   Version:  1994 September 26                                 */
 /*****************************************************************/
 {
+     KrigingModel *KrigMod;
      Matrix    *Chol, *CorPar;
      real      *Cj, *Cholj;
      size_t    i, j;
 
-     Chol   = KrigChol(ExtKrigMod);
-     CorPar = KrigCorPar(ExtKrigMod);
+     KrigMod = Ctx->KrigMod;
+     Chol    = KrigChol(KrigMod);
+     CorPar  = KrigCorPar(KrigMod);
 
      /* Load row vector CorParRow into row TermIndex of CorPar */
      for (j = 0; j < nPars; j++)
-          MatPutElem(CorPar, TermIndex, j, CorParRow[j]);
+          MatPutElem(CorPar, Ctx->TermIndex, j, CorParRow[j]);
 
      /* Put the correlation matrix for the single term */
      /* (scaled for SPVarProp) in Chol.                */
-     KrigCorMat(1, &TermIndex, ExtKrigMod);
+     KrigCorMat(1, &Ctx->TermIndex, KrigMod);
 
      if (MatNumRows(CorPar) > 1)
           /* Overwrite Chol with the correlation matrix for */
@@ -459,7 +582,7 @@ real MLELikeUpdate
           for (j = 1; j < MatNumCols(Chol); j++)
           {
                Cholj = MatCol(Chol, j);
-               Cj    = MatCol(&CPartial, j);
+               Cj    = MatCol(&Ctx->CPartial, j);
                for (i = 0; i < j; i++)
                     Cholj[i] *= Cj[i];
           }
@@ -481,23 +604,135 @@ real MLELikeObj
 /*                                                               */
 /*   Returns:  -log(likelihood)                                  */
 /*                                                               */
-/*   Version:  1994 September 26                                 */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
+     return MLELikeObjGrad(CorParVec, nPars, NULL);
+}
+
+/*******************************+++*******************************/
+real MLELikeObjGrad
+(
+     real   *CorParVec,  /* Input: Correlation parameters        */
+                         /* arranged as a vector for all terms,  */
+                         /* followed by SPVarProp.               */
+     size_t nPars,       /* Number of parameters.                */
+     real   *Grad        /* Output: gradient, unless NULL.       */
+)
+/*****************************************************************/
+/*   Purpose:  As MLELikeObj, and compute the gradient with      */
+/*             respect to CorParVec.                             */
+/*                                                               */
+/*   Returns:  -log(likelihood)                                  */
+/*                                                               */
+/*   2026.10.17: Created from MLELikeObj.                        */
+/*****************************************************************/
+{
+     KrigingModel *KrigMod;
      Matrix    *CorPar;
+     real      NegLogLike;
 
-     CorPar = KrigCorPar(ExtKrigMod);
+     KrigMod = Ctx->KrigMod;
+     CorPar  = KrigCorPar(KrigMod);
 
      /* Load the vector CorParVec into the matrix CorPar. */
      MatUnStack(CorParVec, NO, CorPar);
 
      /* CorParVec[nPars-1] is the variance proportion. */
-     ExtKrigMod->SPVarProp = CorParVec[nPars-1];
+     KrigMod->SPVarProp = CorParVec[nPars-1];
 
      /* Correlation matrix for all terms. */
-     KrigCorMat(0, NULL, ExtKrigMod);
+     KrigCorMat(0, NULL, KrigMod);
 
-     return MLELike();
+     if (Grad == NULL)
+          return MLELike();
+
+     MatCopy(KrigChol(KrigMod), &Ctx->CorMat);
+     NegLogLike = MLELike();
+     MLELikeGrad(Grad, &Grad[nPars-1]);
+
+     return NegLogLike;
+}
+
+/*******************************+++*******************************/
+void MLELikeGrad
+(
+     real   *Grad,           /* Output: derivatives with respect */
+                             /* to the correlation parameters    */
+                             /* (CorPar by rows).                */
+     real   *SPVarPropGrad   /* Output: derivative with respect  */
+                             /* to SPVarProp.                    */
+)
+/*****************************************************************/
+/*   Purpose:  Compute the gradient of -log(likelihood) after    */
+/*             MLELike.                                          */
+/*                                                               */
+/*   Comment:  The correlation matrix C must be in CorMat of the */
+/*             fit, and its Cholesky factor in Chol.  With       */
+/*             u = Inverse(C) * (GLS residuals), the derivative  */
+/*             of 1/2 [log det (C) + n log sigma hat squared]    */
+/*             with respect to a parameter of C is               */
+/*             1/2 trace(W * dC), where                          */
+/*             W = Inverse(C) - u * u' / (sigma hat squared)     */
+/*             (the derivative through the GLS betas is zero).   */
+/*             C has unit diagonal, so this is the sum over      */
+/*             i < j of W[i, j] * dC[i, j], and as               */
+/*             C[i, j] = SPVarProp * R[i, j], KrigCorGrad gets   */
+/*             A[i, j] = W[i, j] * C[i, j] to weight the         */
+/*             derivatives of log(R[i, j]).  Inverse(C) costs    */
+/*             about twice the Cholesky decomposition.           */
+/*             The gradient is zero if MLELike failed.           */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     KrigingModel *KrigMod;
+     Matrix    *A, *C, *Chol;
+     real      SigmaSq, SumA, uj;
+     real      *Aj, *Cj, *u;
+     size_t    i, j, n, nGrad, nTerms;
+
+     KrigMod = Ctx->KrigMod;
+     Chol    = KrigChol(KrigMod);
+     A       = &Ctx->A;
+     C       = &Ctx->CorMat;
+     u       = Ctx->u;
+     n       = MatNumRows(Chol);
+     SigmaSq = KrigMod->SigmaSq;
+
+     nTerms = MatNumCols(KrigG(KrigMod));
+     nGrad  = nTerms * MatNumCols(KrigCorPar(KrigMod));
+
+     if (Ctx->OptErr != OK || !(SigmaSq > 0.0) ||
+               TriCholInverse(Chol, A) != OK)
+     {
+          VecInit(0.0, nGrad, Grad);
+          *SPVarPropGrad = 0.0;
+          return;
+     }
+
+     TriBackSolve(Chol, KrigMod->ResTilde, u);
+
+     SumA = 0.0;
+     for (j = 1; j < n; j++)
+     {
+          Aj = MatCol(A, j);
+          Cj = MatCol(C, j);
+          uj = u[j] / SigmaSq;
+          for (i = 0; i < j; i++)
+          {
+               Aj[i] = (Aj[i] - u[i] * uj) * Cj[i];
+               SumA += Aj[i];
+          }
+     }
+
+     /* dC[i, j] = R[i, j] = C[i, j] / SPVarProp. */
+     *SPVarPropGrad = (KrigMod->SPVarProp > 0.0) ?
+               SumA / KrigMod->SPVarProp : 0.0;
+
+     KrigCorGrad(0, NULL, A, KrigMod, Grad);
+
+     return;
 }
 
 /*******************************+++*******************************/
@@ -514,16 +749,71 @@ real MLELikeScale
 /*                                                               */
 /*   Returns:  -log(likelihood)                                  */
 /*                                                               */
-/*   Version:  1994 September 26                                 */
+/*   Comment:  If the fit's context is Spectral, the re-scaled   */
+/*             matrix is V Diag(mu) V', where                    */
+/*             mu = SPVarProp * EigVal + 1 - SPVarProp, and the  */
+/*             likelihood is from the GLS fit of                 */
+/*             Diag(1 / sqrt(mu)) V'Y on Diag(1 / sqrt(mu)) V'F, */
+/*             without a Cholesky decomposition.                 */
+/*                                                               */
+/*   2026.10.17: Spectral update.                                */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
-     Matrix    *Chol;
-     size_t    j;
+     KrigingModel *KrigMod;
+     Matrix    *Chol, *Q;
+     real      LogDet, mu, p;
+     real      *ResTilde;
+     size_t    i, j, k, n;
 
-     Chol = KrigChol(ExtKrigMod);
+     KrigMod = Ctx->KrigMod;
+     Chol    = KrigChol(KrigMod);
+
+     if (Ctx->Spectral)
+     {
+          Q        = KrigQ(KrigMod);
+          ResTilde = KrigMod->ResTilde;
+          n        = MatNumRows(Chol);
+          k        = MatNumCols(Q);
+          p        = min(*SPVarProp, 1.0);
+
+          /* Put 1 / sqrt(mu) in ResTilde for now. */
+          for (LogDet = 0.0, i = 0; i < n; i++)
+          {
+               mu = p * Ctx->EigVal[i] + 1.0 - p;
+               if (mu <= 0.0)
+               {
+                    Ctx->OptErr = NUMERIC_ERR;
+                    return sqrt(REAL_MAX);
+               }
+               LogDet += log(mu);
+               ResTilde[i] = 1.0 / sqrt(mu);
+          }
+
+          /* FTilde in Q, then YTilde in ResTilde. */
+          for (j = 0; j < k; j++)
+          {
+               VecCopy(MatCol(&Ctx->FY, j), n, MatCol(Q, j));
+               VecMultVec(ResTilde, n, MatCol(Q, j));
+          }
+          VecMultVec(MatCol(&Ctx->FY, k), n, ResTilde);
+
+          if (QRLS(Q, ResTilde, Q, KrigR(KrigMod), KrigMod->RBeta,
+                    ResTilde) != OK)
+          {
+               Ctx->OptErr = NUMERIC_ERR;
+               return sqrt(REAL_MAX);
+          }
+
+          Ctx->OptErr = OK;
+          KrigMod->SigmaSq = VecSS(ResTilde, n) / n;
+
+          return 0.5 * LogDet + 0.5 * n * log(KrigMod->SigmaSq);
+     }
 
      /* Copy the unscaled correlation matrix CPartial to Chol. */
-     MatCopy(&CPartial, Chol);
+     MatCopy(&Ctx->CPartial, Chol);
 
      /* Re-scale Chol. */
      if (*SPVarProp < 1.0)
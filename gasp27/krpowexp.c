@@ -199,18 +199,16 @@ void PECor(
 /*   Purpose:  Compute correlations between the point g and the  */
 /*             points in the first n rows of G.                  */
 /*                                                               */
-/*   Version:  1994 February 2                                   */
+/*   2026.10.16: Exponentials via KrigExpNeg.                    */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
 /*****************************************************************/
 {
-     size_t    i;
-
      /* Put the distances in Cor. */
      PEDist(g, G, n, NumActive, Active, CorPar, Cor);
 
      /* Exponentiate the sum. */
-     for (i = 0; i < n; i++)
-          /* Bug in exp(x) for certain small values of x! */
-          Cor[i] = (Cor[i] < EPSILON) ? 1.0 : exp(-Cor[i]);
+     KrigExpNeg(n, Cor, Cor);
 
      return;
 }
@@ -264,11 +262,14 @@ void PEDistInc(real h, const real *g, size_t n, real Theta,
 /*   Purpose:  Increment the distances Dist[0],...,Dist[n-1] for */
 /*             the distances between h and g[0],...,g[n-1].      */
 /*                                                               */
-/*   Version:  1994 February 2                                   */
+/*   2026.10.16: Powers via VecPow, a chunk at a time.           */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
 /*****************************************************************/
 {
      real      diff;
-     size_t    i;
+     real      w[VEC_CHUNK];
+     size_t    i, i0, m;
 
      if (Theta == 0.0)
           return;
@@ -296,8 +297,146 @@ void PEDistInc(real h, const real *g, size_t n, real Theta,
                Dist[i] += fabs(h - g[i]);
 
      else
-          for (i = 0; i < n; i++)
-               Dist[i] += Theta * pow(fabs(h - g[i]), 2.0 - Alpha);
+          for (i0 = 0; i0 < n; i0 += VEC_CHUNK)
+          {
+               m = min(VEC_CHUNK, n - i0);
+               for (i = 0; i < m; i++)
+                    w[i] = fabs(h - g[i0 + i]);
+               VecPow(m, w, 2.0 - Alpha, w);
+               for (i = 0; i < m; i++)
+                    Dist[i0 + i] += Theta * w[i];
+          }
+
+     return;
+}
+
+/*******************************+++*******************************/
+void PECorPair(
+     size_t       j,         /* Row j of G.                      */
+     size_t       NumActive, /* Number of active terms.          */
+     const size_t *Active,   /* Indices of the active terms.     */
+     const Matrix *CorPar,   /* Correlation parameters.          */
+     real * const *PairDist, /* Cached distances and their logs  */
+     real * const *PairLogDist,  /* (KrigingModel).              */
+     real         *Cor       /* Output: correlations.            */
+)
+/*****************************************************************/
+/*   Purpose:  As PECor for row j of G and the first j rows of   */
+/*             G, from the cached distances.                     */
+/*                                                               */
+/*   Comment:  The weighted distances are summed over the terms  */
+/*             as in PEDistInc, but for Alpha other than 0 or 1  */
+/*             |d| ** (2 - Alpha) is exp((2 - Alpha) * log|d|),  */
+/*             which agrees with pow to rounding error.          */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     real      p, Theta;
+     real      *Alpha, *d, *LogD;
+     real      w[VEC_CHUNK];
+     size_t    i, i0, ii, k, m;
+
+     Alpha = MatCol(CorPar, 1);
+
+     VecInit(0.0, j, Cor);
+
+     for (ii = 0; ii < NumActive; ii++)
+     {
+          k     = Active[ii];
+          Theta = MatElem(CorPar, k, 0);
+          d     = PairDist[k] + KrigPairOffset(0, j);
+
+          if (Theta == 0.0)
+               continue;
+
+          if (Alpha[k] == 0.0)
+               for (i = 0; i < j; i++)
+                    Cor[i] += Theta * d[i] * d[i];
+
+          else if (Alpha[k] == 1.0)
+               for (i = 0; i < j; i++)
+                    Cor[i] += Theta * d[i];
+
+          else
+          {
+               p    = 2.0 - Alpha[k];
+               LogD = PairLogDist[k] + KrigPairOffset(0, j);
+               for (i0 = 0; i0 < j; i0 += VEC_CHUNK)
+               {
+                    m = min(VEC_CHUNK, j - i0);
+                    for (i = 0; i < m; i++)
+                         w[i] = p * LogD[i0 + i];
+                    VecExp(m, w, w);
+                    for (i = 0; i < m; i++)
+                         Cor[i0 + i] += Theta * w[i];
+               }
+          }
+     }
+
+     /* Exponentiate the sum. */
+     KrigExpNeg(j, Cor, Cor);
+
+     return;
+}
+
+/*******************************+++*******************************/
+void PEGradInc(size_t n, const real *Dist, const real *LogDist,
+          real Theta, real Alpha, const real *A, real *Grad)
+/*****************************************************************/
+/*   Purpose:  Increment Grad[0] and Grad[1] by the derivatives  */
+/*             with respect to Theta and Alpha of                */
+/*             -Theta * (A[0] * |Dist[0]| ** (2 - Alpha) + ... + */
+/*             A[n-1] * |Dist[n-1]| ** (2 - Alpha)),             */
+/*             i.e., of the sum of A[i] times the log of the     */
+/*             term's correlation.                               */
+/*                                                               */
+/*   Comment:  LogDist[i] is log|Dist[i]|, or -REAL_MAX if       */
+/*             Dist[i] is zero (see KrigPairDistSetUp).  The     */
+/*             derivative with respect to Alpha is               */
+/*             Theta * |d| ** (2 - Alpha) * log|d|.              */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      p, SumW, SumWLog;
+     real      w[VEC_CHUNK];
+     size_t    i, i0, m;
+
+     p = 2.0 - Alpha;
+
+     SumW = SumWLog = 0.0;
+     for (i0 = 0; i0 < n; i0 += VEC_CHUNK)
+     {
+          m = min(VEC_CHUNK, n - i0);
+
+          if (Alpha == 0.0)
+               for (i = 0; i < m; i++)
+                    w[i] = Dist[i0 + i] * Dist[i0 + i];
+          else if (Alpha == 1.0)
+               for (i = 0; i < m; i++)
+                    w[i] = Dist[i0 + i];
+          else
+          {
+               for (i = 0; i < m; i++)
+                    w[i] = p * LogDist[i0 + i];
+               VecExp(m, w, w);
+          }
+
+          for (i = 0; i < m; i++)
+          {
+               w[i] *= A[i0 + i];
+               SumW    += w[i];
+               SumWLog += w[i] * LogDist[i0 + i];
+          }
+     }
+
+     Grad[0] -= SumW;
+     Grad[1] += Theta * SumWLog;
 
      return;
 }
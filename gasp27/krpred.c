@@ -112,57 +112,118 @@ int KrigPredSE(KrigingModel *KrigMod, const Matrix *XPred,
 /*                                                               */
 /* Comment:    Calling routine must allocate space for YHat and  */
 /*             SE.                                               */
+/*             The points are processed in tiles of up to        */
+/*             KRIG_PRED_BLOCK cases: the f's and r's of a tile  */
+/*             are the columns of FTilde and RTilde, which are   */
+/*             overwritten by KrigTildeMat, and Q' * RTilde is   */
+/*             computed by MatTMult.  The results are as from    */
+/*             KrigYHatSE a point at a time.                     */
 /*                                                               */
 /* 1996.04.03: Cases in XPred with NA's generate NA for YHat.    */
 /* 1996.02.18: Argument RAve in KrigYHatSE is passed             */
 /*             KrigMod->SPVarProp instead of 1.0 to predict      */
 /*             f(x) beta + Z *without* epsilon.                  */
 /* 2009.05.13: KrigCorVec arguments changed                      */
+/* 2026.10.16: Points processed in tiles.                        */
 /*****************************************************************/
 {
      int       ErrNum;
      LinModel  *RegMod, *SPMod;
-     Matrix    *G;
-     real      *fRow, *gRow, *r, *xRow;
-     size_t    i, m;
+     Matrix    FTilde, QRTilde, RTilde;
+     Matrix    *G, *Q;
+     real      MSE;
+     real      *f, *gRow, *qr, *r, *xRow;
+     size_t    *Case;
+     size_t    b, i, j, k, l, m, n, nBlock;
+
+     m = MatNumRows(XPred);
+     if (m == 0)
+          return OK;
 
      G = KrigG(KrigMod);
+     Q = KrigQ(KrigMod);
+     n = MatNumRows(Q);
+     k = MatNumCols(Q);
 
      RegMod = KrigRegMod(KrigMod);
      SPMod  = KrigSPMod(KrigMod);
 
      /* Use workspace in KrigMod. */
      xRow = KrigMod->xRow;
-     fRow = KrigMod->fRow;
      gRow = KrigMod->gRow;
-     r    = KrigMod->r;
 
-     m = MatNumRows(XPred);
+     nBlock = min(KRIG_PRED_BLOCK, m);
+     MatAllocDense(k, nBlock, RECT, &FTilde);
+     MatAllocDense(MatNumRows(G), nBlock, RECT, &RTilde);
+     MatAllocDense(k, nBlock, RECT, &QRTilde);
+     Case = AllocSize_t(nBlock, NULL);
 
-     /* For each prediction. */
+     /* For each tile of predictions. */
      ErrNum = OK;
-     for (i = 0; i < m && ErrNum == OK; i++)
+     for (i = 0; i < m && ErrNum == OK; )
      {
-          MatRow(XPred, i, xRow);
+          /* Case[b] is the row of XPred in column b of the tile. */
+          for (b = 0; b < nBlock && i < m; i++)
+          {
+               MatRow(XPred, i, xRow);
 
-          if (VecHasNA(MatNumCols(XPred), xRow))
-               YHat[i] = SE[i] = NA_REAL;
-          else
+               if (VecHasNA(MatNumCols(XPred), xRow))
+                    YHat[i] = SE[i] = NA_REAL;
+               else
+               {
+                    XToF(RegMod, xRow, MatCol(&FTilde, b));
+                    XToF(SPMod,  xRow, gRow);
+
+                    KrigCorVec(gRow, G, MatNumRows(G), 0, NULL, YES,
+                              KrigMod, MatCol(&RTilde, b));
+
+                    Case[b++] = i;
+               }
+          }
+
+          if (b == 0)
+               continue;
+
+          /* As in KrigYHatSE, r is not transformed with T, */
+          /* and only its first n elements are used.        */
+          MatPutNumCols(&FTilde, b);
+          MatPutNumCols(&RTilde, b);
+          MatPutNumCols(&QRTilde, b);
+          MatPutNumRows(&RTilde, n);
+
+          if ( (ErrNum = KrigTildeMat(KrigMod, &FTilde, &RTilde)) == OK)
           {
-               XToF(RegMod, xRow, fRow);
-               XToF(SPMod,  xRow, gRow);
+               MatTMult(Q, &RTilde, &QRTilde);
+
+               for (j = 0; j < b; j++)
+               {
+                    f  = MatCol(&FTilde, j);
+                    r  = MatCol(&RTilde, j);
+                    qr = MatCol(&QRTilde, j);
 
-               KrigCorVec(gRow, G, MatNumRows(G), 0, NULL, YES, KrigMod, r);
+                    YHat[Case[j]] = DotProd(f, KrigMod->RBeta, k)
+                              + DotProd(r, KrigMod->ResTilde, n);
 
-               /* Need to transform r with T? */
+                    for (l = 0; l < k; l++)
+                         f[l] -= qr[l];
 
-               /* Compute YHat[i] and SE[i]. */
-               ErrNum = KrigYHatSE(KrigMod, KrigMod->SPVarProp,
-                         fRow, r, &YHat[i], &SE[i]);
+                    MSE = KrigMod->SigmaSq * (KrigMod->SPVarProp
+                              - VecSS(r, n) + VecSS(f, k));
+                    SE[Case[j]] = (MSE > 0.0) ? sqrt(MSE) : 0.0;
+               }
           }
+
+          MatPutNumCols(&FTilde, nBlock);
+          MatPutNumCols(&RTilde, nBlock);
+          MatPutNumCols(&QRTilde, nBlock);
+          MatPutNumRows(&RTilde, MatNumRows(G));
      }
 
-         
+     MatFree(&FTilde);
+     MatFree(&RTilde);
+     MatFree(&QRTilde);
+     AllocFree(Case);
+
      if (ErrNum != OK)
           for (i = 0; i < m; i++)
                YHat[i] = SE[i] = NA_REAL;
@@ -252,3 +313,31 @@ int KrigTilde(const KrigingModel *KrigMod, real *f, real *r)
      return ErrNum;
 }
 
+/*******************************+++*******************************/
+int KrigTildeMat(const KrigingModel *KrigMod, Matrix *FTilde,
+          Matrix *RTilde)
+/*****************************************************************/
+/*   Purpose:  As KrigTilde, for several points: overwrite each  */
+/*             column of FTilde with fTilde and each column of   */
+/*             RTilde with rTilde.                               */
+/*                                                               */
+/*   Returns:  OK or an error number.                            */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int ErrNum;
+
+     if ( (ErrNum = TriForSolveMat(KrigR(KrigMod), FTilde, FTilde))
+               != OK)
+          Error("Ill-conditioned expanded-design matrix.\n");
+
+     else if ( (ErrNum = TriForSolveMat(KrigChol(KrigMod), RTilde,
+               RTilde)) != OK)
+          Error("Ill-conditioned correlation matrix.\n");
+
+     return ErrNum;
+}
+
@@ -0,0 +1,558 @@
+/*****************************************************************/
+/*   ROUTINES TO SAVE AND RESTORE A FITTED KRIGING MODEL         */
+/*                                                               */
+/*   A fitted-model file starts with a header of KRIG_FILE_ALIGN */
+/*   reals: the characters KRIG_FILE_MAGIC, KRIG_FILE_VERSION,   */
+/*   and KRIG_FILE_ORDER (to detect a different byte order or    */
+/*   real type).  One record per response follows:               */
+/*                                                               */
+/*        a header of KRIG_REC_HEAD reals (see KrigModWrite),    */
+/*        the response name, then CorPar, G, Chol, Q, R, RBeta,  */
+/*        Beta, and ResTilde.                                    */
+/*                                                               */
+/*   Every item is a whole number of KRIG_FILE_ALIGN reals, so   */
+/*   each starts on a MAT_ALIGN boundary if the file is mapped   */
+/*   into memory.  A matrix is stored by columns with leading    */
+/*   dimension its number of rows; the lower triangle of an      */
+/*   UP_TRIANG matrix is zero.                                   */
+/*****************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "define.h"
+#include "implem.h"
+#include "matrix.h"
+#include "lib.h"
+#include "model.h"
+#include "kriging.h"
+
+/* Reals in the record header. */
+#define KRIG_REC_HEAD   16
+
+/* Relative tolerance for matching the parameters of a record, */
+/* as Predict may have them from printed                        */
+/* StochasticProcessModel and YDescription matrices.            */
+#define KRIG_PAR_TOL    1.0e-5
+
+/* Reals needed for n reals, rounded up to KRIG_FILE_ALIGN. */
+#define KrigFileLen(n) \
+     (((n) + KRIG_FILE_ALIGN - 1) / KRIG_FILE_ALIGN * KRIG_FILE_ALIGN)
+
+static int KrigFileWriteMat(FILE *File, const Matrix *M);
+static int KrigFileReadMat(FILE *File, real *Work, Matrix *M);
+static int KrigFileWriteVec(FILE *File, size_t n, const real *v);
+static int KrigFileReadVec(FILE *File, size_t n, real *v);
+static ulong KrigHashBytes(ulong Hash, const void *p, size_t n);
+static ulong KrigTermHash(const LinModel *Mod);
+static boolean KrigParClose(real a, real b);
+
+/*******************************+++*******************************/
+FILE *KrigFileOpen(const string FileName, boolean Write)
+/*****************************************************************/
+/*   Purpose:  Open a fitted-model file for writing (the header  */
+/*             is written) or reading (the header is checked).   */
+/*                                                               */
+/*   Returns:  The file, or NULL (with an error message) if it   */
+/*             cannot be opened or is not a fitted-model file.   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     FILE      *File;
+     real      Head[KRIG_FILE_ALIGN];
+
+     if ( (File = FileOpen(FileName, (Write) ? "wb" : "rb")) == NULL)
+          return NULL;
+
+     VecInit(0.0, KRIG_FILE_ALIGN, Head);
+
+     if (Write)
+     {
+          memcpy(Head, KRIG_FILE_MAGIC, sizeof(real));
+          Head[1] = KRIG_FILE_VERSION;
+          Head[2] = KRIG_FILE_ORDER;
+
+          if (KrigFileWriteVec(File, KRIG_FILE_ALIGN, Head) == OK)
+               return File;
+
+          Error("Cannot write to file %s.\n", FileName);
+     }
+     else
+     {
+          if (KrigFileReadVec(File, KRIG_FILE_ALIGN, Head) == OK &&
+                    memcmp(Head, KRIG_FILE_MAGIC, sizeof(real)) == 0 &&
+                    Head[1] == KRIG_FILE_VERSION &&
+                    Head[2] == KRIG_FILE_ORDER)
+               return File;
+
+          Error("File %s is not a fitted-model file of version %g "
+                    "for this computer.\n", FileName,
+                    (real) KRIG_FILE_VERSION);
+     }
+
+     fclose(File);
+
+     return NULL;
+}
+
+/*******************************+++*******************************/
+ulong KrigDataHash(size_t nCases, const size_t *RowIndex,
+     const Matrix *X, const real *y)
+/*****************************************************************/
+/*   Purpose:  Return a hash of the data used by KrigModData:    */
+/*             rows RowIndex[0],..., RowIndex[nCases - 1] of X   */
+/*             and y.                                            */
+/*                                                               */
+/*   Comment:  32-bit FNV-1a hash of the bytes of the reals.     */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      v;
+     size_t    i, j;
+     ulong     Hash;
+
+     Hash = 2166136261UL;
+     for (i = 0; i < nCases; i++)
+          for (j = 0; j <= MatNumCols(X); j++)
+          {
+               v = (j < MatNumCols(X)) ? MatElem(X, RowIndex[i], j)
+                         : y[RowIndex[i]];
+               Hash = KrigHashBytes(Hash, &v, sizeof(real));
+          }
+
+     return Hash;
+}
+
+/*******************************+++*******************************/
+int KrigModWrite(FILE *File, const KrigingModel *KrigMod,
+     ulong DataHash)
+/*****************************************************************/
+/*   Purpose:  Append the record for KrigMod, which must have    */
+/*             its parameters and decompositions set up, to a    */
+/*             fitted-model file opened by KrigFileOpen.         */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*                                                               */
+/*   Comment:  The record header holds the record length (in     */
+/*             reals), DataHash (from KrigDataHash), the         */
+/*             dimensions of G, Chol, Q, and CorPar, CorFam,     */
+/*             RanErr, SigmaSq, SPVarProp, the length of the     */
+/*             name, and hashes of the terms of the regression   */
+/*             and stochastic-process models.                    */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: Hashes of the model terms; CorPar before G.     */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     const Matrix   *CorPar, *G, *Q;
+     real      Head[KRIG_REC_HEAD];
+     real      *Name;
+     size_t    k, kSP, n, nName, t;
+
+     G      = KrigG(KrigMod);
+     Q      = KrigQ(KrigMod);
+     CorPar = KrigCorPar(KrigMod);
+
+     n   = MatNumRows(G);
+     kSP = MatNumCols(G);
+     t   = MatNumRows(Q);
+     k   = MatNumCols(Q);
+
+     /* Name, including the terminating null, as reals. */
+     nName = (strlen(KrigYName(KrigMod)) + sizeof(real))
+               / sizeof(real);
+     Name = AllocReal(nName, NULL);
+     VecInit(0.0, nName, Name);
+     strcpy((char *) Name, KrigYName(KrigMod));
+
+     VecInit(0.0, KRIG_REC_HEAD, Head);
+     Head[0]  = (real) (KrigFileLen(KRIG_REC_HEAD)
+               + KrigFileLen(nName) + KrigFileLen(n * kSP)
+               + KrigFileLen(t * t) + KrigFileLen(t * k)
+               + KrigFileLen(k * k) + 2 * KrigFileLen(k)
+               + KrigFileLen(t)
+               + KrigFileLen(MatNumRows(CorPar) * MatNumCols(CorPar)));
+     Head[1]  = (real) DataHash;
+     Head[2]  = (real) n;
+     Head[3]  = (real) kSP;
+     Head[4]  = (real) t;
+     Head[5]  = (real) k;
+     Head[6]  = (real) MatNumRows(CorPar);
+     Head[7]  = (real) MatNumCols(CorPar);
+     Head[8]  = (real) KrigCorFam(KrigMod);
+     Head[9]  = (real) KrigRanErr(KrigMod);
+     Head[10] = KrigMod->SigmaSq;
+     Head[11] = KrigMod->SPVarProp;
+     Head[12] = (real) nName;
+     Head[13] = (real) KrigTermHash(KrigRegMod(KrigMod));
+     Head[14] = (real) KrigTermHash(KrigSPMod(KrigMod));
+
+     if (KrigFileWriteVec(File, KRIG_REC_HEAD, Head) != OK ||
+               KrigFileWriteVec(File, nName, Name) != OK ||
+               KrigFileWriteMat(File, CorPar) != OK ||
+               KrigFileWriteMat(File, G) != OK ||
+               KrigFileWriteMat(File, KrigChol(KrigMod)) != OK ||
+               KrigFileWriteMat(File, Q) != OK ||
+               KrigFileWriteMat(File, KrigR(KrigMod)) != OK ||
+               KrigFileWriteVec(File, k, KrigMod->RBeta) != OK ||
+               KrigFileWriteVec(File, k, KrigMod->Beta) != OK ||
+               KrigFileWriteVec(File, t, KrigMod->ResTilde) != OK)
+     {
+          AllocFree(Name);
+          Error("Cannot write the fitted model for %s.\n",
+                    KrigYName(KrigMod));
+          return FILE_ERR;
+     }
+
+     AllocFree(Name);
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+int KrigModRead(FILE *File, ulong DataHash, KrigingModel *KrigMod)
+/*****************************************************************/
+/*   Purpose:  Find the record for KrigYName(KrigMod) in a       */
+/*             fitted-model file opened by KrigFileOpen and put  */
+/*             its parameters and decompositions in KrigMod, as  */
+/*             KrigModData and KrigModSetUp would.               */
+/*                                                               */
+/*   Returns:  OK           if successful;                       */
+/*             INCOMPAT_ERR if there is no record for the        */
+/*                          response with DataHash, the          */
+/*                          dimensions, CorFam, RanErr, and      */
+/*                          model terms of KrigMod, and its      */
+/*                          parameters (KrigMod is unchanged);   */
+/*             FILE_ERR     if the file cannot be read (KrigMod  */
+/*                          is reset, see below).                */
+/*                                                               */
+/*   Comment:  KrigMod must have been allocated by KrigModAlloc, */
+/*             and its parameters set up by CorParSetUp.  They   */
+/*             match a record if they agree with it to within a  */
+/*             relative KRIG_PAR_TOL; the record's values are    */
+/*             then used.                                        */
+/*             Only what prediction needs is read: F, Y, and the */
+/*             spacing of G are not set up.  After FILE_ERR, G   */
+/*             and the decompositions are zero and must be set   */
+/*             up again (KrigModData and KrigModSetUp).          */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: Records also matched on the model terms and the */
+/*               parameters; KrigMod reset after FILE_ERR.       */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     boolean   Match;
+     int       ErrNum;
+     Matrix    CorParRec;
+     Matrix    *CorPar, *G, *Q;
+     real      Head[KRIG_REC_HEAD];
+     real      *Name, *Work;
+     size_t    i, j, k, kSP, n, nName, nRead, t;
+     long      Skip;
+     ulong     RegHash, SPHash;
+
+     G      = KrigG(KrigMod);
+     Q      = KrigQ(KrigMod);
+     CorPar = KrigCorPar(KrigMod);
+
+     n   = MatNumRows(G);
+     kSP = MatNumCols(G);
+     t   = MatNumRows(Q);
+     k   = MatNumCols(Q);
+
+     RegHash = KrigTermHash(KrigRegMod(KrigMod));
+     SPHash  = KrigTermHash(KrigSPMod(KrigMod));
+
+     if (fseek(File, (long) (KRIG_FILE_ALIGN * sizeof(real)),
+               SEEK_SET) != 0)
+          return FILE_ERR;
+
+     MatAlloc(MatNumRows(CorPar), MatNumCols(CorPar), RECT, &CorParRec);
+     Work = AllocReal(max(max(n, t), MatNumRows(CorPar)), NULL);
+
+     /* Records until a match or the end of the file. */
+     ErrNum = INCOMPAT_ERR;
+     while (ErrNum == INCOMPAT_ERR &&
+               KrigFileReadVec(File, KRIG_REC_HEAD, Head) == OK)
+     {
+          nName = (size_t) Head[12];
+          Name = AllocReal(KrigFileLen(nName), NULL);
+          if (nName == 0 || KrigFileReadVec(File, nName, Name) != OK)
+          {
+               AllocFree(Name);
+               break;
+          }
+          ((char *) Name)[nName * sizeof(real) - 1] = '\0';
+
+          Match = (stricmp((char *) Name, KrigYName(KrigMod)) == 0 &&
+                    Head[1] == (real) DataHash &&
+                    Head[2] == (real) n    && Head[3] == (real) kSP &&
+                    Head[4] == (real) t    && Head[5] == (real) k &&
+                    Head[6] == (real) MatNumRows(CorPar) &&
+                    Head[7] == (real) MatNumCols(CorPar) &&
+                    Head[8] == (real) KrigCorFam(KrigMod) &&
+                    Head[9] == (real) KrigRanErr(KrigMod) &&
+                    Head[13] == (real) RegHash &&
+                    Head[14] == (real) SPHash &&
+                    KrigParClose(Head[10], KrigMod->SigmaSq) &&
+                    KrigParClose(Head[11], KrigMod->SPVarProp));
+          AllocFree(Name);
+
+          nRead = KrigFileLen(KRIG_REC_HEAD) + KrigFileLen(nName);
+
+          /* The record's correlation parameters. */
+          if (Match)
+          {
+               if (KrigFileReadMat(File, Work, &CorParRec) != OK)
+                    break;
+               nRead += KrigFileLen(MatNumRows(CorPar)
+                         * MatNumCols(CorPar));
+
+               for (j = 0; j < MatNumCols(CorPar) && Match; j++)
+                    for (i = 0; i < MatNumRows(CorPar) && Match; i++)
+                         Match = KrigParClose(MatElem(&CorParRec, i, j),
+                                   MatElem(CorPar, i, j));
+          }
+
+          if (!Match)
+          {
+               Skip = (long) ((Head[0] - nRead) * sizeof(real));
+               if (fseek(File, Skip, SEEK_CUR) != 0)
+                    break;
+               continue;
+          }
+
+          if (KrigFileReadMat(File, Work, G) != OK ||
+                    KrigFileReadMat(File, Work, KrigChol(KrigMod))
+                         != OK ||
+                    KrigFileReadMat(File, Work, Q) != OK ||
+                    KrigFileReadMat(File, Work, KrigR(KrigMod))
+                         != OK ||
+                    KrigFileReadVec(File, k, KrigMod->RBeta) != OK ||
+                    KrigFileReadVec(File, k, KrigMod->Beta) != OK ||
+                    KrigFileReadVec(File, t, KrigMod->ResTilde) != OK)
+          {
+               Error("Cannot read the fitted model for %s.\n",
+                         KrigYName(KrigMod));
+
+               /* Nothing half read is left for prediction. */
+               MatInitValue(0.0, G);
+               MatInitValue(0.0, KrigChol(KrigMod));
+               MatInitValue(0.0, Q);
+               MatInitValue(0.0, KrigR(KrigMod));
+               VecInit(0.0, k, KrigMod->RBeta);
+               VecInit(0.0, k, KrigMod->Beta);
+               VecInit(0.0, t, KrigMod->ResTilde);
+
+               ErrNum = FILE_ERR;
+          }
+          else
+          {
+               for (j = 0; j < MatNumCols(CorPar); j++)
+                    VecCopy(MatCol(&CorParRec, j), MatNumRows(CorPar),
+                              MatCol(CorPar, j));
+               KrigMod->SigmaSq   = Head[10];
+               KrigMod->SPVarProp = Head[11];
+
+               ErrNum = OK;
+          }
+     }
+
+     MatFree(&CorParRec);
+     AllocFree(Work);
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+static int KrigFileWriteMat(FILE *File, const Matrix *M)
+/*****************************************************************/
+/*   Purpose:  Write M by columns, padded to KRIG_FILE_ALIGN.    */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     real      Zero;
+     size_t    i, j, m, nPad;
+
+     Zero = 0.0;
+     m = MatNumRows(M);
+
+     for (j = 0; j < MatNumCols(M); j++)
+     {
+          if (fwrite(MatCol(M, j), sizeof(real), MatColLen(M, j), File)
+                    != MatColLen(M, j))
+               return FILE_ERR;
+          for (i = MatColLen(M, j); i < m; i++)
+               if (fwrite(&Zero, sizeof(real), 1, File) != 1)
+                    return FILE_ERR;
+     }
+
+     nPad = KrigFileLen(m * MatNumCols(M)) - m * MatNumCols(M);
+     for (i = 0; i < nPad; i++)
+          if (fwrite(&Zero, sizeof(real), 1, File) != 1)
+               return FILE_ERR;
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+static int KrigFileReadMat(FILE *File, real *Work, Matrix *M)
+/*****************************************************************/
+/*   Purpose:  Read M as written by KrigFileWriteMat.  Work must */
+/*             have space for a column of M.                     */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     size_t    j, m, nPad;
+
+     m = MatNumRows(M);
+
+     for (j = 0; j < MatNumCols(M); j++)
+     {
+          if (fread(Work, sizeof(real), m, File) != m)
+               return FILE_ERR;
+          VecCopy(Work, MatColLen(M, j), MatCol(M, j));
+     }
+
+     nPad = KrigFileLen(m * MatNumCols(M)) - m * MatNumCols(M);
+     if (nPad > 0 && fseek(File, (long) (nPad * sizeof(real)),
+               SEEK_CUR) != 0)
+          return FILE_ERR;
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+static int KrigFileWriteVec(FILE *File, size_t n, const real *v)
+/*****************************************************************/
+/*   Purpose:  Write v[0],..., v[n - 1], padded to               */
+/*             KRIG_FILE_ALIGN.                                  */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     real      Zero;
+     size_t    i;
+
+     Zero = 0.0;
+
+     if (fwrite(v, sizeof(real), n, File) != n)
+          return FILE_ERR;
+
+     for (i = n; i < KrigFileLen(n); i++)
+          if (fwrite(&Zero, sizeof(real), 1, File) != 1)
+               return FILE_ERR;
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+static int KrigFileReadVec(FILE *File, size_t n, real *v)
+/*****************************************************************/
+/*   Purpose:  Read v as written by KrigFileWriteVec.            */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     size_t    nPad;
+
+     if (fread(v, sizeof(real), n, File) != n)
+          return FILE_ERR;
+
+     nPad = KrigFileLen(n) - n;
+     if (nPad > 0 && fseek(File, (long) (nPad * sizeof(real)),
+               SEEK_CUR) != 0)
+          return FILE_ERR;
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+static ulong KrigHashBytes(ulong Hash, const void *p, size_t n)
+/*****************************************************************/
+/*   Purpose:  Continue a 32-bit FNV-1a hash with n bytes at p.  */
+/*                                                               */
+/*   2026.10.17: Created from KrigDataHash.                      */
+/*****************************************************************/
+{
+     const unsigned char *b;
+     size_t    l;
+
+     b = (const unsigned char *) p;
+     for (l = 0; l < n; l++)
+          Hash = ((Hash ^ b[l]) * 16777619UL) & 0xFFFFFFFFUL;
+
+     return Hash;
+}
+
+/*******************************+++*******************************/
+static ulong KrigTermHash(const LinModel *Mod)
+/*****************************************************************/
+/*   Purpose:  Return a hash of the terms of Mod: their names    */
+/*             and, for each factor, the x variable, function,   */
+/*             and level.                                        */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     int       Func;
+     size_t    i, j, z;
+     string    xName;
+     ulong     Hash;
+
+     Hash = 2166136261UL;
+     for (j = 0; j < ModDF(Mod); j++)
+     {
+          Hash = KrigHashBytes(Hash, ModTermNames(Mod)[j],
+                    strlen(ModTermNames(Mod)[j]) + 1);
+
+          for (i = 0; i < MatNumRows(&Mod->Term[j]); i++)
+          {
+               xName = ModxName(&Mod->Term[j], i);
+               Hash = KrigHashBytes(Hash, xName, strlen(xName) + 1);
+
+               z    = ModxIndex(&Mod->Term[j], i);
+               Hash = KrigHashBytes(Hash, &z, sizeof(size_t));
+               Func = ModFunc(&Mod->Term[j], i);
+               Hash = KrigHashBytes(Hash, &Func, sizeof(int));
+               z    = ModCatLevel(&Mod->Term[j], i);
+               Hash = KrigHashBytes(Hash, &z, sizeof(size_t));
+          }
+     }
+
+     return Hash;
+}
+
+/*******************************+++*******************************/
+static boolean KrigParClose(real a, real b)
+/*****************************************************************/
+/*   Purpose:  Do parameter values a and b agree to within a     */
+/*             relative KRIG_PAR_TOL?                            */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     return (fabs(a - b) <= KRIG_PAR_TOL * max(fabs(a), fabs(b)));
+}
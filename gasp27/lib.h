@@ -145,6 +145,17 @@ typedef struct
 #define TemplType(T)          ((T)->Type)
 #define TemplStrIndex(s, T)   (StrIndex(s, T->LegalStr, T->NumLegalStr))
 
+/* SIMD levels for libsimd.c. */
+#define SIMD_NONE     0
+#define SIMD_AVX2     1
+#define SIMD_AVX512   2
+
+/* Chunk length for work vectors passed to VecExp, etc. */
+#define VEC_CHUNK   256
+
+/* Maximum error (ulp) of VecExp and VecLog relative to exp and log. */
+#define VEC_MATH_ULPS   2
+
 /* liballoc.c: */
 
 char      *AllocChar(size_t n, char *p);
@@ -371,6 +382,22 @@ void ErrorToMat(const string Severity, const string Format,
 /*   Purpose:  Save error, warning, etc. messages in a matrix.   */
 /*****************************************************************/
 
+/*****************************************************************/
+void ErrorHold(Matrix *Held);
+/*****************************************************************/
+/*   Purpose:  Hold the calling thread's error, warning, etc.    */
+/*             messages in Held (initialized by the caller)      */
+/*             until ErrorHold(NULL).                            */
+/*****************************************************************/
+
+/*****************************************************************/
+void ErrorRelease(Matrix *Held);
+/*****************************************************************/
+/*   Purpose:  Save the messages held in Held (see ErrorHold) in */
+/*             ErrorMat, or output them if ErrorSave is not set, */
+/*             and empty Held.                                   */
+/*****************************************************************/
+
 /*****************************************************************/
 void ErrorMatOut(void);
 /*****************************************************************/
@@ -469,6 +496,8 @@ real      Cor(real *x, real *y, size_t n);
 
 int       RandInit(int _xcomp, int _ycomp, int _zcomp);
 real      RandUnif(void);
+void      RandGetState(int *_xcomp, int *_ycomp, int *_zcomp);
+int       RandSeed(void);
 
 
 /* libreg.c: */
@@ -652,6 +681,38 @@ boolean RegIsCand(const Matrix *Reg);
 /*****************************************************************/
 
 
+/* libsimd.c: */
+
+/*****************************************************************/
+int VecSimdLevel(void);
+/*****************************************************************/
+/*   Purpose:  Return the SIMD level used by VecExp, etc.:       */
+/*             SIMD_AVX512, SIMD_AVX2, or SIMD_NONE.             */
+/*****************************************************************/
+
+/*****************************************************************/
+void VecExp(size_t n, const real *x, real *y);
+/*****************************************************************/
+/*   Purpose:  y[i] = exp(x[i]), i = 0,..., n - 1.               */
+/*****************************************************************/
+
+/*****************************************************************/
+void VecLog(size_t n, const real *x, real *y);
+/*****************************************************************/
+/*   Purpose:  y[i] = log(x[i]), i = 0,..., n - 1.               */
+/*****************************************************************/
+
+/*****************************************************************/
+void VecPow(size_t n, const real *x, real p, real *y);
+/*****************************************************************/
+/*   Purpose:  y[i] = pow(x[i], p), i = 0,..., n - 1, for        */
+/*             x[i] >= 0 and p > 0.                              */
+/*                                                               */
+/*   Comment:  Without SIMD, pow is used and results are exact   */
+/*             to the C library; with SIMD, exp(p * log(x[i])).  */
+/*****************************************************************/
+
+
 /* libsort.c: */
 
 void QuickIndex(const real *x, size_t n, size_t *Index);
@@ -14,7 +14,8 @@
 
 /* Pointers that have been allocated by AllocGeneric()  */
 /* and not yet freed by AllocFree().  These are kept to */
-/* facilitate debugging.                                */
+/* facilitate debugging.  With OpenMP, the list is      */
+/* updated by one thread at a time.                     */
 size_t nPointers = 0;
 void   **Pointer = NULL;
 
@@ -112,26 +113,40 @@ void *AllocGeneric(size_t n, size_t Size, void *p)
 /*                                                               */
 /*   Comment:  exit(1) is called if there is insufficient memory.*/
 /*                                                               */
-/*   Version:  1995 September 22                                 */
+/*   2026.10.17: Pointer list updated in a critical section.     */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
+     boolean   ListOK;
      size_t    i;
 
-     if (n > 0 && p == NULL)
-     {
-          p = calloc(n, Size);
-          Pointer = (void **) realloc(Pointer,
-                    (++nPointers) * sizeof(void *));
-          if (Pointer != NULL)
-               Pointer[nPointers-1] = p;
-     }
-     else if (n > 0 && p != NULL)
+     ListOK = YES;
+
+     if (n > 0)
      {
-          i = AllocFindPtr(p);
-          p = realloc(p, n * Size);
-          Pointer[i] = p;
+#ifdef _OPENMP
+#pragma omp critical (AllocList)
+#endif
+          {
+               if (p == NULL)
+               {
+                    p = calloc(n, Size);
+                    Pointer = (void **) realloc(Pointer,
+                              (++nPointers) * sizeof(void *));
+                    if (Pointer != NULL)
+                         Pointer[nPointers-1] = p;
+               }
+               else
+               {
+                    i = AllocFindPtr(p);
+                    p = realloc(p, n * Size);
+                    Pointer[i] = p;
+               }
+               ListOK = (Pointer != NULL);
+          }
      }
-     else if (n == 0 && p != NULL)
+     else if (p != NULL)
      {
           AllocFree(p);
           p = NULL;
@@ -139,8 +154,7 @@ void *AllocGeneric(size_t n, size_t Size, void *p)
 
      /* No action required if n == 0 && p == NULL. */
 
-     if ( (p == NULL && n > 0) ||
-               (nPointers > 0 && Pointer == NULL) )
+     if ( (p == NULL && n > 0) || !ListOK)
      {
           Fatal("Insufficient memory.\n");
           exit(1);
@@ -154,6 +168,9 @@ size_t AllocFindPtr(void *p)
 /*****************************************************************/
 /*   Purpose:  Return i such that Pointer[i] = p.                */
 /*                                                               */
+/*   Comment:  With OpenMP, the caller must be in the AllocList  */
+/*             critical section.                                 */
+/*                                                               */
 /*   Version:  1995 September 22                                 */
 /*****************************************************************/
 {
@@ -179,19 +196,26 @@ void AllocFree(void *p)
 /*****************************************************************/
 /*   Purpose:  Free p.                                           */
 /*                                                               */
-/*   Version:  1995 September 22                                 */
+/*   2026.10.17: Pointer list updated in a critical section.     */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
      size_t    i, j;
 
      if (p != NULL)
      {
-          i = AllocFindPtr(p);
+#ifdef _OPENMP
+#pragma omp critical (AllocList)
+#endif
+          {
+               i = AllocFindPtr(p);
 
-          for (j = i; j < nPointers - 1; j++)
-               Pointer[j] = Pointer[j+1];
+               for (j = i; j < nPointers - 1; j++)
+                    Pointer[j] = Pointer[j+1];
 
-          nPointers--;
+               nPointers--;
+          }
 
           free(p);
      }
@@ -213,7 +237,11 @@ void AllocFree(void *p)
 /*                                                               */
 /*   Returns:  Re-allocated pointer.                             */
 /*                                                               */
-/*   Version:  1992 April 16                                     */
+/*   2026.10.17: Strings freed last to first, so AllocFree finds */
+/*               each one near the end of the pointer list when  */
+/*               they were allocated in order.                   */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*                                                               */
 /*****************************************************************/
 
@@ -221,8 +249,8 @@ string *AllocStrFree(size_t OldLen, size_t NewLen, string *s)
 {
      size_t    i;
 
-     for (i = NewLen; i < OldLen; i++)
-          AllocFree(s[i]);
+     for (i = OldLen; i > NewLen; i--)
+          AllocFree(s[i-1]);
 
      s = AllocStr(NewLen, s);
 
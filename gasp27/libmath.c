@@ -14,7 +14,7 @@
 #include "implem.h"
 #include "lib.h"
 
-extern int     ErrorSeverityLevel;
+extern THREAD_LOCAL int ErrorSeverityLevel;
 
 /*******************************+++*******************************/
 boolean ApproxEq(real a, real b, real AbsTol, real RelTol)
@@ -14,15 +14,27 @@
 #include "implem.h"
 #include "lib.h"
 
+#ifdef _OPENMP
+     #include <omp.h>
+#endif
+
 static FILE *LogFile = NULL;
 
-static char    Buf[MAXTOK+1];
 static Matrix  ErrorMat;
 
+/* Per thread: the master may put out lines while */
+/* other threads save messages.                    */
+static THREAD_LOCAL char Buf[MAXTOK+1];
+
 boolean        ErrorSave = NO;
 string         ErrorVar  = NULL;
-int            ErrorSeverityLevel = SEV_ERROR;
-size_t         ErrorTry  = 0;
+
+/* Set by whichever thread is generating the messages. */
+THREAD_LOCAL int    ErrorSeverityLevel = SEV_ERROR;
+THREAD_LOCAL size_t ErrorTry  = 0;
+
+/* Where the thread holds its messages (see ErrorHold). */
+static THREAD_LOCAL Matrix *ErrorHeld = NULL;
 
 static string  SeverityStr[] = SEVERITY_STRS;
 
@@ -109,6 +121,9 @@ void FileOutput(FILE *fp, const string Format, ...)
 /*                                                               */
 /* 1995.05.02:                                                   */
 /* 2000.02.15: Output("\n") added to Fatal().                    */
+/* 2026.10.17: Error() and Incompatibility() may be called from  */
+/*             several threads (one message at a time).          */
+/* 2026.10.17: A thread's messages may be held (ErrorHold).      */
 /*****************************************************************/
 
 void Output(const string Format, ...)
@@ -130,13 +145,19 @@ void Error(const string Format, ...)
 
      va_start(Args, Format);
 
-     if (ErrorSave)
-          /* Save the message in ErrorMat. */
-          ErrorToMat(SeverityStr[ErrorSeverityLevel], Format, Args);
-     else
+#ifdef _OPENMP
+#pragma omp critical (ErrorOut)
+#endif
      {
-          Output("%s: ", SeverityStr[ErrorSeverityLevel]);
-          OutputVA(Format, Args);
+          if (ErrorSave || ErrorHeld != NULL)
+               /* Save the message in ErrorMat. */
+               ErrorToMat(SeverityStr[ErrorSeverityLevel], Format,
+                         Args);
+          else
+          {
+               Output("%s: ", SeverityStr[ErrorSeverityLevel]);
+               OutputVA(Format, Args);
+          }
      }
 
      va_end(Args);
@@ -165,13 +186,18 @@ void Incompatibility(const string Format, ...)
 
      va_start(Args, Format);
 
-     if (ErrorSave)
-          /* Save the message in ErrorMat. */
-          ErrorToMat("Incompatibility", Format, Args);
-     else
+#ifdef _OPENMP
+#pragma omp critical (ErrorOut)
+#endif
      {
-          Output("%s", "Incompatibility: ");
-          OutputVA(Format, Args);
+          if (ErrorSave || ErrorHeld != NULL)
+               /* Save the message in ErrorMat. */
+               ErrorToMat("Incompatibility", Format, Args);
+          else
+          {
+               Output("%s", "Incompatibility: ");
+               OutputVA(Format, Args);
+          }
      }
 
      va_end(Args);
@@ -206,37 +232,30 @@ void OutputVA(const string Format, va_list Args)
 }
 
 
+static void ErrorRowAdd(const string Var, size_t Try,
+     const string Severity, const string Message, Matrix *E);
+
 /******************************+++********************************/
 void ErrorToMat(const string Severity, const string Format,
           va_list Args)
 /*****************************************************************/
 /*   Purpose:  Save error, warning, etc. messages in a matrix.   */
 /*                                                               */
-/*   Version:  1995 March 10                                     */
+/*   2026.10.17: In the thread's held matrix, if any (see        */
+/*               ErrorHold).                                     */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
-     size_t    j, nRowsOld, LastTry;
-     size_t    *Try;
-     string    LastMess, LastVar, TermPtr;
-     string    *Message, *Variable;
+     string    TermPtr;
 
-     if (!MatInitialized(&ErrorMat))
+     if (ErrorHeld == NULL && !MatInitialized(&ErrorMat))
      {
           MatInit(RECT, MIXED, YES, &ErrorMat);
           MatPutText(&ErrorMat,
                "The following error messages were generated:\n");
      }
 
-     Variable = MatStrColFind(&ErrorMat, VARIABLE, NO);
-     Try      = MatSize_tColFind(&ErrorMat, "Try", NO);
-     Message  = MatStrColFind(&ErrorMat, "Message", NO);
-
-     nRowsOld = MatNumRows(&ErrorMat);
-
-     LastVar = (Variable != NULL) ? Variable[nRowsOld - 1] : NULL;
-     LastTry = (Try != NULL) ? Try[nRowsOld - 1] : 0;
-     LastMess = (Message != NULL) ? Message[nRowsOld - 1] : NULL;
-
      /* Put the message in Buf. */
      vsprintf(Buf, Format, Args);
 
@@ -245,31 +264,139 @@ void ErrorToMat(const string Severity, const string Format,
      if (stricmp(TermPtr, ".\n") == 0)
           *TermPtr = NULL;
 
-     if (stricmp(ErrorVar, LastVar) == 0 && ErrorTry == LastTry &&
-               stricmp(Buf, LastMess) == 0)
+     ErrorRowAdd(ErrorVar, ErrorTry, Severity, Buf,
+               (ErrorHeld != NULL) ? ErrorHeld : &ErrorMat);
+
+     return;
+}
+
+/******************************+++********************************/
+static void ErrorRowAdd(const string Var, size_t Try,
+     const string Severity, const string Message, Matrix *E)
+/*****************************************************************/
+/*   Purpose:  Add a message for variable Var and try Try (0 for */
+/*             none) to E, unless it repeats E's last message.   */
+/*                                                               */
+/*   2026.10.17: Created from ErrorToMat.                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    j, nRowsOld, LastTry;
+     size_t    *TryCol;
+     string    LastMess, LastVar;
+     string    *MessCol, *VarCol;
+
+     VarCol  = MatStrColFind(E, VARIABLE, NO);
+     TryCol  = MatSize_tColFind(E, "Try", NO);
+     MessCol = MatStrColFind(E, "Message", NO);
+
+     nRowsOld = MatNumRows(E);
+
+     LastVar = (VarCol != NULL) ? VarCol[nRowsOld - 1] : NULL;
+     LastTry = (TryCol != NULL) ? TryCol[nRowsOld - 1] : 0;
+     LastMess = (MessCol != NULL) ? MessCol[nRowsOld - 1] : NULL;
+
+     if (stricmp(Var, LastVar) == 0 && Try == LastTry &&
+               stricmp(Message, LastMess) == 0)
           /* Do not repeat same message. */
           return;
 
      /* Allocate a new row for the new message. */
-     MatReAlloc(nRowsOld + 1, MatNumCols(&ErrorMat), &ErrorMat);
+     MatReAlloc(nRowsOld + 1, MatNumCols(E), E);
 
-     if (ErrorVar != NULL)
+     if (Var != NULL)
      {
-          j = MatColumnAdd(VARIABLE, STRING, &ErrorMat);
-          MatPutStrElem(&ErrorMat, nRowsOld, j, ErrorVar);
+          j = MatColumnAdd(VARIABLE, STRING, E);
+          MatPutStrElem(E, nRowsOld, j, Var);
      }
 
-     if (ErrorTry != 0)
+     if (Try != 0)
      {
-          j = MatColumnAdd("Try", SIZE_T, &ErrorMat);
-          MatPutSize_tElem(&ErrorMat, nRowsOld, j, ErrorTry);
+          j = MatColumnAdd("Try", SIZE_T, E);
+          MatPutSize_tElem(E, nRowsOld, j, Try);
      }
 
-     j = MatColumnAdd("Severity", STRING, &ErrorMat);
-     MatPutStrElem(&ErrorMat, nRowsOld, j, Severity);
+     j = MatColumnAdd("Severity", STRING, E);
+     MatPutStrElem(E, nRowsOld, j, Severity);
 
-     j = MatColumnAdd("Message", STRING, &ErrorMat);
-     MatPutStrElem(&ErrorMat, nRowsOld, j, Buf);
+     j = MatColumnAdd("Message", STRING, E);
+     MatPutStrElem(E, nRowsOld, j, Message);
+
+     return;
+}
+
+/******************************+++********************************/
+void ErrorHold(Matrix *Held)
+/*****************************************************************/
+/*   Purpose:  Hold the calling thread's error, warning, etc.    */
+/*             messages in Held (initialized by the caller)      */
+/*             until ErrorHold(NULL).                            */
+/*                                                               */
+/*   Comment:  Lets parallel work keep its messages for          */
+/*             ErrorRelease in a fixed order, whatever the order */
+/*             in which the threads finish.                      */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     ErrorHeld = Held;
+
+     return;
+}
+
+/******************************+++********************************/
+void ErrorRelease(Matrix *Held)
+/*****************************************************************/
+/*   Purpose:  Save the messages held in Held (see ErrorHold) in */
+/*             ErrorMat, or output them if ErrorSave is not set, */
+/*             and empty Held.                                   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    i, Try;
+     size_t    *TryCol;
+     string    Var;
+     string    *MessCol, *SevCol, *VarCol;
+
+     if (MatNumRows(Held) == 0)
+          return;
+
+     VarCol  = MatStrColFind(Held, VARIABLE, NO);
+     TryCol  = MatSize_tColFind(Held, "Try", NO);
+     SevCol  = MatStrColFind(Held, "Severity", NO);
+     MessCol = MatStrColFind(Held, "Message", NO);
+
+#ifdef _OPENMP
+#pragma omp critical (ErrorOut)
+#endif
+     {
+          if (ErrorSave && !MatInitialized(&ErrorMat))
+          {
+               MatInit(RECT, MIXED, YES, &ErrorMat);
+               MatPutText(&ErrorMat,
+                    "The following error messages were generated:\n");
+          }
+
+          for (i = 0; i < MatNumRows(Held); i++)
+          {
+               Var = (VarCol != NULL) ? VarCol[i] : NULL;
+               Try = (TryCol != NULL) ? TryCol[i] : 0;
+
+               if (ErrorSave)
+                    ErrorRowAdd(Var, Try, SevCol[i], MessCol[i],
+                              &ErrorMat);
+               else
+                    Output("%s: %s.\n", SevCol[i], MessCol[i]);
+          }
+     }
+
+     MatReAlloc(0, 0, Held);
 
      return;
 }
@@ -302,11 +429,23 @@ void OutputTemp(const string Format, ...)
 /*   Purpose:  Output temporary message to stdout, which will be */
 /*             overwritten by next temporary message.            */
 /*                                                               */
-/*   Version:  1996.04.05                                        */
+/*   2026.10.17: Only the master thread's messages are shown.    */
+/*   2026.10.17: Master at every level of nested regions (a      */
+/*               thread of an outer team is thread 0 of its own  */
+/*               inactive inner team).                           */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
      size_t    i, nTempChars;
      va_list   Args;
+#ifdef _OPENMP
+     int       Level;
+
+     for (Level = 1; Level <= omp_get_level(); Level++)
+          if (omp_get_ancestor_thread_num(Level) != 0)
+               return;
+#endif
 
      va_start(Args, Format);
 
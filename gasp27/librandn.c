@@ -16,7 +16,8 @@
 
 /* Default initial seeds for the 3 components of the  */
 /* congruential generator (can be re-set by RandInit) */
-static int xcomp = 1, ycomp = 15000, zcomp = 30000;
+/* Each thread has its own generator.                 */
+static THREAD_LOCAL int xcomp = 1, ycomp = 15000, zcomp = 30000;
 
 /*******************************+++*******************************/
 /*                                                               */
@@ -85,3 +86,34 @@ real RandUnif(void)
           u = u - 1.0;
      return u;
 }
+
+/*******************************+++*******************************/
+void RandGetState(int *_xcomp, int *_ycomp, int *_zcomp)
+/*****************************************************************/
+/*   Purpose:  Return the 3 components of the generator, e.g.,   */
+/*             to restore them later with RandInit.              */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     *_xcomp = xcomp;
+     *_ycomp = ycomp;
+     *_zcomp = zcomp;
+}
+
+/*******************************+++*******************************/
+int RandSeed(void)
+/*****************************************************************/
+/*   Purpose:  Return a random seed in the range 1 to 30000 for  */
+/*             one component of a new sequence (see RandInit).   */
+/*                                                               */
+/*   Comment:  Used to give independent tasks (e.g., MLE tries)  */
+/*             their own sequences, so that the numbers they     */
+/*             generate do not depend on the order in which the  */
+/*             tasks run.                                        */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     return (int) min(30000.0, 1.0 + 30000.0 * RandUnif());
+}
@@ -0,0 +1,469 @@
+/*****************************************************************/
+/*   VECTOR MATH ROUTINES (EXP, LOG, POW) WITH SIMD KERNELS      */
+/*                                                               */
+/*   If SIMD_DEFINED (see implem.h), AVX2 or AVX-512 kernels are */
+/*   chosen at run time from the CPU's features; otherwise, and  */
+/*   on other CPUs, the scalar C library functions are used.     */
+/*                                                               */
+/*   The kernels follow fdlibm's e_exp.c and e_log.c (under 1    */
+/*   ulp), and AVX2 and AVX-512 give identical results.  Each    */
+/*   result is within VEC_MATH_ULPS ulp of the C library's.      */
+/*   Arguments outside the kernels' ranges (e.g., exp overflow   */
+/*   or underflow, log of zero, NaN) are passed to the C         */
+/*   library.                                                    */
+/*****************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "define.h"
+#include "implem.h"
+#include "lib.h"
+
+#ifdef SIMD_DEFINED
+     #include <immintrin.h>
+#endif
+
+/* Run-time SIMD level: -1 until VecSimdLevel is first called. */
+static int SimdLevel = -1;
+
+/* fdlibm constants. */
+#define LN2_HI      6.93147180369123816490e-01
+#define LN2_LO      1.90821492927058770002e-10
+#define INV_LN2     1.44269504088896338700e+00
+#define EXP_P1      1.66666666666666019037e-01
+#define EXP_P2     -2.77777777770155933842e-03
+#define EXP_P3      6.61375632143793436117e-05
+#define EXP_P4     -1.65339022054652515390e-06
+#define EXP_P5      4.13813679705723846039e-08
+#define LOG_LG1     6.666666666666735130e-01
+#define LOG_LG2     3.999999999940941908e-01
+#define LOG_LG3     2.857142874366239149e-01
+#define LOG_LG4     2.222219843214978396e-01
+#define LOG_LG5     1.818357216161805012e-01
+#define LOG_LG6     1.531383769920937332e-01
+#define LOG_LG7     1.479819860511658591e-01
+#define SQRT2       1.41421356237309504880
+
+/* exp(x) kernels handle EXP_X_MIN <= x <= EXP_X_MAX, */
+/* where the result and 2^k are normal.               */
+#define EXP_X_MIN   (-708.0)
+#define EXP_X_MAX   709.0
+
+#ifdef SIMD_DEFINED
+
+/*******************************+++*******************************/
+__attribute__((target("avx2,fma")))
+static __m256d ExpAVX2(__m256d x, int *AllOK)
+/*****************************************************************/
+/*   Purpose:  exp of 4 lanes; *AllOK = 0 if any lane is out of  */
+/*             range (the caller then uses exp for that lane).   */
+/*****************************************************************/
+{
+     __m256d   c, hi, k, lo, r, t, y;
+     __m256i   e;
+
+     *AllOK = (_mm256_movemask_pd(_mm256_and_pd(
+               _mm256_cmp_pd(x, _mm256_set1_pd(EXP_X_MIN), _CMP_GE_OQ),
+               _mm256_cmp_pd(x, _mm256_set1_pd(EXP_X_MAX), _CMP_LE_OQ)))
+               == 0xf);
+
+     k  = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(INV_LN2)),
+               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+     hi = _mm256_sub_pd(x, _mm256_mul_pd(k, _mm256_set1_pd(LN2_HI)));
+     lo = _mm256_mul_pd(k, _mm256_set1_pd(LN2_LO));
+     r  = _mm256_sub_pd(hi, lo);
+     t  = _mm256_mul_pd(r, r);
+
+     c = _mm256_add_pd(_mm256_set1_pd(EXP_P4),
+               _mm256_mul_pd(t, _mm256_set1_pd(EXP_P5)));
+     c = _mm256_add_pd(_mm256_set1_pd(EXP_P3), _mm256_mul_pd(t, c));
+     c = _mm256_add_pd(_mm256_set1_pd(EXP_P2), _mm256_mul_pd(t, c));
+     c = _mm256_add_pd(_mm256_set1_pd(EXP_P1), _mm256_mul_pd(t, c));
+     c = _mm256_sub_pd(r, _mm256_mul_pd(t, c));
+
+     /* y = 1 - ((lo - (r * c) / (2 - c)) - hi). */
+     y = _mm256_div_pd(_mm256_mul_pd(r, c),
+               _mm256_sub_pd(_mm256_set1_pd(2.0), c));
+     y = _mm256_sub_pd(_mm256_set1_pd(1.0),
+               _mm256_sub_pd(_mm256_sub_pd(lo, y), hi));
+
+     /* Multiply by 2^k: the low bits of 2^52 + k + 1023 */
+     /* are the biased exponent.                         */
+     e = _mm256_castpd_si256(_mm256_add_pd(k,
+               _mm256_set1_pd(4503599627370496.0 + 1023.0)));
+     e = _mm256_slli_epi64(e, 52);
+
+     return _mm256_mul_pd(y, _mm256_castsi256_pd(e));
+}
+
+/*******************************+++*******************************/
+__attribute__((target("avx2,fma")))
+static __m256d LogAVX2(__m256d x, int *AllOK)
+/*****************************************************************/
+/*   Purpose:  log of 4 lanes; *AllOK = 0 if any lane is not a   */
+/*             positive, normal number.                          */
+/*****************************************************************/
+{
+     __m256d   Big, e, f, hfsq, m, R, s, t1, t2, w, z;
+     __m256i   Bits;
+
+     *AllOK = (_mm256_movemask_pd(_mm256_and_pd(
+               _mm256_cmp_pd(x, _mm256_set1_pd(REAL_MIN), _CMP_GE_OQ),
+               _mm256_cmp_pd(x, _mm256_set1_pd(REAL_MAX), _CMP_LE_OQ)))
+               == 0xf);
+
+     /* x = m * 2^e with 1 <= m < 2. */
+     Bits = _mm256_castpd_si256(x);
+     e = _mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(Bits, 52),
+               _mm256_set1_epi64x(0x4330000000000000LL)));
+     e = _mm256_sub_pd(e, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+     m = _mm256_castsi256_pd(_mm256_or_si256(_mm256_and_si256(Bits,
+               _mm256_set1_epi64x(0x000fffffffffffffLL)),
+               _mm256_set1_epi64x(0x3ff0000000000000LL)));
+
+     /* Then sqrt(2)/2 <= m < sqrt(2). */
+     Big = _mm256_cmp_pd(m, _mm256_set1_pd(SQRT2), _CMP_GE_OQ);
+     m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), Big);
+     e = _mm256_add_pd(e, _mm256_and_pd(Big, _mm256_set1_pd(1.0)));
+
+     f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+     s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+     z = _mm256_mul_pd(s, s);
+     w = _mm256_mul_pd(z, z);
+
+     t1 = _mm256_add_pd(_mm256_set1_pd(LOG_LG4),
+               _mm256_mul_pd(w, _mm256_set1_pd(LOG_LG6)));
+     t1 = _mm256_add_pd(_mm256_set1_pd(LOG_LG2), _mm256_mul_pd(w, t1));
+     t1 = _mm256_mul_pd(w, t1);
+     t2 = _mm256_add_pd(_mm256_set1_pd(LOG_LG5),
+               _mm256_mul_pd(w, _mm256_set1_pd(LOG_LG7)));
+     t2 = _mm256_add_pd(_mm256_set1_pd(LOG_LG3), _mm256_mul_pd(w, t2));
+     t2 = _mm256_add_pd(_mm256_set1_pd(LOG_LG1), _mm256_mul_pd(w, t2));
+     t2 = _mm256_mul_pd(z, t2);
+     R  = _mm256_add_pd(t2, t1);
+
+     /* e * LN2_HI - ((hfsq - (s * (hfsq + R) + e * LN2_LO)) - f). */
+     hfsq = _mm256_mul_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(f, f));
+     t1 = _mm256_add_pd(_mm256_mul_pd(s, _mm256_add_pd(hfsq, R)),
+               _mm256_mul_pd(e, _mm256_set1_pd(LN2_LO)));
+     t1 = _mm256_sub_pd(_mm256_sub_pd(hfsq, t1), f);
+
+     return _mm256_sub_pd(_mm256_mul_pd(e, _mm256_set1_pd(LN2_HI)), t1);
+}
+
+/*******************************+++*******************************/
+__attribute__((target("avx512f")))
+static __m512d ExpAVX512(__m512d x, int *AllOK)
+/*****************************************************************/
+/*   Purpose:  As ExpAVX2, for 8 lanes.                          */
+/*****************************************************************/
+{
+     __m512d   c, hi, k, lo, r, t, y;
+     __m512i   e;
+
+     *AllOK = ((_mm512_cmp_pd_mask(x, _mm512_set1_pd(EXP_X_MIN),
+               _CMP_GE_OQ) & _mm512_cmp_pd_mask(x,
+               _mm512_set1_pd(EXP_X_MAX), _CMP_LE_OQ)) == 0xff);
+
+     k  = _mm512_roundscale_pd(_mm512_mul_pd(x,
+               _mm512_set1_pd(INV_LN2)),
+               _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+     hi = _mm512_sub_pd(x, _mm512_mul_pd(k, _mm512_set1_pd(LN2_HI)));
+     lo = _mm512_mul_pd(k, _mm512_set1_pd(LN2_LO));
+     r  = _mm512_sub_pd(hi, lo);
+     t  = _mm512_mul_pd(r, r);
+
+     c = _mm512_add_pd(_mm512_set1_pd(EXP_P4),
+               _mm512_mul_pd(t, _mm512_set1_pd(EXP_P5)));
+     c = _mm512_add_pd(_mm512_set1_pd(EXP_P3), _mm512_mul_pd(t, c));
+     c = _mm512_add_pd(_mm512_set1_pd(EXP_P2), _mm512_mul_pd(t, c));
+     c = _mm512_add_pd(_mm512_set1_pd(EXP_P1), _mm512_mul_pd(t, c));
+     c = _mm512_sub_pd(r, _mm512_mul_pd(t, c));
+
+     y = _mm512_div_pd(_mm512_mul_pd(r, c),
+               _mm512_sub_pd(_mm512_set1_pd(2.0), c));
+     y = _mm512_sub_pd(_mm512_set1_pd(1.0),
+               _mm512_sub_pd(_mm512_sub_pd(lo, y), hi));
+
+     e = _mm512_castpd_si512(_mm512_add_pd(k,
+               _mm512_set1_pd(4503599627370496.0 + 1023.0)));
+     e = _mm512_slli_epi64(e, 52);
+
+     return _mm512_mul_pd(y, _mm512_castsi512_pd(e));
+}
+
+/*******************************+++*******************************/
+__attribute__((target("avx512f")))
+static __m512d LogAVX512(__m512d x, int *AllOK)
+/*****************************************************************/
+/*   Purpose:  As LogAVX2, for 8 lanes.                          */
+/*****************************************************************/
+{
+     __m512d   e, f, hfsq, m, R, s, t1, t2, w, z;
+     __m512i   Bits;
+     __mmask8  Big;
+
+     *AllOK = ((_mm512_cmp_pd_mask(x, _mm512_set1_pd(REAL_MIN),
+               _CMP_GE_OQ) & _mm512_cmp_pd_mask(x,
+               _mm512_set1_pd(REAL_MAX), _CMP_LE_OQ)) == 0xff);
+
+     Bits = _mm512_castpd_si512(x);
+     e = _mm512_castsi512_pd(_mm512_or_si512(_mm512_srli_epi64(Bits, 52),
+               _mm512_set1_epi64(0x4330000000000000LL)));
+     e = _mm512_sub_pd(e, _mm512_set1_pd(4503599627370496.0 + 1023.0));
+     m = _mm512_castsi512_pd(_mm512_or_si512(_mm512_and_si512(Bits,
+               _mm512_set1_epi64(0x000fffffffffffffLL)),
+               _mm512_set1_epi64(0x3ff0000000000000LL)));
+
+     Big = _mm512_cmp_pd_mask(m, _mm512_set1_pd(SQRT2), _CMP_GE_OQ);
+     m = _mm512_mask_mul_pd(m, Big, m, _mm512_set1_pd(0.5));
+     e = _mm512_mask_add_pd(e, Big, e, _mm512_set1_pd(1.0));
+
+     f = _mm512_sub_pd(m, _mm512_set1_pd(1.0));
+     s = _mm512_div_pd(f, _mm512_add_pd(_mm512_set1_pd(2.0), f));
+     z = _mm512_mul_pd(s, s);
+     w = _mm512_mul_pd(z, z);
+
+     t1 = _mm512_add_pd(_mm512_set1_pd(LOG_LG4),
+               _mm512_mul_pd(w, _mm512_set1_pd(LOG_LG6)));
+     t1 = _mm512_add_pd(_mm512_set1_pd(LOG_LG2), _mm512_mul_pd(w, t1));
+     t1 = _mm512_mul_pd(w, t1);
+     t2 = _mm512_add_pd(_mm512_set1_pd(LOG_LG5),
+               _mm512_mul_pd(w, _mm512_set1_pd(LOG_LG7)));
+     t2 = _mm512_add_pd(_mm512_set1_pd(LOG_LG3), _mm512_mul_pd(w, t2));
+     t2 = _mm512_add_pd(_mm512_set1_pd(LOG_LG1), _mm512_mul_pd(w, t2));
+     t2 = _mm512_mul_pd(z, t2);
+     R  = _mm512_add_pd(t2, t1);
+
+     hfsq = _mm512_mul_pd(_mm512_set1_pd(0.5), _mm512_mul_pd(f, f));
+     t1 = _mm512_add_pd(_mm512_mul_pd(s, _mm512_add_pd(hfsq, R)),
+               _mm512_mul_pd(e, _mm512_set1_pd(LN2_LO)));
+     t1 = _mm512_sub_pd(_mm512_sub_pd(hfsq, t1), f);
+
+     return _mm512_sub_pd(_mm512_mul_pd(e, _mm512_set1_pd(LN2_HI)), t1);
+}
+
+/*******************************+++*******************************/
+__attribute__((target("avx2,fma")))
+static void VecExpLogAVX2(boolean Log, size_t n, const real *x,
+     real *y)
+/*****************************************************************/
+/*   Purpose:  y[i] = exp(x[i]) or log(x[i]), 4 at a time.       */
+/*****************************************************************/
+{
+     int       AllOK;
+     real      xPad[4], yPad[4];
+     size_t    i, j, m;
+     __m256d   v;
+
+     for (i = 0; i < n; i += 4)
+     {
+          m = min(4, n - i);
+          if (m == 4)
+               v = _mm256_loadu_pd(x + i);
+          else
+          {
+               /* Pad the last few with 1.0 (in range for both). */
+               for (j = 0; j < 4; j++)
+                    xPad[j] = (j < m) ? x[i+j] : 1.0;
+               v = _mm256_loadu_pd(xPad);
+          }
+
+          v = Log ? LogAVX2(v, &AllOK) : ExpAVX2(v, &AllOK);
+          _mm256_storeu_pd(yPad, v);
+
+          for (j = 0; j < m; j++)
+          {
+               if (!AllOK && !(Log ? (x[i+j] >= REAL_MIN &&
+                         x[i+j] <= REAL_MAX) : (x[i+j] >= EXP_X_MIN &&
+                         x[i+j] <= EXP_X_MAX)))
+                    yPad[j] = Log ? log(x[i+j]) : exp(x[i+j]);
+               y[i+j] = yPad[j];
+          }
+     }
+}
+
+/*******************************+++*******************************/
+__attribute__((target("avx512f")))
+static void VecExpLogAVX512(boolean Log, size_t n, const real *x,
+     real *y)
+/*****************************************************************/
+/*   Purpose:  y[i] = exp(x[i]) or log(x[i]), 8 at a time.       */
+/*****************************************************************/
+{
+     int       AllOK;
+     real      xPad[8], yPad[8];
+     size_t    i, j, m;
+     __m512d   v;
+
+     for (i = 0; i < n; i += 8)
+     {
+          m = min(8, n - i);
+          if (m == 8)
+               v = _mm512_loadu_pd(x + i);
+          else
+          {
+               for (j = 0; j < 8; j++)
+                    xPad[j] = (j < m) ? x[i+j] : 1.0;
+               v = _mm512_loadu_pd(xPad);
+          }
+
+          v = Log ? LogAVX512(v, &AllOK) : ExpAVX512(v, &AllOK);
+          _mm512_storeu_pd(yPad, v);
+
+          for (j = 0; j < m; j++)
+          {
+               if (!AllOK && !(Log ? (x[i+j] >= REAL_MIN &&
+                         x[i+j] <= REAL_MAX) : (x[i+j] >= EXP_X_MIN &&
+                         x[i+j] <= EXP_X_MAX)))
+                    yPad[j] = Log ? log(x[i+j]) : exp(x[i+j]);
+               y[i+j] = yPad[j];
+          }
+     }
+}
+
+#endif  /* SIMD_DEFINED */
+
+/*******************************+++*******************************/
+int VecSimdLevel(void)
+/*****************************************************************/
+/*   Purpose:  Return the SIMD level used by VecExp, etc.:       */
+/*             SIMD_AVX512, SIMD_AVX2, or SIMD_NONE.             */
+/*                                                               */
+/*   Comment:  The level is the best the CPU supports, but the   */
+/*             environment variable GASP_SIMD = "none" or "avx2" */
+/*             caps it (e.g., to check results against the       */
+/*             scalar code).                                     */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     char      *Cap;
+     int       Level;
+
+     if (SimdLevel >= 0)
+          return SimdLevel;
+
+     Level = SIMD_NONE;
+
+#ifdef SIMD_DEFINED
+     __builtin_cpu_init();
+     if (__builtin_cpu_supports("avx512f"))
+          Level = SIMD_AVX512;
+     else if (__builtin_cpu_supports("avx2")
+               && __builtin_cpu_supports("fma"))
+          Level = SIMD_AVX2;
+#endif
+
+     if ( (Cap = getenv("GASP_SIMD")) != NULL)
+     {
+          if (strcmp(Cap, "none") == 0)
+               Level = SIMD_NONE;
+          else if (strcmp(Cap, "avx2") == 0)
+               Level = min(Level, SIMD_AVX2);
+     }
+
+     SimdLevel = Level;
+
+     return SimdLevel;
+}
+
+/*******************************+++*******************************/
+void VecExp(size_t n, const real *x, real *y)
+/*****************************************************************/
+/*   Purpose:  y[i] = exp(x[i]), i = 0,..., n - 1.               */
+/*                                                               */
+/*   Comment:  VecExp(n, x, x) overwrites x.                     */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     size_t    i;
+
+#ifdef SIMD_DEFINED
+     if (VecSimdLevel() == SIMD_AVX512)
+     {
+          VecExpLogAVX512(NO, n, x, y);
+          return;
+     }
+     else if (VecSimdLevel() == SIMD_AVX2)
+     {
+          VecExpLogAVX2(NO, n, x, y);
+          return;
+     }
+#endif
+
+     for (i = 0; i < n; i++)
+          y[i] = exp(x[i]);
+}
+
+/*******************************+++*******************************/
+void VecLog(size_t n, const real *x, real *y)
+/*****************************************************************/
+/*   Purpose:  y[i] = log(x[i]), i = 0,..., n - 1.               */
+/*                                                               */
+/*   Comment:  VecLog(n, x, x) overwrites x.                     */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     size_t    i;
+
+#ifdef SIMD_DEFINED
+     if (VecSimdLevel() == SIMD_AVX512)
+     {
+          VecExpLogAVX512(YES, n, x, y);
+          return;
+     }
+     else if (VecSimdLevel() == SIMD_AVX2)
+     {
+          VecExpLogAVX2(YES, n, x, y);
+          return;
+     }
+#endif
+
+     for (i = 0; i < n; i++)
+          y[i] = log(x[i]);
+}
+
+/*******************************+++*******************************/
+void VecPow(size_t n, const real *x, real p, real *y)
+/*****************************************************************/
+/*   Purpose:  y[i] = pow(x[i], p), i = 0,..., n - 1, for        */
+/*             x[i] >= 0 and p > 0.                              */
+/*                                                               */
+/*   Comment:  VecPow(n, x, p, x) overwrites x.                  */
+/*             With SIMD, y[i] = exp(p * log(x[i])), whose       */
+/*             relative error includes that of rounding          */
+/*             p * log(x[i]), i.e., about |log(y[i])| ulp more   */
+/*             than pow.                                         */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     size_t    i;
+
+     if (VecSimdLevel() == SIMD_NONE)
+     {
+          for (i = 0; i < n; i++)
+               y[i] = pow(x[i], p);
+          return;
+     }
+
+     /* log(0) = -HUGE_VAL, and exp(-HUGE_VAL) = 0. */
+     VecLog(n, x, y);
+     for (i = 0; i < n; i++)
+          y[i] *= p;
+     VecExp(n, y, y);
+}
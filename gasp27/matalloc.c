@@ -43,9 +43,30 @@ void MatInit(int Shape, int Type, boolean Labelled, Matrix *M)
 
      M->Initialized = YES;
 
+     M->Storage    = MAT_COLUMNS;
+     M->LeadDim    = 0;
+     M->Block      = NULL;
+     M->BlockAlloc = NULL;
+
      M->Next = NULL;
 }
 
+/*******************************+++*******************************/
+void MatInitDense(int Shape, Matrix *M)
+/*****************************************************************/
+/*   Purpose:  Initialize an unlabelled REAL matrix as 0 x 0,    */
+/*             with MAT_DENSE storage.                           */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     MatInit(Shape, REAL, NO, M);
+
+     M->Storage = MAT_DENSE;
+}
+
 /*******************************+++*******************************/
 void MatReAllocate(size_t NewNumRows, size_t NewNumCols,
           const int *NewColType, Matrix *M)
@@ -66,7 +87,9 @@ void MatReAllocate(size_t NewNumRows, size_t NewNumCols,
 /*             Shape and Labelled cannot be changed.             */
 /*             Types of "old" columns cannot be changed.         */
 /*                                                               */
-/*   Version:  1995 March 9                                      */
+/*   2026.10.16: MAT_DENSE storage.                              */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
 /*****************************************************************/
 {
      size_t    j, NewLen, OldNumCols, OldNumRows;
@@ -77,8 +100,9 @@ void MatReAllocate(size_t NewNumRows, size_t NewNumCols,
      OldNumCols = MatNumCols(M);
 
      /* Free excess columns. */
-     for (j = NewNumCols; j < OldNumCols; j++)
-          MatColReAlloc(0, j, M);
+     if (MatStorage(M) == MAT_COLUMNS)
+          for (j = NewNumCols; j < OldNumCols; j++)
+               MatColReAlloc(0, j, M);
 
      if (NewNumCols != OldNumCols)
      {
@@ -111,11 +135,14 @@ void MatReAllocate(size_t NewNumRows, size_t NewNumCols,
      }
 
      /* Reallocate all surviving columns. */
-     for (j = 0; j < NewNumCols; j++)
-     {
-          NewLen = (M->Shape == RECT) ? NewNumRows : j + 1;
-          MatColReAlloc(NewLen, j, M);
-     }
+     if (MatStorage(M) == MAT_DENSE)
+          MatBlockReAlloc(NewNumRows, NewNumCols, M);
+     else
+          for (j = 0; j < NewNumCols; j++)
+          {
+               NewLen = (M->Shape == RECT) ? NewNumRows : j + 1;
+               MatColReAlloc(NewLen, j, M);
+          }
 
      if (MatLabelled(M))
      {
@@ -213,6 +240,76 @@ void MatColReAlloc(size_t NewLen, size_t j, Matrix *M)
      return;
 }
 
+/*******************************+++*******************************/
+void MatBlockReAlloc(size_t NewNumRows, size_t NewNumCols,
+          Matrix *M)
+/*****************************************************************/
+/*   Purpose:  For MatReAllocate, re-allocate the block of a     */
+/*             MAT_DENSE matrix, keeping the elements of the     */
+/*             surviving columns, and set the column pointers.   */
+/*                                                               */
+/*   Comment:  On entry, MatNumRows(M) and MatNumCols(M) are the */
+/*             old dimensions, and the column pointers for the   */
+/*             surviving columns still point into the old block. */
+/*             The leading dimension is NewNumRows rounded up to */
+/*             a multiple of MAT_ALIGN bytes, so every column is */
+/*             aligned.  New elements are zero.                  */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     real      *Block, *BlockAlloc;
+     size_t    Align, j, LeadDim, Len, NewLen;
+
+     CodeCheck(MatType(M) == REAL);
+
+     if (NewNumRows == MatNumRows(M) && NewNumCols == MatNumCols(M))
+          return;
+
+     /* Alignment in reals. */
+     Align = MAT_ALIGN / sizeof(real);
+
+     LeadDim = (M->Shape == RECT) ? NewNumRows
+               : max(NewNumRows, NewNumCols);
+     LeadDim = (LeadDim + Align - 1) / Align * Align;
+
+     if (LeadDim * NewNumCols > 0)
+     {
+          /* Over-allocate so that the block can start on a */
+          /* MAT_ALIGN boundary.                            */
+          BlockAlloc = AllocReal(LeadDim * NewNumCols + Align - 1,
+                    NULL);
+          Block = BlockAlloc + ((MAT_ALIGN - (size_t) BlockAlloc
+                    % MAT_ALIGN) % MAT_ALIGN) / sizeof(real);
+     }
+     else
+          Block = BlockAlloc = NULL;
+
+     for (j = 0; j < NewNumCols; j++)
+     {
+          if (j < MatNumCols(M))
+          {
+               /* Surviving column. */
+               NewLen = (M->Shape == RECT) ? NewNumRows : j + 1;
+               Len = min(MatColLen(M, j), NewLen);
+               VecCopy(M->Elem[j], Len, Block + j * LeadDim);
+          }
+
+          M->Elem[j] = Block + j * LeadDim;
+     }
+
+     if (M->BlockAlloc != NULL)
+          AllocFree(M->BlockAlloc);
+
+     M->LeadDim    = LeadDim;
+     M->Block      = Block;
+     M->BlockAlloc = BlockAlloc;
+
+     return;
+}
+
 /*******************************+++*******************************/
 size_t MatColumnAdd(const string ColName, int NewColType,
           Matrix *M)
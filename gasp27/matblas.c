@@ -25,13 +25,19 @@ real VecDotProd(size_t n, const real *a, const real *b)
 /* 1991.05.17: Created (as DotProd).                             */
 /* 1999.03.03: DotProd replaced by VecDotProd with reordering    */
 /*             of parameters.                                    */
+/* 2026.10.16: ddot for long vectors if LAPACK_DEFINED.          */
 /*                                                               */
-/* Version:    1999.03.03                                        */
+/* Version:    2026.10.16                                        */
 /*****************************************************************/
 {
      real      d;
      size_t    i;
 
+#ifdef LAPACK_DEFINED
+     if (n >= LAPACK_DOT_MIN)
+          return LapackDotProd(n, a, b);
+#endif
+
      for (d = 0.0, i = 0; i < n; i++)
           d += a[i] * b[i];
 
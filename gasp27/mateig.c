@@ -14,6 +14,8 @@
 #include "matrix.h"
 #include "lib.h"
 
+static void TriDiagReduce(matrix *S, real *d, real *e, matrix *Z);
+
 /*******************************+++*******************************/
 int MatEig(boolean SortValues, matrix *S, real *eVal, matrix *V)
 /*****************************************************************/
@@ -35,8 +37,11 @@ int MatEig(boolean SortValues, matrix *S, real *eVal, matrix *V)
 /*             must be allocated RECT.                           */
 /*                                                               */
 /* 1999.03.13: Created.                                          */
+/* 2026.10.16: dsyevd if LAPACK_DEFINED.                         */
+/* 2026.10.17: dsyevd only if V (and S) are MAT_DENSE; the code  */
+/*             below if dsyevd fails.                            */
 /*                                                               */
-/* Version:    1999.03.13                                        */
+/* Version:    2026.10.17                                        */
 /*****************************************************************/
 {
      int       ErrNum;
@@ -55,6 +60,14 @@ int MatEig(boolean SortValues, matrix *S, real *eVal, matrix *V)
           CodeCheck(n == MatNumRows(S) && n == MatNumCols(S))
      }
 
+#ifdef LAPACK_DEFINED
+     /* V is only written if dsyevd succeeds. */
+     if (MatStorage(V) == MAT_DENSE &&
+               (S == V || MatStorage(S) == MAT_DENSE) &&
+               LapackEig(SortValues, S, eVal, V) == OK)
+          return OK;
+#endif
+
      /* Workspace for subdiagonals of tridiagonal matrix. */
      w = AllocReal(n, NULL);
 
@@ -66,6 +79,72 @@ int MatEig(boolean SortValues, matrix *S, real *eVal, matrix *V)
      return ErrNum;
 }
 
+/*******************************+++*******************************/
+int MatEigProject(matrix *S, real *eVal, matrix *B)
+/*****************************************************************/
+/* Purpose:    Compute the eigenvalues, eVal, of symmetric       */
+/*             matrix S = V Diag(eVal) V', and overwrite B with  */
+/*             V'B, without forming the eigenvectors V.          */
+/*                                                               */
+/* Returns:    NUMERIC_ERR if MatEigTriDiag fails to converge;   */
+/*             OK          otherwise.                            */
+/*                                                               */
+/* Comments:   Calling routine must allocate space for eVal.     */
+/*             S and B must be allocated RECT, and B must have   */
+/*             the same number of rows as S.  S is overwritten;  */
+/*             only its upper triangle is used.                  */
+/*             The eigenvalues are not sorted.                   */
+/*             The Householder reflections reducing S to         */
+/*             tridiagonal form, Z T Z', are applied to B, and   */
+/*             the rotations of MatEigTriDiag to the rows of     */
+/*             B'Z; neither Z nor V is accumulated, which for B  */
+/*             with few columns saves about two thirds of the    */
+/*             work of MatEig.                                   */
+/*                                                               */
+/* 2026.10.17: Created.                                          */
+/*                                                               */
+/* Version:    2026.10.17                                        */
+/*****************************************************************/
+{
+     int       ErrNum;
+     matrix    Wt;
+     real      *w;
+     size_t    i, m, n, r;
+
+     CodeCheck(MatType(S) == REAL && MatType(B) == REAL);
+     CodeCheck(MatShape(S) == RECT && MatShape(B) == RECT);
+     n = MatNumRows(S);
+     m = MatNumCols(B);
+     CodeCheck(n == MatNumCols(S) && n == MatNumRows(B));
+
+     if (n == 0)
+          return OK;
+
+     /* Workspace for subdiagonals of tridiagonal matrix. */
+     w = AllocReal(n, NULL);
+
+     /* Wt will hold (Z'B)', then (V'B)'. */
+     MatAlloc(m, n, RECT, &Wt);
+
+     /* Overwrite B with Z'B. */
+     MatTriDiagProject(S, eVal, w, B);
+
+     for (r = 0; r < m; r++)
+          for (i = 0; i < n; i++)
+               MatPutElem(&Wt, r, i, MatElem(B, i, r));
+
+     ErrNum = MatEigTriDiag(NO, eVal, w, &Wt);
+
+     for (r = 0; r < m; r++)
+          for (i = 0; i < n; i++)
+               MatPutElem(B, i, r, MatElem(&Wt, r, i));
+
+     MatFree(&Wt);
+     AllocFree(w);
+
+     return ErrNum;
+}
+
 /*******************************+++*******************************/
 void MatTriDiag(matrix *S, real *d, real *e, matrix *Z)
 /*****************************************************************/
@@ -85,11 +164,12 @@ void MatTriDiag(matrix *S, real *d, real *e, matrix *Z)
 /*             Computation, Volume II, pp. 212--226.             */
 /*                                                               */
 /* 1999.03.20: Created.                                          */
+/* 2026.10.17: Reduction in TriDiagReduce.                       */
 /*                                                               */
-/* Version:    1999.03.20                                        */
+/* Version:    2026.10.17                                        */
 /*****************************************************************/
 {
-     real     f, g, h, scale;
+     real     g, h;
      real     *c;
      size_t   i, j, k, n;
 
@@ -108,6 +188,132 @@ void MatTriDiag(matrix *S, real *d, real *e, matrix *Z)
      if (n == 0)
           return;
 
+     TriDiagReduce(S, d, e, Z);
+
+     /* Accumulation of transformation matrices. */
+     for (i = 1; i < n; i++)
+     {
+          c = MatCol(Z, i - 1);
+          c[n-1] = c[i-1];
+          c[i-1] = 1.0;
+          h = d[i];
+
+          c = MatCol(Z, i);
+          
+          if (h != 0.0)
+          {
+               for (k = 0; k < i; k++)
+                    d[k] = c[k] / h;
+
+               for (j = 0; j < i; j++)
+               {
+                    g = VecDotProd(i, c, MatCol(Z, j));
+                    VecAddVec(-g, d, i, MatCol(Z, j));
+               }
+          }
+
+          VecInit(0.0, i, c);
+     }
+
+     for (i = 0; i < n; i++)
+     {
+          d[i] = MatElem(Z, n - 1, i);
+          MatPutElem(Z, n - 1, i, 0.0);
+     }
+
+     MatPutElem(Z, n - 1, n - 1, 1.0);
+     e[0] = 0.0;
+     
+     return;
+}
+
+/*******************************+++*******************************/
+void MatTriDiagProject(matrix *S, real *d, real *e, matrix *B)
+/*****************************************************************/
+/* Purpose:    Reduce a symmetric matrix S to Z T Z' as          */
+/*             MatTriDiag, but overwrite B with Z'B instead of   */
+/*             forming Z.                                        */
+/*                                                               */
+/* Comments:   Calling routine must allocate space for d and e.  */
+/*             S must be allocated RECT and is overwritten.  B   */
+/*             must be allocated RECT with the same number of    */
+/*             rows as S.                                        */
+/*                                                               */
+/* 2026.10.17: Created; dsytrd and dormtr if LAPACK_DEFINED.     */
+/* 2026.10.17: dsytrd and dormtr only if S and B are MAT_DENSE.  */
+/*                                                               */
+/* Version:    2026.10.17                                        */
+/*****************************************************************/
+{
+     real     g, h;
+     real     *Br, *u;
+     size_t   i, ii, m, n, r;
+
+     CodeCheck(MatType(S) == REAL && MatType(B) == REAL);
+     CodeCheck(MatShape(S) == RECT && MatShape(B) == RECT);
+     n = MatNumRows(S);
+     m = MatNumCols(B);
+     CodeCheck(n == MatNumCols(S) && n == MatNumRows(B));
+
+     if (n == 0)
+          return;
+
+#ifdef LAPACK_DEFINED
+     if (MatStorage(S) == MAT_DENSE && MatStorage(B) == MAT_DENSE)
+     {
+          LapackTriDiag(S, d, e, B);
+          return;
+     }
+#endif
+
+     TriDiagReduce(S, d, e, S);
+
+     /* Z = P[n-1] ... P[1], so P[n-1] is applied to B first. */
+     for (ii = 1; ii < n; ii++)
+     {
+          i = n - ii;
+          h = d[i];
+          if (h == 0.0)
+               continue;
+
+          u = MatCol(S, i);
+          for (r = 0; r < m; r++)
+          {
+               Br = MatCol(B, r);
+               g = VecDotProd(i, u, Br);
+               VecAddVec(-g / h, u, i, Br);
+          }
+     }
+
+     for (i = 0; i < n; i++)
+          d[i] = MatElem(S, i, i);
+     e[0] = 0.0;
+
+     return;
+}
+
+/*******************************+++*******************************/
+static void TriDiagReduce(matrix *S, real *d, real *e, matrix *Z)
+/*****************************************************************/
+/* Purpose:    The Householder reductions of MatTriDiag, without */
+/*             the accumulation of Z.                            */
+/*             On exit, the diagonals of T are on the diagonal   */
+/*             of Z, e[1],..., e[n-1] are the subdiagonals, and  */
+/*             for i > 0, column i of Z holds u in rows          */
+/*             0,..., i - 1 and d[i] holds h for the reflection  */
+/*             I - u u' / h (none if h is zero).                 */
+/*                                                               */
+/* 2026.10.17: Created from MatTriDiag.                          */
+/*                                                               */
+/* Version:    2026.10.17                                        */
+/*****************************************************************/
+{
+     real     f, g, h, scale;
+     real     *c;
+     size_t   i, j, k, n;
+
+     n = MatNumRows(Z);
+
      /* Copy *upper* triangle of S to *lower* triangle of Z; */
      /* i.e., copy columns of S to rows of Z.                */
      for (j = 0; j < n; j++)
@@ -185,40 +391,6 @@ void MatTriDiag(matrix *S, real *d, real *e, matrix *Z)
           d[i] = h;
      }
 
-     /* Accumulation of transformation matrices. */
-     for (i = 1; i < n; i++)
-     {
-          c = MatCol(Z, i - 1);
-          c[n-1] = c[i-1];
-          c[i-1] = 1.0;
-          h = d[i];
-
-          c = MatCol(Z, i);
-          
-          if (h != 0.0)
-          {
-               for (k = 0; k < i; k++)
-                    d[k] = c[k] / h;
-
-               for (j = 0; j < i; j++)
-               {
-                    g = VecDotProd(i, c, MatCol(Z, j));
-                    VecAddVec(-g, d, i, MatCol(Z, j));
-               }
-          }
-
-          VecInit(0.0, i, c);
-     }
-
-     for (i = 0; i < n; i++)
-     {
-          d[i] = MatElem(Z, n - 1, i);
-          MatPutElem(Z, n - 1, i, 0.0);
-     }
-
-     MatPutElem(Z, n - 1, n - 1, 1.0);
-     e[0] = 0.0;
-     
      return;
 }
 
@@ -242,6 +414,9 @@ int MatEigTriDiag(boolean SortValues, real *d, real *e, matrix *Z)
 /*             a symmetric matrix.  To obtain the eigenvectors   */
 /*             of a tridiagonal matrix, Z should be the identity */
 /*             on entry.                                         */
+/*             Z may have any number of rows; the rotations are  */
+/*             applied to its columns.  Thus, if Z is B'Z0 for   */
+/*             Z0 from MatTriDiag, Z is B'V on exit.             */
 /*                                                               */
 /* Returns:    NUMERIC_ERR if the algorithm failed to converge;  */
 /*             OK          otherwise.                            */
@@ -252,21 +427,22 @@ int MatEigTriDiag(boolean SortValues, real *d, real *e, matrix *Z)
 /*             Computation, Volume II, 241--248.                 */
 /*                                                               */
 /* 1999.03.30: Created.                                          */
+/* 2026.10.17: Z need not be square (MatEigProject).             */
 /*                                                               */
-/* Version:    1999.03.30                                        */
+/* Version:    2026.10.17                                        */
 /*****************************************************************/
 {
      boolean   Converged, Underflow;
      real      b, c, dd, f, g, p, r, s;
      real      *Zi, *Zi1;
      real      **ColPtr;
-     size_t    i, ii, iter, j, k, m, n;
+     size_t    i, ii, iter, j, k, m, n, nRows;
      size_t    *Index;
    
      CodeCheck(MatType(Z) == REAL);
      CodeCheck(MatShape(Z) == RECT);
-     n = MatNumRows(Z);
-     CodeCheck(n == MatNumCols(Z))
+     n     = MatNumCols(Z);
+     nRows = MatNumRows(Z);
 
      if (n <= 1)
           return OK;     
@@ -335,7 +511,7 @@ int MatEigTriDiag(boolean SortValues, real *d, real *e, matrix *Z)
                               /* Form eigenvector. */
                               Zi = MatCol(Z, i);
                               Zi1 = MatCol(Z, i + 1);
-                              for (k = 0; k < n; k++)
+                              for (k = 0; k < nRows; k++)
                               {
                                    f = Zi1[k];
                                    Zi1[k] = s * Zi[k] + c * f;
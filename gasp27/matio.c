@@ -16,6 +16,32 @@
 
 #define BETWEEN_SPACES   2
 
+/* Rows re-read at a time by MatWriteEnd. */
+#define ROWS_BLOCK       1024
+
+/* Line and rows read so far by MatReadStart and MatReadRows. */
+static string  RowsBuf  = NULL;
+static size_t  RowsRead = 0;
+
+/* Rows written so far by MatWriteRows, and what MatWrite would */
+/* need to know about them: the case-label width, and for each  */
+/* column whether it needs e conversions, and the widths and    */
+/* precisions under g (element 2 j) and e (2 j + 1) conversion. */
+static FILE    *RowsSpool = NULL;
+static size_t  RowsWritten, RowsCaseWidth;
+static boolean *RowsAnyE = NULL;
+static int     *RowsPrec = NULL;
+static size_t  *RowsWidth = NULL;
+
+static void MatWriteHead(Matrix *M, size_t CaseWidth,
+     size_t ColWidth, FILE *OutFile);
+static void MatWriteData(Matrix *M, size_t CaseWidth,
+     size_t ColWidth, const int *Precision, const char *Conversion,
+     FILE *OutFile);
+static size_t MatRealColWidth(const Matrix *M, size_t j,
+     char Conversion, int *Precision);
+static boolean MatRealColAnyE(const Matrix *M, size_t j);
+
 /*******************************+++*******************************/
 int MatRead(FILE *InpFile, int Type, Matrix *M)
 /*******************************+++*******************************/
@@ -194,6 +220,162 @@ int MatReadABlock(FILE *InpFile, int Type, Matrix *Block,
      return ErrNum;
 }
 
+/*******************************+++*******************************/
+int MatReadStart(FILE *InpFile, Matrix *M, boolean *CaseLabels)
+/*****************************************************************/
+/*   Purpose:  Start reading a REAL matrix from a file a few     */
+/*             rows at a time: read the description and column   */
+/*             labels into M, which has no rows.  The rows are   */
+/*             read by MatReadRows.                              */
+/*                                                               */
+/*   Returns:  OK or an error number.                            */
+/*                                                               */
+/*   Comment:  On return, *CaseLabels is YES if the rows have    */
+/*             case labels.                                      */
+/*             Only one matrix at a time can be read this way.   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    NumCols;
+     string    Buf, Token;
+
+     MatInit(RECT, REAL, YES, M);
+
+     /* Get matrix name. */
+     while ( (Buf = BufRead(InpFile)) != NULL &&
+               strstr(Buf, "---") == NULL &&
+               strstr(Buf, "___") == NULL)
+          MatPutText(M, StrCatAlloc(MatText(M), Buf));
+
+     if (Buf == NULL)
+     {
+          Error("Found nothing following the description.\n");
+          return INPUT_ERR;
+     }
+
+     /* Column labels, as in MatReadABlock. */
+     Buf = BufRead(InpFile);
+
+     if (stricmp(Token = BufForceTok(InpFile, &Buf), "Case") == 0)
+     {
+          *CaseLabels = YES;
+          Token = BufForceTok(InpFile, &Buf);
+     }
+     else
+          *CaseLabels = NO;
+
+     NumCols = 0;
+     while (Token != NULL && strstr(Token, "---") == NULL
+               && strstr(Token, "___") == NULL)
+     {
+          MatReAllocate(0, NumCols + 1, NULL, M);
+          MatPutColName(M, NumCols, Token);
+          NumCols++;
+          Token = BufForceTok(InpFile, &Buf);
+     }
+
+     if (Token == NULL)
+     {
+          Error("Column labels should terminate with a line "
+                    "containing \"---\" or \"___\".\n");
+          MatFree(M);
+          return INPUT_ERR;
+     }
+
+     /* Start a new line for the data. */
+     RowsBuf  = BufRead(InpFile);
+     RowsRead = 0;
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+int MatReadRows(FILE *InpFile, boolean CaseLabels, size_t MaxRows,
+     Matrix *M, boolean *Finished)
+/*****************************************************************/
+/*   Purpose:  Read up to MaxRows further rows of the matrix     */
+/*             started by MatReadStart, replacing the rows of M. */
+/*                                                               */
+/*   Returns:  OK or an error number.                            */
+/*                                                               */
+/*   Comment:  On return, *Finished is YES if there are no more  */
+/*             rows.  Rows without case labels are labelled by   */
+/*             their row number in the file.  A second block of  */
+/*             columns (see MatWriteBlock) is an error.          */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int       ErrNum;
+     real      r;
+     size_t    i, j, NumCols;
+     string    Token;
+
+     NumCols = MatNumCols(M);
+     MatReAllocate(0, NumCols, NULL, M);
+
+     ErrNum = OK;
+     Token  = NULL;
+     i = 0;
+     j = 0;
+     while (NumCols > 0 && i < MaxRows &&
+               (Token = BufForceTok(InpFile, &RowsBuf)) != NULL)
+     {
+          if (strstr(Token, "---") != NULL ||
+                    strstr(Token, "___") != NULL)
+          {
+               Error("Only a matrix with one block of columns can "
+                         "be read a few rows at a time.\n");
+               ErrNum = INPUT_ERR;
+               break;
+          }
+
+          if (j == 0 && i % ROW_ALLOC == 0)
+               MatReAllocate(i + ROW_ALLOC, NumCols, NULL, M);
+
+          if (j == 0 && CaseLabels)
+               MatPutRowName(M, i, Token);
+          else if (StrToReal(Token, &r) != OK)
+          {
+               Error("\"%s\" at row %d, column \"%s\" should "
+                         "be a (real) number.\n", Token,
+                         (int) (RowsRead + i + 1),
+                         MatColName(M, j - CaseLabels));
+               ErrNum = INPUT_ERR;
+               break;
+          }
+          else
+               MatPutElem(M, i, j - CaseLabels, r);
+
+          if (++j == NumCols + CaseLabels)
+          {
+               if (!CaseLabels)
+                    MatPutRowName(M, i, StrFromSize_t(RowsRead + i + 1));
+               i++;
+               j = 0;
+          }
+     }
+
+     if (ErrNum == OK && j != 0)
+     {
+          Error("Row %d is incomplete.\n", (int) (RowsRead + i + 1));
+          ErrNum = INPUT_ERR;
+     }
+
+     *Finished = (NumCols == 0 || Token == NULL) ? YES : NO;
+
+     /* Reallocate for actual number of rows. */
+     MatReAllocate((ErrNum == OK) ? i : 0, NumCols, NULL, M);
+     RowsRead += i;
+
+     return ErrNum;
+}
+
 /*******************************+++*******************************/
 void MatWrite(Matrix *M, FILE *OutFile)
 /*****************************************************************/
@@ -203,23 +385,19 @@ void MatWrite(Matrix *M, FILE *OutFile)
 /*             A matrix row may be written on several output     */
 /*             lines.  Use MatWriteBlock() for "nice" output.    */
 /*                                                               */
-/*   Version:  1995 October 25                                   */
+/*   2026.10.17: Header and rows written by MatWriteHead and     */
+/*               MatWriteData.                                   */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
      boolean   RightAdj;
      char      *Conversion;
      int       *Precision;
-     size_t    CaseWidth, ColsPerLine, ColWidth, i, j;
-     size_t    LineWidth, MaxColWidth, NumCols, NumRows;
-     string    *ColName, s;
+     size_t    CaseWidth, ColWidth, j;
+     size_t    MaxColWidth, NumCols;
 
-     NumRows = MatNumRows(M);
      NumCols = MatNumCols(M);
-     ColName = MatColNames(M);
-
-     /* Output the text. */
-     FileOutput(OutFile, "%s", (MatText(M) != NULL) ? MatText(M) :
-               "Unnamed matrix.\n\n");
 
      /* Column width for case labels. */
      CaseWidth = MatCaseWidth(M, &RightAdj);
@@ -234,9 +412,256 @@ void MatWrite(Matrix *M, FILE *OutFile)
           MaxColWidth = max(ColWidth + BETWEEN_SPACES, MaxColWidth);
      }
 
+     MatWriteHead(M, CaseWidth, MaxColWidth, OutFile);
+     MatWriteData(M, CaseWidth, MaxColWidth, Precision, Conversion,
+               OutFile);
+
+     AllocFree(Conversion);
+     AllocFree(Precision);
+
+     return;
+}
+
+/*******************************+++*******************************/
+int MatWriteStart(Matrix *M)
+/*****************************************************************/
+/*   Purpose:  Start writing a matrix a few rows at a time: the  */
+/*             rows are given to MatWriteRows, and MatWriteEnd   */
+/*             writes the file.                                  */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*                                                               */
+/*   Comment:  The file is exactly as MatWrite would write M     */
+/*             with all the rows, whose widths and precisions    */
+/*             depend on every row.  Meanwhile the rows are kept */
+/*             in a temporary binary file, so memory does not    */
+/*             grow with their number.  M must have only REAL    */
+/*             columns.                                          */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: Nothing written until MatWriteEnd, so that the  */
+/*               format is MatWrite's.                           */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    j, NumCols;
+
+     NumCols = MatNumCols(M);
+
+     if ( (RowsSpool = tmpfile()) == NULL)
+     {
+          Error("Cannot open a temporary file.\n");
+          return FILE_ERR;
+     }
+
+     RowsWritten   = 0;
+     RowsCaseWidth = strlen("Case");
+
+     RowsAnyE  = (boolean *) AllocGeneric(NumCols, sizeof(boolean),
+               NULL);
+     RowsPrec  = AllocInt(2 * NumCols, NULL);
+     RowsWidth = AllocSize_t(2 * NumCols, NULL);
+     for (j = 0; j < NumCols; j++)
+     {
+          CodeCheck(MatColType(M, j) == REAL);
+          RowsAnyE[j] = NO;
+     }
+     for (j = 0; j < 2 * NumCols; j++)
+     {
+          RowsPrec[j]  = 0;
+          RowsWidth[j] = 0;
+     }
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+int MatWriteRows(Matrix *M)
+/*****************************************************************/
+/*   Purpose:  Add the rows of M to the matrix started by        */
+/*             MatWriteStart with the same columns.              */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*   2026.10.17: Rows kept for MatWriteEnd.                      */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int       Prec;
+     real      *Row;
+     size_t    i, j, Len, NumCols, Width;
+     string    Name;
+
+     NumCols = MatNumCols(M);
+
+     /* The widths and precisions MatColWidth would find. */
+     for (j = 0; j < NumCols; j++)
+     {
+          if (!RowsAnyE[j])
+               RowsAnyE[j] = MatRealColAnyE(M, j);
+
+          Width = MatRealColWidth(M, j, 'g', &Prec);
+          RowsWidth[2*j] = max(Width, RowsWidth[2*j]);
+          RowsPrec[2*j]  = max(Prec, RowsPrec[2*j]);
+
+          Width = MatRealColWidth(M, j, 'e', &Prec);
+          RowsWidth[2*j+1] = max(Width, RowsWidth[2*j+1]);
+          RowsPrec[2*j+1]  = max(Prec, RowsPrec[2*j+1]);
+     }
+
+     /* Each row: length of the name, the name, the reals. */
+     Row = AllocReal(NumCols, NULL);
+     for (i = 0; i < MatNumRows(M); i++)
+     {
+          Name = MatRowName(M, i);
+          Len  = strlen(Name);
+          RowsCaseWidth = max(Len, RowsCaseWidth);
+
+          MatRow(M, i, Row);
+          if (fwrite(&Len, sizeof(size_t), 1, RowsSpool) != 1 ||
+                    fwrite(Name, 1, Len, RowsSpool) != Len ||
+                    fwrite(Row, sizeof(real), NumCols, RowsSpool)
+                         != NumCols)
+          {
+               AllocFree(Row);
+               Error("Cannot write to a temporary file.\n");
+               return FILE_ERR;
+          }
+     }
+     AllocFree(Row);
+
+     RowsWritten += MatNumRows(M);
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+int MatWriteEnd(Matrix *M, FILE *OutFile)
+/*****************************************************************/
+/*   Purpose:  Write the matrix started by MatWriteStart, with   */
+/*             the text and columns of M and the rows given to   */
+/*             MatWriteRows, to OutFile as MatWrite would.       */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     char      *Conversion;
+     int       ErrNum, *Precision;
+     Matrix    Block;
+     real      *Row;
+     size_t    c, i, i0, j, Len, m, MaxColWidth, NumCols;
+     string    Name;
+
+     NumCols = MatNumCols(M);
+
+     /* As MatColWidth for all the rows. */
+     Conversion = AllocChar(NumCols, NULL);
+     Precision  = AllocInt(NumCols, NULL);
+     for (MaxColWidth = 0, j = 0; j < NumCols; j++)
+     {
+          c = (RowsAnyE[j]) ? 2 * j + 1 : 2 * j;
+          Conversion[j] = (RowsAnyE[j]) ? 'e' : 'f';
+          Precision[j]  = RowsPrec[c];
+          MaxColWidth = max(max(RowsWidth[c] + (size_t) RowsPrec[c],
+                    strlen(MatColName(M, j))) + BETWEEN_SPACES,
+                    MaxColWidth);
+     }
+
+     MatWriteHead(M, RowsCaseWidth, MaxColWidth, OutFile);
+
+     /* The rows, ROWS_BLOCK at a time. */
+     ErrNum = OK;
+     rewind(RowsSpool);
+     MatInit(RECT, REAL, YES, &Block);
+     Row  = AllocReal(NumCols, NULL);
+     Name = NULL;
+     for (i0 = 0; i0 < RowsWritten && ErrNum == OK; i0 += m)
+     {
+          m = min(ROWS_BLOCK, RowsWritten - i0);
+          MatReAlloc(m, NumCols, &Block);
+
+          for (i = 0; i < m; i++)
+          {
+               if (fread(&Len, sizeof(size_t), 1, RowsSpool) != 1)
+               {
+                    ErrNum = FILE_ERR;
+                    break;
+               }
+               Name = AllocChar(Len + 1, Name);
+               if (fread(Name, 1, Len, RowsSpool) != Len ||
+                         fread(Row, sizeof(real), NumCols, RowsSpool)
+                         != NumCols)
+               {
+                    ErrNum = FILE_ERR;
+                    break;
+               }
+               Name[Len] = NULL;
+
+               MatPutRowName(&Block, i, Name);
+               for (j = 0; j < NumCols; j++)
+                    MatPutElem(&Block, i, j, Row[j]);
+          }
+
+          if (ErrNum == OK)
+               MatWriteData(&Block, RowsCaseWidth, MaxColWidth,
+                         Precision, Conversion, OutFile);
+          else
+               Error("Cannot read a temporary file.\n");
+
+          /* Free the row labels newest first (see AllocStrFree). */
+          MatReAlloc(0, NumCols, &Block);
+     }
+
+     MatFree(&Block);
+     AllocFree(Name);
+     AllocFree(Row);
+     AllocFree(Conversion);
+     AllocFree(Precision);
+
+     fclose(RowsSpool);
+     RowsSpool = NULL;
+     AllocFree(RowsAnyE);
+     AllocFree(RowsPrec);
+     AllocFree(RowsWidth);
+     RowsAnyE  = NULL;
+     RowsPrec  = NULL;
+     RowsWidth = NULL;
+
+     return ErrNum;
+}
+
+/*******************************+++*******************************/
+static void MatWriteHead(Matrix *M, size_t CaseWidth,
+     size_t ColWidth, FILE *OutFile)
+/*****************************************************************/
+/*   Purpose:  Write the text and column labels of M for         */
+/*             MatWrite, with ColWidth characters per column.    */
+/*                                                               */
+/*   2026.10.17: Created from MatWrite.                          */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    ColsPerLine, j, LineWidth, NumCols;
+     string    *ColName;
+
+     NumCols = MatNumCols(M);
+     ColName = MatColNames(M);
+
+     /* Output the text. */
+     FileOutput(OutFile, "%s", (MatText(M) != NULL) ? MatText(M) :
+               "Unnamed matrix.\n\n");
+
      /* Always output at least one column per line. */
-     ColsPerLine = max(1, (OUTPUT_COLS - CaseWidth) / MaxColWidth);
-     LineWidth = CaseWidth + min(NumCols, ColsPerLine) * MaxColWidth;
+     ColsPerLine = max(1, (OUTPUT_COLS - CaseWidth) / ColWidth);
+     LineWidth = CaseWidth + min(NumCols, ColsPerLine) * ColWidth;
 
      /* Output "Case" and column names. */
 
@@ -249,13 +674,35 @@ void MatWrite(Matrix *M, FILE *OutFile)
      {
           if (j % ColsPerLine == 0 && j != 0)
                FileOutput(OutFile, "\n%*s", (int) CaseWidth, "");
-          FileOutput(OutFile, "%*s", (int) MaxColWidth, ColName[j]);
+          FileOutput(OutFile, "%*s", (int) ColWidth, ColName[j]);
      }
      FileOutput(OutFile, "\n");
 
      for (j = 0; j < LineWidth; j++)
           FileOutput(OutFile, "-");
      FileOutput(OutFile, "\n\n");
+}
+
+/*******************************+++*******************************/
+static void MatWriteData(Matrix *M, size_t CaseWidth,
+     size_t ColWidth, const int *Precision, const char *Conversion,
+     FILE *OutFile)
+/*****************************************************************/
+/*   Purpose:  Write the rows of M for MatWrite, with ColWidth   */
+/*             characters per column.                            */
+/*                                                               */
+/*   2026.10.17: Created from MatWrite.                          */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    ColsPerLine, i, j, NumCols, NumRows;
+     string    s;
+
+     NumRows = MatNumRows(M);
+     NumCols = MatNumCols(M);
+
+     ColsPerLine = max(1, (OUTPUT_COLS - CaseWidth) / ColWidth);
 
      /* Output the data. */
      for (i = 0; i < NumRows; i++)
@@ -270,15 +717,10 @@ void MatWrite(Matrix *M, FILE *OutFile)
 
                s = MatElemToStr(M, i, j, Precision[j],
                          Conversion[j]);
-               FileOutput(OutFile, "%*s", (int) MaxColWidth, s);
+               FileOutput(OutFile, "%*s", (int) ColWidth, s);
           }
           FileOutput(OutFile, "\n");
      }
-
-     AllocFree(Conversion);
-     AllocFree(Precision);
-
-     return;
 }
 
 /*******************************+++*******************************/
@@ -396,73 +838,23 @@ size_t MatColWidth(const Matrix *M, size_t j, int *Precision,
 /*             does not lose accuracy, and *Conversion will be   */
 /*             'e' or 'f'.                                       */
 /*                                                               */
-/*   Version:  1995 October 25                                   */
+/*   2026.10.17: Real columns by MatRealColAnyE and              */
+/*               MatRealColWidth, which MatWriteRows also uses.  */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
-     size_t    ExponLen, i, Width;
-     string    DecPoint, Expon, s, StrEnd;
+     size_t    i, Width;
 
      Width = 0;
 
      if (MatColType(M, j) == REAL)
      {
-          *Conversion = 'g';
-          *Precision = 0;
-
           /* Are there any e conversions? */
-          for (i = 0; i < MatNumRows(M); i++)
-               if (strchr(StrFromReal(MatElem(M, i, j), "",
-                         PRECISION, 'g'), 'e') != NULL)
-               {
-                    *Conversion = 'e';
-                    break;
-               }
+          *Conversion = (MatRealColAnyE(M, j)) ? 'e' : 'g';
 
-          for (i = 0; i < MatNumRows(M); i++)
-          {
-               /* Conversion is either e or g (not f) to maintain */
-               /* the minimum number of significant digits.       */
-               s = StrFromReal(MatElem(M, i, j), "#",
-                         PRECISION, *Conversion);
-
-               if (stricmp(s, NOT_AVAIL) == 0)
-                    Width = max(strlen(s), Width);
-               else
-               {
-                    ExponLen = 0;
-                    if ( (Expon = strchr(s, 'e')) != NULL)
-                    {
-                         ExponLen = strlen(Expon);
-
-                         /* Delete exponent part of string. */
-                         *Expon = NULL;
-                    }
-
-                    /* Find decimal point.  This assumes that the */
-                    /* real has been converted to a string with a */
-                    /* # flag, so that '.' is  always present.    */
-                    DecPoint = strchr(s, '.');
-                    CodeCheck(DecPoint != NULL);
-
-                    /* Delete trailing zeros to get precision. */
-                    StrEnd = s + strlen(s) - 1;
-                    while (StrEnd > DecPoint && *StrEnd == '0')
-                         *StrEnd-- = NULL;
-                    *Precision = max(StrEnd - DecPoint, *Precision);
-
-                    /* Delete digits after decimal point;        */
-                    /* if none, delete the decimal point itself. */
-                    if (StrEnd == DecPoint)
-                         *DecPoint = NULL;
-                    else
-                         *(DecPoint + 1) = NULL;
-
-                    /* Everything but precision. */
-                    Width = max(strlen(s) + ExponLen, Width);
-               }
-          }
-
-          Width += (size_t) *Precision;
+          Width = MatRealColWidth(M, j, *Conversion, Precision)
+                    + (size_t) *Precision;
           if (*Conversion == 'g')
                *Conversion = 'f';
      }
@@ -476,6 +868,92 @@ size_t MatColWidth(const Matrix *M, size_t j, int *Precision,
      return Width;
 }
 
+/*******************************+++*******************************/
+static boolean MatRealColAnyE(const Matrix *M, size_t j)
+/*****************************************************************/
+/*   Purpose:  Does any element of real column j of M need an e  */
+/*             conversion with PRECISION significant digits?     */
+/*                                                               */
+/*   2026.10.17: Created from MatColWidth.                       */
+/*****************************************************************/
+{
+     size_t    i;
+
+     for (i = 0; i < MatNumRows(M); i++)
+          if (strchr(StrFromReal(MatElem(M, i, j), "", PRECISION,
+                    'g'), 'e') != NULL)
+               return YES;
+
+     return NO;
+}
+
+/*******************************+++*******************************/
+static size_t MatRealColWidth(const Matrix *M, size_t j,
+     char Conversion, int *Precision)
+/*****************************************************************/
+/*   Purpose:  For real column j of M and Conversion 'e' or 'g', */
+/*             return the width needed, apart from the digits    */
+/*             after the decimal point, and put the number of    */
+/*             those digits in *Precision.                       */
+/*                                                               */
+/*   Comment:  Over several blocks of rows, the maxima of the    */
+/*             two results are those for all the rows.           */
+/*                                                               */
+/*   2026.10.17: Created from MatColWidth.                       */
+/*****************************************************************/
+{
+     size_t    ExponLen, i, Width;
+     string    DecPoint, Expon, s, StrEnd;
+
+     Width = 0;
+     *Precision = 0;
+
+     for (i = 0; i < MatNumRows(M); i++)
+     {
+          /* Conversion is either e or g (not f) to maintain */
+          /* the minimum number of significant digits.       */
+          s = StrFromReal(MatElem(M, i, j), "#", PRECISION, Conversion);
+
+          if (stricmp(s, NOT_AVAIL) == 0)
+               Width = max(strlen(s), Width);
+          else
+          {
+               ExponLen = 0;
+               if ( (Expon = strchr(s, 'e')) != NULL)
+               {
+                    ExponLen = strlen(Expon);
+
+                    /* Delete exponent part of string. */
+                    *Expon = NULL;
+               }
+
+               /* Find decimal point.  This assumes that the */
+               /* real has been converted to a string with a */
+               /* # flag, so that '.' is  always present.    */
+               DecPoint = strchr(s, '.');
+               CodeCheck(DecPoint != NULL);
+
+               /* Delete trailing zeros to get precision. */
+               StrEnd = s + strlen(s) - 1;
+               while (StrEnd > DecPoint && *StrEnd == '0')
+                    *StrEnd-- = NULL;
+               *Precision = max(StrEnd - DecPoint, *Precision);
+
+               /* Delete digits after decimal point;        */
+               /* if none, delete the decimal point itself. */
+               if (StrEnd == DecPoint)
+                    *DecPoint = NULL;
+               else
+                    *(DecPoint + 1) = NULL;
+
+               /* Everything but precision. */
+               Width = max(strlen(s) + ExponLen, Width);
+          }
+     }
+
+     return Width;
+}
+
 /*******************************+++*******************************/
 size_t MatCaseWidth(const Matrix *M, boolean *RightAdj)
 /*****************************************************************/
@@ -0,0 +1,596 @@
+/*****************************************************************/
+/*   BLAS/LAPACK BACKEND FOR THE MATRIX ROUTINES                 */
+/*                                                               */
+/*   Compiled only if LAPACK_DEFINED (see gaspunix.mak).  The    */
+/*   routines in matblas.c, mattri.c, matqr.c, etc. call these   */
+/*   when the matrices have MAT_DENSE storage, and otherwise     */
+/*   (or if these fail) use their own C code.                    */
+/*****************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "define.h"
+#include "implem.h"
+#include "matrix.h"
+#include "lib.h"
+
+#ifdef LAPACK_DEFINED
+
+/* Fortran BLAS/LAPACK (trailing arguments are the lengths of */
+/* character arguments).                                      */
+extern double ddot_(const int *n, const double *x, const int *incx,
+          const double *y, const int *incy);
+extern void dgemv_(const char *trans, const int *m, const int *n,
+          const double *alpha, const double *a, const int *lda,
+          const double *x, const int *incx, const double *beta,
+          double *y, const int *incy, size_t);
+extern void dgemm_(const char *transa, const char *transb,
+          const int *m, const int *n, const int *k,
+          const double *alpha, const double *a, const int *lda,
+          const double *b, const int *ldb, const double *beta,
+          double *c, const int *ldc, size_t, size_t);
+extern void dtrsv_(const char *uplo, const char *trans,
+          const char *diag, const int *n, const double *a,
+          const int *lda, double *x, const int *incx, size_t,
+          size_t, size_t);
+extern void dtrsm_(const char *side, const char *uplo,
+          const char *transa, const char *diag, const int *m,
+          const int *n, const double *alpha, const double *a,
+          const int *lda, double *b, const int *ldb, size_t,
+          size_t, size_t, size_t);
+extern void dpotrf_(const char *uplo, const int *n, double *a,
+          const int *lda, int *info, size_t);
+extern void dpotri_(const char *uplo, const int *n, double *a,
+          const int *lda, int *info, size_t);
+extern void dgeqrf_(const int *m, const int *n, double *a,
+          const int *lda, double *tau, double *work,
+          const int *lwork, int *info);
+extern void dormqr_(const char *side, const char *trans,
+          const int *m, const int *n, const int *k, const double *a,
+          const int *lda, const double *tau, double *c,
+          const int *ldc, double *work, const int *lwork, int *info,
+          size_t, size_t);
+extern void dorgqr_(const int *m, const int *n, const int *k,
+          double *a, const int *lda, const double *tau, double *work,
+          const int *lwork, int *info);
+extern void dsyevd_(const char *jobz, const char *uplo, const int *n,
+          double *a, const int *lda, double *w, double *work,
+          const int *lwork, int *iwork, const int *liwork,
+          int *info, size_t, size_t);
+extern void dsytrd_(const char *uplo, const int *n, double *a,
+          const int *lda, double *d, double *e, double *tau,
+          double *work, const int *lwork, int *info, size_t);
+extern void dormtr_(const char *side, const char *uplo,
+          const char *trans, const int *m, const int *n,
+          const double *a, const int *lda, const double *tau,
+          double *c, const int *ldc, double *work, const int *lwork,
+          int *info, size_t, size_t, size_t);
+
+/*******************************+++*******************************/
+real LapackDotProd(size_t n, const real *a, const real *b)
+/*****************************************************************/
+/*   Purpose:  Return a[0] * b[0] + ... + a[n-1] * b[n-1]        */
+/*             (ddot).                                           */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int  nn, One;
+
+     nn  = (int) n;
+     One = 1;
+
+     return ddot_(&nn, a, &One, b, &One);
+}
+
+/*******************************+++*******************************/
+int LapackMatVec(const Matrix *M, const real *x, real *y)
+/*****************************************************************/
+/*   Purpose:  Compute y = M'x (dgemv) for a RECT MAT_DENSE      */
+/*             matrix.                                           */
+/*                                                               */
+/*   Returns:  INPUT_ERR if M is not RECT and MAT_DENSE (y is    */
+/*                       unchanged);                             */
+/*             OK        otherwise.                              */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int       m, n, lda, One;
+     real      Alpha, Beta;
+
+     if (MatStorage(M) != MAT_DENSE || MatShape(M) != RECT)
+          return INPUT_ERR;
+
+     m   = (int) MatNumRows(M);
+     n   = (int) MatNumCols(M);
+     lda = (int) max(MatLeadDim(M), 1);
+     One = 1;
+     Alpha = 1.0;
+     Beta  = 0.0;
+
+     if (m == 0)
+          VecInit(0.0, (size_t) n, y);
+     else if (n > 0)
+          dgemv_("T", &m, &n, &Alpha, MatBlock(M), &lda, x, &One,
+                    &Beta, y, &One, 1);
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+int LapackTMult(const Matrix *A, const Matrix *B, Matrix *C)
+/*****************************************************************/
+/*   Purpose:  Compute C = A'B (dgemm) for RECT MAT_DENSE A, B,  */
+/*             and C.                                            */
+/*                                                               */
+/*   Returns:  INPUT_ERR if A, B, or C is not RECT and MAT_DENSE */
+/*                       (C is unchanged);                       */
+/*             OK        otherwise.                              */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int       k, lda, ldb, ldc, m, n;
+     real      Alpha, Beta;
+
+     if (MatStorage(A) != MAT_DENSE || MatShape(A) != RECT
+               || MatStorage(B) != MAT_DENSE || MatShape(B) != RECT
+               || MatStorage(C) != MAT_DENSE || MatShape(C) != RECT)
+          return INPUT_ERR;
+
+     m   = (int) MatNumCols(A);
+     n   = (int) MatNumCols(B);
+     k   = (int) MatNumRows(A);
+     lda = (int) max(MatLeadDim(A), 1);
+     ldb = (int) max(MatLeadDim(B), 1);
+     ldc = (int) max(MatLeadDim(C), 1);
+     Alpha = 1.0;
+     Beta  = 0.0;
+
+     if (m > 0 && n > 0)
+          dgemm_("T", "N", &m, &n, &k, &Alpha, MatBlock(A), &lda,
+                    MatBlock(B), &ldb, &Beta, MatBlock(C), &ldc, 1,
+                    1);
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+int LapackCholesky(const Matrix *S, Matrix *R)
+/*****************************************************************/
+/*   Purpose:  Cholesky decomposition R'R of symmetric matrix S  */
+/*             (dpotrf) for a MAT_DENSE R.                       */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if S is not positive definite; the    */
+/*                         upper triangle of R is then a copy of */
+/*                         S (which is unchanged), so that       */
+/*                         TriCholesky can complete the          */
+/*                         rank-deficient decomposition;         */
+/*             OK          otherwise.                            */
+/*                                                               */
+/*   Comment:  The strictly lower triangle of R (unused by an    */
+/*             UP_TRIANG matrix) keeps a copy of S meanwhile.    */
+/*             S may be R.                                       */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int       info, lda, n;
+     real      *a;
+     size_t    i, j, nn;
+
+     CodeCheck(MatStorage(R) == MAT_DENSE);
+
+     nn = MatNumCols(S);
+     R->Shape = UP_TRIANG;
+
+     if (nn == 0)
+          return OK;
+
+     a   = MatBlock(R);
+     lda = (int) MatLeadDim(R);
+     n   = (int) nn;
+
+     /* Copy S to the upper triangle of R, and save the */
+     /* off-diagonal elements in the lower triangle.    */
+     for (j = 0; j < nn; j++)
+          for (i = 0; i <= j; i++)
+          {
+               a[i + j * lda] = MatElem(S, i, j);
+               a[j + i * lda] = a[i + j * lda];
+          }
+
+     dpotrf_("U", &n, a, &lda, &info, 1);
+
+     if (info == 0)
+          return OK;
+
+     /* Restore the upper triangle from the copy. */
+     for (j = 0; j < nn; j++)
+          for (i = 0; i <= j; i++)
+               a[i + j * lda] = a[j + i * lda];
+
+     return NUMERIC_ERR;
+}
+
+/*******************************+++*******************************/
+int LapackCholInverse(const Matrix *R, Matrix *S)
+/*****************************************************************/
+/*   Purpose:  Upper triangle of S = Inverse(R'R) (dpotri) for   */
+/*             an UP_TRIANG R and a MAT_DENSE S.                 */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if S is not MAT_DENSE or R is         */
+/*                         singular (S is then unchanged unless  */
+/*                         it is R);                             */
+/*             OK          otherwise.                            */
+/*                                                               */
+/*   Comment:  S may be R.                                       */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int       info, lda, n;
+     real      *a;
+     size_t    j, nn;
+
+     if (MatStorage(S) != MAT_DENSE)
+          return NUMERIC_ERR;
+
+     nn = MatNumCols(R);
+
+     for (j = 0; j < nn; j++)
+          if (MatElem(R, j, j) == 0.0)
+               return NUMERIC_ERR;
+
+     if (nn == 0)
+          return OK;
+
+     if (S != R)
+          for (j = 0; j < nn; j++)
+               VecCopy(MatCol(R, j), j + 1, MatCol(S, j));
+     S->Shape = UP_TRIANG;
+
+     a   = MatBlock(S);
+     lda = (int) MatLeadDim(S);
+     n   = (int) nn;
+
+     dpotri_("U", &n, a, &lda, &info, 1);
+
+     return (info == 0) ? OK : NUMERIC_ERR;
+}
+
+/*******************************+++*******************************/
+int LapackTriSolve(const Matrix *R, boolean Trans, const real *b,
+          real *x)
+/*****************************************************************/
+/*   Purpose:  Solve R'x = b (Trans = YES) or R x = b (dtrsv)    */
+/*             for an UP_TRIANG MAT_DENSE R.                     */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if R is not MAT_DENSE or has a zero   */
+/*                         diagonal element (x is unchanged);    */
+/*             OK          otherwise.                            */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int       lda, n, One;
+     size_t    j;
+
+     if (MatStorage(R) != MAT_DENSE)
+          return NUMERIC_ERR;
+
+     for (j = 0; j < MatNumCols(R); j++)
+          if (MatElem(R, j, j) == 0.0)
+               return NUMERIC_ERR;
+
+     n   = (int) MatNumCols(R);
+     lda = (int) max(MatLeadDim(R), 1);
+     One = 1;
+
+     if (x != b)
+          VecCopy(b, (size_t) n, x);
+
+     if (n > 0)
+          dtrsv_("U", (Trans) ? "T" : "N", "N", &n, MatBlock(R),
+                    &lda, x, &One, 1, 1, 1);
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+int LapackTriSolveMat(const Matrix *R, Matrix *X)
+/*****************************************************************/
+/*   Purpose:  Overwrite X with the solution of R'X = X (dtrsm)  */
+/*             for an UP_TRIANG R and RECT X, both MAT_DENSE.    */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if R or X is not MAT_DENSE, X does    */
+/*                         not have as many rows as R, or R has  */
+/*                         a zero diagonal element (X is         */
+/*                         unchanged);                           */
+/*             OK          otherwise.                            */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int       lda, ldb, m, n;
+     real      Alpha;
+     size_t    j;
+
+     if (MatStorage(R) != MAT_DENSE || MatStorage(X) != MAT_DENSE
+               || MatNumRows(X) != MatNumCols(R))
+          return NUMERIC_ERR;
+
+     for (j = 0; j < MatNumCols(R); j++)
+          if (MatElem(R, j, j) == 0.0)
+               return NUMERIC_ERR;
+
+     m   = (int) MatNumRows(X);
+     n   = (int) MatNumCols(X);
+     lda = (int) max(MatLeadDim(R), 1);
+     ldb = (int) max(MatLeadDim(X), 1);
+     Alpha = 1.0;
+
+     if (m > 0 && n > 0)
+          dtrsm_("L", "U", "T", "N", &m, &n, &Alpha, MatBlock(R),
+                    &lda, MatBlock(X), &ldb, 1, 1, 1, 1);
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+size_t LapackQRLS(const Matrix *F, const real *y, Matrix *Q,
+          Matrix *R, real *c, real *res)
+/*****************************************************************/
+/*   Purpose:  As QRLS, but by Householder reflections (dgeqrf,  */
+/*             dormqr, dorgqr) for a MAT_DENSE Q.                */
+/*                                                               */
+/*   Returns:  j + 1 if R[j, j] is zero;                         */
+/*             OK    otherwise.                                  */
+/*                                                               */
+/*   Comment:  Signs are chosen so that the diagonal of R is     */
+/*             positive, as for Gram-Schmidt.                    */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int       info, lda, lwork, m, n, nWork, One;
+     real      Alpha, Beta, WorkSize;
+     real      *a, *tau, *w, *work;
+     size_t    i, j, nn, p;
+
+     CodeCheck(MatStorage(Q) == MAT_DENSE);
+
+     nn = MatNumRows(Q);
+     p  = MatNumCols(Q);
+
+     if (F != Q)
+          for (j = 0; j < p; j++)
+               VecCopy(MatCol(F, j), nn, MatCol(Q, j));
+
+     if (p == 0)
+     {
+          if (res != y)
+               VecCopy(y, nn, res);
+          return OK;
+     }
+
+     a   = MatBlock(Q);
+     m   = (int) nn;
+     n   = (int) p;
+     lda = (int) MatLeadDim(Q);
+     One = 1;
+
+     tau = AllocReal(p, NULL);
+     w   = AllocReal(nn, NULL);
+     VecCopy(y, nn, w);
+
+     /* Workspace queries. */
+     lwork = -1;
+     dgeqrf_(&m, &n, a, &lda, tau, &WorkSize, &lwork, &info);
+     nWork = max((int) WorkSize, n);
+     dorgqr_(&m, &n, &n, a, &lda, tau, &WorkSize, &lwork, &info);
+     lwork = max(nWork, (int) WorkSize);
+     work = AllocReal((size_t) lwork, NULL);
+
+     dgeqrf_(&m, &n, a, &lda, tau, work, &lwork, &info);
+
+     /* w = Q'y, in full. */
+     dormqr_("L", "T", &m, &One, &n, a, &lda, tau, w, &m, work,
+               &lwork, &info, 1, 1);
+
+     for (j = 0; j < p; j++)
+     {
+          for (i = 0; i <= j; i++)
+               MatPutElem(R, i, j, a[i + j * lda]);
+          c[j] = w[j];
+     }
+
+     dorgqr_(&m, &n, &n, a, &lda, tau, work, &lwork, &info);
+
+     AllocFree(tau);
+     AllocFree(w);
+     AllocFree(work);
+
+     /* Make the diagonal of R positive. */
+     for (j = 0; j < p; j++)
+          if (MatElem(R, j, j) < 0.0)
+          {
+               for (i = j; i < p; i++)
+                    MatPutElem(R, j, i, -MatElem(R, j, i));
+               VecMultScalar(-1.0, nn, MatCol(Q, j));
+               c[j] = -c[j];
+          }
+
+     for (j = 0; j < p; j++)
+          if (MatElem(R, j, j) <= 0.0)
+               return j + 1;
+
+     /* Residuals res = y - Q c. */
+     if (res != y)
+          VecCopy(y, nn, res);
+     Alpha = -1.0;
+     Beta  =  1.0;
+     dgemv_("N", &m, &n, &Alpha, a, &lda, c, &One, &Beta, res, &One,
+               1);
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+int LapackEig(boolean SortValues, const Matrix *S, real *eVal,
+          Matrix *V)
+/*****************************************************************/
+/*   Purpose:  As MatEig, by divide and conquer (dsyevd).        */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if dsyevd fails to converge;          */
+/*             OK          otherwise.                            */
+/*                                                               */
+/*   Comment:  Only the upper triangle of S is used.             */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int       info, liwork, lwork, n;
+     int       *iwork, IWorkSize;
+     real      WorkSize;
+     real      *a, *work;
+     size_t    i, j, jj, nn;
+
+     nn = MatNumRows(V);
+     n  = (int) nn;
+
+     if (nn == 0)
+          return OK;
+
+     a = AllocReal(nn * nn, NULL);
+     for (j = 0; j < nn; j++)
+          for (i = 0; i <= j; i++)
+               a[i + j * nn] = MatElem(S, i, j);
+
+     lwork = liwork = -1;
+     dsyevd_("V", "U", &n, a, &n, eVal, &WorkSize, &lwork, &IWorkSize,
+               &liwork, &info, 1, 1);
+     lwork  = (int) WorkSize;
+     liwork = IWorkSize;
+     work  = AllocReal((size_t) lwork, NULL);
+     iwork = AllocInt((size_t) liwork, NULL);
+
+     dsyevd_("V", "U", &n, a, &n, eVal, work, &lwork, iwork, &liwork,
+               &info, 1, 1);
+
+     AllocFree(work);
+     AllocFree(iwork);
+
+     if (info == 0)
+     {
+          /* Eigenvalues are ascending. */
+          if (SortValues)
+               for (j = 0; j < nn / 2; j++)
+               {
+                    jj = nn - 1 - j;
+                    WorkSize = eVal[j];
+                    eVal[j]  = eVal[jj];
+                    eVal[jj] = WorkSize;
+               }
+
+          for (j = 0; j < nn; j++)
+          {
+               jj = (SortValues) ? nn - 1 - j : j;
+               VecCopy(a + jj * nn, nn, MatCol(V, j));
+          }
+     }
+
+     AllocFree(a);
+
+     return (info == 0) ? OK : NUMERIC_ERR;
+}
+
+/*******************************+++*******************************/
+void LapackTriDiag(const Matrix *S, real *d, real *e, Matrix *B)
+/*****************************************************************/
+/*   Purpose:  As MatTriDiagProject, by dsytrd and dormtr.       */
+/*                                                               */
+/*   Comment:  Only the upper triangle of S is used.  As for     */
+/*             MatTriDiag, e[i] is the subdiagonal in row i of   */
+/*             T, and e[0] = 0.0.                                */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     int       info, lwork, m, n, nWork;
+     real      WorkSize;
+     real      *a, *c, *tau, *work;
+     size_t    i, j, mm, nn;
+
+     nn = MatNumRows(S);
+     mm = MatNumCols(B);
+     n  = (int) nn;
+     m  = (int) mm;
+
+     if (nn == 0)
+          return;
+
+     a = AllocReal(nn * nn, NULL);
+     for (j = 0; j < nn; j++)
+          for (i = 0; i <= j; i++)
+               a[i + j * nn] = MatElem(S, i, j);
+
+     c = AllocReal(nn * max(mm, 1), NULL);
+     for (j = 0; j < mm; j++)
+          VecCopy(MatCol(B, j), nn, c + j * nn);
+
+     tau = AllocReal(nn, NULL);
+
+     /* Workspace queries. */
+     lwork = -1;
+     dsytrd_("U", &n, a, &n, d, e + 1, tau, &WorkSize, &lwork, &info,
+               1);
+     nWork = max((int) WorkSize, 1);
+     dormtr_("L", "U", "T", &n, &m, a, &n, tau, c, &n, &WorkSize,
+               &lwork, &info, 1, 1, 1);
+     lwork = max(nWork, (int) WorkSize);
+     work = AllocReal((size_t) lwork, NULL);
+
+     /* The n - 1 off-diagonals go to e[1],..., e[n-1]. */
+     dsytrd_("U", &n, a, &n, d, e + 1, tau, work, &lwork, &info, 1);
+     e[0] = 0.0;
+
+     if (mm > 0)
+          dormtr_("L", "U", "T", &n, &m, a, &n, tau, c, &n, work,
+                    &lwork, &info, 1, 1, 1);
+
+     for (j = 0; j < mm; j++)
+          VecCopy(c + j * nn, nn, MatCol(B, j));
+
+     AllocFree(a);
+     AllocFree(c);
+     AllocFree(tau);
+     AllocFree(work);
+
+     return;
+}
+
+#endif  /* LAPACK_DEFINED */
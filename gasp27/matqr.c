@@ -16,12 +16,39 @@
 #include "matrix.h"
 #include "lib.h"
 
+#ifdef SIMD_DEFINED
+     #include <immintrin.h>
+#endif
+
+/* Columns per panel for the blocked Householder QR, and columns */
+/* updated together by HouseBlockApply.                          */
+#define QR_BLOCK  16
+#define QR_COLS   4
+
+static void HouseApply(size_t m, const real *v, real tau, real *x);
+static void HouseBlockT(size_t Row0, size_t n, size_t nb,
+          real * const *V, const real *tau, real *T);
+static void HouseBlockApply(boolean Trans, size_t Row0, size_t n,
+          size_t nb, real * const *V, const real *T, size_t NumCols,
+          real * const *C);
+static void HouseVTX(size_t Row0, size_t n, size_t nb,
+          real * const *V, size_t nc, real * const *X, real *Z);
+static void HouseXMinusVZ(size_t Row0, size_t n, size_t nb,
+          real * const *V, size_t nc, const real *Z, real * const *X);
+
+#ifdef SIMD_DEFINED
+static void HouseVTX4AVX2(size_t r, size_t n, const real *v,
+          real * const *X, real *z);
+static void HouseXMinusVZ4AVX2(size_t RowB, size_t n, size_t nb,
+          real * const *V, const real *Z, real * const *X);
+#endif
+
 /*******************************+++*******************************/
 /*                                                               */
 /*   size_t    QRLS(Matrix *F, real *y, Matrix *Q, Matrix *R,    */
 /*                  real *c, real *res)                          */
 /*                                                               */
-/*   Purpose:  Gram-Schmidt QR decomposition for least squares.  */
+/*   Purpose:  QR decomposition for least squares.               */
 /*                                                               */
 /*   Args:     F         Input:  Expanded design matrix.         */
 /*             y         Input:  Response vector.                */
@@ -34,20 +61,37 @@
 /*             Calling with y = res will overwrite y with res.   */
 /*             The calling routine must allocate space for Q, R, */
 /*             c, and res.                                       */
+/*             The diagonal of R is made positive, so Q and R    */
+/*             are those from Gram-Schmidt up to rounding error. */
 /*                                                               */
 /*   Returns:  j + 1 if R[j, j] becomes zero;                    */
 /*             OK    otherwise.                                  */
 /*                                                               */
-/*   Version:  1991 July 11                                      */
+/*   2026.10.16: Householder (LapackQRLS) if LAPACK_DEFINED and  */
+/*               Q is MAT_DENSE.                                 */
+/*   2026.10.17: Blocked Householder reflections replace         */
+/*               modified Gram-Schmidt.  Each panel of QR_BLOCK  */
+/*               columns is factored a column at a time, then    */
+/*               applied to the remaining columns as one block   */
+/*               reflector I - V T V'.  The residuals are        */
+/*               reflected back from Q'y rather than y - Q c.    */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
 /*                                                               */
 /*****************************************************************/
 
 size_t QRLS(Matrix *F, real *y, Matrix *Q, Matrix *R, real *c,
           real *res)
 {
-     real      r_jj, temp;
-     real      *Q_j;
-     size_t    i, j, k, n, p;
+     real      Alpha, Beta, Norm;
+     real      *T, *tau, *v, *w;
+     real      **A;
+     size_t    i, j, k0, k1, n, nb, p;
+
+#ifdef LAPACK_DEFINED
+     if (MatStorage(Q) == MAT_DENSE)
+          return LapackQRLS(F, y, Q, R, c, res);
+#endif
 
      n = Q->NumRows;
      p = Q->NumCols;
@@ -57,41 +101,484 @@ size_t QRLS(Matrix *F, real *y, Matrix *Q, Matrix *R, real *c,
           for (j = 0; j < p; j++)
                VecCopy(MatCol(F, j), n, MatCol(Q, j));
 
-     /* The Gram-Schmidt method iterates on Q a column at a    */
-     /* time, producing at step j the jth column of Q, the jth */
-     /* row of R, and the jth element of c.                    */
+     if (p == 0)
+     {
+          if (res != y)
+               VecCopy(y, n, res);
+          return OK;
+     }
+
+     /* Allocations. */
+     A   = AllocPtrReal(p, NULL);
+     tau = AllocReal(p, NULL);
+     T   = AllocReal(QR_BLOCK * p, NULL);
+     w   = AllocReal(n, NULL);
 
+     /* Column pointers, so Q may have either storage. */
      for (j = 0; j < p; j++)
+          A[j] = MatCol(Q, j);
+
+     /* w becomes Q'y, a reflection at a time. */
+     VecCopy(y, n, w);
+
+     /* Factorization.  Column j of A ends with R[0:j, j], and  */
+     /* v for the reflection I - tau[j] v v' below the diagonal */
+     /* (v[j] = 1 is implicit).                                  */
+     for (k0 = 0; k0 < p; k0 = k1)
      {
-          Q_j = MatCol(Q, j);
+          k1 = min(k0 + QR_BLOCK, p);
+          nb = k1 - k0;
+
+          for (j = k0; j < k1; j++)
+          {
+               v     = A[j] + j;
+               Alpha = (j < n) ? v[0] : 0.0;
+               Norm  = (j < n) ? sqrt(VecSS(v, n - j)) : 0.0;
 
-          /* Replace this with SNRM2. */
-          r_jj = sqrt(VecSS(Q_j, n));
-          MatPutElem(R, j, j, r_jj);
-          if (r_jj <= 0.0)
-               return j + 1;
+               if (Norm <= 0.0)
+               {
+                    MatPutElem(R, j, j, 0.0);
+                    AllocFree(A);
+                    AllocFree(tau);
+                    AllocFree(T);
+                    AllocFree(w);
+                    return j + 1;
+               }
 
-          VecMultScalar(1.0 / r_jj, n, Q_j);
+               Beta   = (Alpha > 0.0) ? -Norm : Norm;
+               tau[j] = (Beta - Alpha) / Beta;
+               VecMultScalar(1.0 / (Alpha - Beta), n - j - 1, v + 1);
+               v[0] = Beta;
 
-          for (k = j + 1; k < R->NumCols; k++)
-               MatPutElem(R, j, k, DotProd(Q_j, MatCol(Q, k), n));
+               /* Rest of the panel. */
+               HouseBlockApply(YES, j, n, 1, A + j, tau + j,
+                         k1 - j - 1, A + j + 1);
 
-          c[j] = DotProd(y, Q_j, n);
+               HouseApply(n - j, v, tau[j], w + j);
+          }
 
-          /* Update the remaining columns of the Q matrix. */
-          for (k = j + 1; k < p; k++)
-               VecAddVec(-MatElem(R, j, k), Q_j, n, MatCol(Q, k));
+          HouseBlockT(k0, n, nb, A + k0, tau + k0, T + k0 * QR_BLOCK);
+
+          /* Remaining columns. */
+          if (k1 < p)
+               HouseBlockApply(YES, k0, n, nb, A + k0,
+                         T + k0 * QR_BLOCK, p - k1, A + k1);
      }
 
-     /* Compute the residuals from the LS fit. */
-     /* (Is this the right method?)            */
-     for (i = 0; i < n; i++)
+     for (j = 0; j < p; j++)
      {
-          for (temp = 0.0, j = 0; j < Q->NumCols; j++)
-               temp += MatElem(Q, i, j) * c[j];
-          res[i] = y[i] - temp;
+          for (i = 0; i <= j; i++)
+               MatPutElem(R, i, j, A[j][i]);
+          c[j] = w[j];
      }
 
+     /* Residuals: the last n - p elements of Q'y reflected back. */
+     VecInit(0.0, p, w);
+     for (j = p; j-- > 0; )
+          HouseApply(n - j, A[j] + j, tau[j], w + j);
+     VecCopy(w, n, res);
+
+     /* Overwrite A with the first p columns of Q, a panel at a */
+     /* time from the last.  Columns k1,..., p - 1 are zero in  */
+     /* rows 0,..., k1 - 1 when panel k0 is applied to them.    */
+     for (k0 = (p > 0) ? (p - 1) / QR_BLOCK * QR_BLOCK : 0; p > 0;
+               k0 -= QR_BLOCK)
+     {
+          k1 = min(k0 + QR_BLOCK, p);
+          nb = k1 - k0;
+
+          if (k1 < p)
+               HouseBlockApply(NO, k0, n, nb, A + k0,
+                         T + k0 * QR_BLOCK, p - k1, A + k1);
+
+          for (j = k1; j-- > k0; )
+          {
+               HouseBlockApply(NO, j, n, 1, A + j, tau + j,
+                         k1 - j - 1, A + j + 1);
+
+               VecInit(0.0, j, A[j]);
+               A[j][j] = 1.0 - tau[j];
+               VecMultScalar(-tau[j], n - j - 1, A[j] + j + 1);
+          }
+
+          if (k0 == 0)
+               break;
+     }
+
+     /* Make the diagonal of R positive. */
+     for (j = 0; j < p; j++)
+          if (MatElem(R, j, j) < 0.0)
+          {
+               for (i = j; i < p; i++)
+                    MatPutElem(R, j, i, -MatElem(R, j, i));
+               VecMultScalar(-1.0, n, A[j]);
+               c[j] = -c[j];
+          }
+
+     AllocFree(A);
+     AllocFree(tau);
+     AllocFree(T);
+     AllocFree(w);
+
      return OK;
 }
 
+/*******************************+++*******************************/
+static void HouseApply(size_t m, const real *v, real tau, real *x)
+/*****************************************************************/
+/*   Purpose:  x = (I - tau v v') x for vectors of length m,     */
+/*             where v[0] = 1 (v[0] itself is not used).         */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     real      s;
+
+     s = tau * (x[0] + DotProd(v + 1, x + 1, m - 1));
+
+     x[0] -= s;
+     VecAddVec(-s, v + 1, m - 1, x + 1);
+}
+
+/*******************************+++*******************************/
+static void HouseBlockT(size_t Row0, size_t n, size_t nb,
+          real * const *V, const real *tau, real *T)
+/*****************************************************************/
+/*   Purpose:  Compute the upper-triangular T (nb x nb, leading  */
+/*             dimension QR_BLOCK) such that the product of the  */
+/*             reflections I - tau[i] v_i v_i', i = 0,..., nb-1, */
+/*             is I - V T V', where v_i is V[i] from row         */
+/*             Row0 + i to n - 1 (with v_i[0] = 1 implicit).     */
+/*                                                               */
+/*   Comment:  T[i, i] = tau[i], and                             */
+/*             T[0:i, i] = -tau[i] T[0:i, 0:i] V[:, 0:i]' v_i.   */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     real      Sum;
+     real      z[QR_BLOCK];
+     size_t    i, k, l, r;
+
+     for (i = 0; i < nb; i++)
+     {
+          /* v_i is zero above row r and 1 in row r. */
+          r = Row0 + i;
+          for (k = 0; k < i; k++)
+               z[k] = V[k][r] + DotProd(V[k] + r + 1, V[i] + r + 1,
+                         n - r - 1);
+
+          for (k = 0; k < i; k++)
+          {
+               for (Sum = 0.0, l = k; l < i; l++)
+                    Sum += T[k + l * QR_BLOCK] * z[l];
+               T[k + i * QR_BLOCK] = -tau[i] * Sum;
+          }
+
+          T[i + i * QR_BLOCK] = tau[i];
+     }
+}
+
+/*******************************+++*******************************/
+static void HouseBlockApply(boolean Trans, size_t Row0, size_t n,
+          size_t nb, real * const *V, const real *T, size_t NumCols,
+          real * const *C)
+/*****************************************************************/
+/*   Purpose:  Multiply rows Row0,..., n - 1 of the columns      */
+/*             C[0],..., C[NumCols - 1] by the block reflector   */
+/*             I - V T' V' if Trans, or I - V T V' otherwise     */
+/*             (see HouseBlockT).                                */
+/*                                                               */
+/*   Comment:  QR_COLS columns at a time, so that each element   */
+/*             of V is loaded once for several columns.          */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     real      Sum;
+     real      Z[QR_BLOCK * QR_COLS];
+     size_t    c, k, l, nc, q;
+
+     for (c = 0; c < NumCols; c += nc)
+     {
+          nc = min(QR_COLS, NumCols - c);
+
+          /* Z = V' X. */
+          HouseVTX(Row0, n, nb, V, nc, C + c, Z);
+
+          /* Z = T' Z or T Z, in place. */
+          for (q = 0; q < nc; q++)
+               if (Trans)
+                    for (k = nb; k-- > 0; )
+                    {
+                         for (Sum = 0.0, l = 0; l <= k; l++)
+                              Sum += T[l + k * QR_BLOCK]
+                                        * Z[l * QR_COLS + q];
+                         Z[k * QR_COLS + q] = Sum;
+                    }
+               else
+                    for (k = 0; k < nb; k++)
+                    {
+                         for (Sum = 0.0, l = k; l < nb; l++)
+                              Sum += T[k + l * QR_BLOCK]
+                                        * Z[l * QR_COLS + q];
+                         Z[k * QR_COLS + q] = Sum;
+                    }
+
+          /* X = X - V Z. */
+          HouseXMinusVZ(Row0, n, nb, V, nc, Z, C + c);
+     }
+}
+
+/*******************************+++*******************************/
+static void HouseVTX(size_t Row0, size_t n, size_t nb,
+          real * const *V, size_t nc, real * const *X, real *Z)
+/*****************************************************************/
+/*   Purpose:  Z = V' X for the nc <= QR_COLS columns X[0],...,  */
+/*             with v_k = V[k] from row Row0 + k (v_k[0] = 1     */
+/*             implicit).  Z[k * QR_COLS + q] is element (k, q). */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     real      a0, a1, a2, a3, b0, b1, b2, b3, v0, v1;
+     real      *v, *x0, *x1, *x2, *x3;
+     size_t    i, k, q, r;
+
+     for (k = 0; k < nb; k++)
+     {
+          r = Row0 + k;
+          v = V[k];
+
+          if (nc < QR_COLS)
+          {
+               for (q = 0; q < nc; q++)
+                    Z[k * QR_COLS + q] = X[q][r]
+                              + DotProd(v + r + 1, X[q] + r + 1,
+                              n - r - 1);
+               continue;
+          }
+
+#ifdef SIMD_DEFINED
+          if (VecSimdLevel() >= SIMD_AVX2)
+          {
+               HouseVTX4AVX2(r, n, v, X, Z + k * QR_COLS);
+               continue;
+          }
+#endif
+
+          x0 = X[0];
+          x1 = X[1];
+          x2 = X[2];
+          x3 = X[3];
+
+          /* Two rows at a time: eight independent sums. */
+          a0 = x0[r];
+          a1 = x1[r];
+          a2 = x2[r];
+          a3 = x3[r];
+          b0 = b1 = b2 = b3 = 0.0;
+          for (i = r + 1; i + 1 < n; i += 2)
+          {
+               v0 = v[i];
+               v1 = v[i+1];
+               a0 += v0 * x0[i];
+               a1 += v0 * x1[i];
+               a2 += v0 * x2[i];
+               a3 += v0 * x3[i];
+               b0 += v1 * x0[i+1];
+               b1 += v1 * x1[i+1];
+               b2 += v1 * x2[i+1];
+               b3 += v1 * x3[i+1];
+          }
+          if (i < n)
+          {
+               v0 = v[i];
+               a0 += v0 * x0[i];
+               a1 += v0 * x1[i];
+               a2 += v0 * x2[i];
+               a3 += v0 * x3[i];
+          }
+
+          Z[k * QR_COLS]     = a0 + b0;
+          Z[k * QR_COLS + 1] = a1 + b1;
+          Z[k * QR_COLS + 2] = a2 + b2;
+          Z[k * QR_COLS + 3] = a3 + b3;
+     }
+}
+
+/*******************************+++*******************************/
+static void HouseXMinusVZ(size_t Row0, size_t n, size_t nb,
+          real * const *V, size_t nc, const real *Z, real * const *X)
+/*****************************************************************/
+/*   Purpose:  X = X - V Z for the nc <= QR_COLS columns         */
+/*             X[0],..., with V and Z as for HouseVTX.           */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     real      a0, a1, a2, a3, b0, b1, b2, b3, v0, v1;
+     const real *z;
+     real      *x0, *x1, *x2, *x3;
+     size_t    i, k, q, RowB;
+
+     RowB = Row0 + nb;
+
+     /* Rows Row0,..., RowB - 1: v_k is 1 in row Row0 + k, and */
+     /* zero above.                                            */
+     for (i = Row0; i < min(RowB, n); i++)
+          for (q = 0; q < nc; q++)
+          {
+               X[q][i] -= Z[(i - Row0) * QR_COLS + q];
+               for (k = 0; k < i - Row0; k++)
+                    X[q][i] -= V[k][i] * Z[k * QR_COLS + q];
+          }
+
+     if (nc < QR_COLS)
+     {
+          for (k = 0; k < nb; k++)
+               for (q = 0; q < nc; q++)
+                    VecAddVec(-Z[k * QR_COLS + q], V[k] + RowB,
+                              n - RowB, X[q] + RowB);
+          return;
+     }
+
+#ifdef SIMD_DEFINED
+     if (VecSimdLevel() >= SIMD_AVX2)
+     {
+          HouseXMinusVZ4AVX2(RowB, n, nb, V, Z, X);
+          return;
+     }
+#endif
+
+     x0 = X[0];
+     x1 = X[1];
+     x2 = X[2];
+     x3 = X[3];
+
+     /* Rows RowB,..., n - 1, two at a time. */
+     for (i = RowB; i + 1 < n; i += 2)
+     {
+          a0 = x0[i];
+          a1 = x1[i];
+          a2 = x2[i];
+          a3 = x3[i];
+          b0 = x0[i+1];
+          b1 = x1[i+1];
+          b2 = x2[i+1];
+          b3 = x3[i+1];
+          for (k = 0; k < nb; k++)
+          {
+               z  = Z + k * QR_COLS;
+               v0 = V[k][i];
+               v1 = V[k][i+1];
+               a0 -= v0 * z[0];
+               a1 -= v0 * z[1];
+               a2 -= v0 * z[2];
+               a3 -= v0 * z[3];
+               b0 -= v1 * z[0];
+               b1 -= v1 * z[1];
+               b2 -= v1 * z[2];
+               b3 -= v1 * z[3];
+          }
+          x0[i]   = a0;
+          x1[i]   = a1;
+          x2[i]   = a2;
+          x3[i]   = a3;
+          x0[i+1] = b0;
+          x1[i+1] = b1;
+          x2[i+1] = b2;
+          x3[i+1] = b3;
+     }
+     if (i < n)
+          for (q = 0; q < QR_COLS; q++)
+               for (k = 0; k < nb; k++)
+                    X[q][i] -= V[k][i] * Z[k * QR_COLS + q];
+}
+
+#ifdef SIMD_DEFINED
+
+/*******************************+++*******************************/
+__attribute__((target("avx2,fma")))
+static void HouseVTX4AVX2(size_t r, size_t n, const real *v,
+          real * const *X, real *z)
+/*****************************************************************/
+/*   Purpose:  As HouseVTX for one v and QR_COLS = 4 columns:    */
+/*             z[q] = X[q][r] + v[r+1] X[q][r+1] + ...           */
+/*             + v[n-1] X[q][n-1].                               */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     real      s[4][4];
+     size_t    i, q;
+     __m256d   a0, a1, a2, a3, vv;
+
+     a0 = a1 = a2 = a3 = _mm256_setzero_pd();
+
+     for (i = r + 1; i + 4 <= n; i += 4)
+     {
+          vv = _mm256_loadu_pd(v + i);
+          a0 = _mm256_fmadd_pd(vv, _mm256_loadu_pd(X[0] + i), a0);
+          a1 = _mm256_fmadd_pd(vv, _mm256_loadu_pd(X[1] + i), a1);
+          a2 = _mm256_fmadd_pd(vv, _mm256_loadu_pd(X[2] + i), a2);
+          a3 = _mm256_fmadd_pd(vv, _mm256_loadu_pd(X[3] + i), a3);
+     }
+
+     _mm256_storeu_pd(s[0], a0);
+     _mm256_storeu_pd(s[1], a1);
+     _mm256_storeu_pd(s[2], a2);
+     _mm256_storeu_pd(s[3], a3);
+
+     for (q = 0; q < 4; q++)
+          z[q] = X[q][r] + ((s[q][0] + s[q][1]) + (s[q][2] + s[q][3]))
+                    + DotProd(v + i, X[q] + i, n - i);
+}
+
+/*******************************+++*******************************/
+__attribute__((target("avx2,fma")))
+static void HouseXMinusVZ4AVX2(size_t RowB, size_t n, size_t nb,
+          real * const *V, const real *Z, real * const *X)
+/*****************************************************************/
+/*   Purpose:  As HouseXMinusVZ for rows RowB,..., n - 1 of      */
+/*             QR_COLS = 4 columns.                              */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*****************************************************************/
+{
+     size_t    i, k, q;
+     __m256d   a0, a1, a2, a3, vv;
+
+     for (i = RowB; i + 4 <= n; i += 4)
+     {
+          a0 = _mm256_loadu_pd(X[0] + i);
+          a1 = _mm256_loadu_pd(X[1] + i);
+          a2 = _mm256_loadu_pd(X[2] + i);
+          a3 = _mm256_loadu_pd(X[3] + i);
+
+          for (k = 0; k < nb; k++)
+          {
+               vv = _mm256_loadu_pd(V[k] + i);
+               a0 = _mm256_fnmadd_pd(vv,
+                         _mm256_broadcast_sd(Z + k * 4), a0);
+               a1 = _mm256_fnmadd_pd(vv,
+                         _mm256_broadcast_sd(Z + k * 4 + 1), a1);
+               a2 = _mm256_fnmadd_pd(vv,
+                         _mm256_broadcast_sd(Z + k * 4 + 2), a2);
+               a3 = _mm256_fnmadd_pd(vv,
+                         _mm256_broadcast_sd(Z + k * 4 + 3), a3);
+          }
+
+          _mm256_storeu_pd(X[0] + i, a0);
+          _mm256_storeu_pd(X[1] + i, a1);
+          _mm256_storeu_pd(X[2] + i, a2);
+          _mm256_storeu_pd(X[3] + i, a3);
+     }
+
+     for ( ; i < n; i++)
+          for (q = 0; q < 4; q++)
+               for (k = 0; k < nb; k++)
+                    X[q][i] -= V[k][i] * Z[k * 4 + q];
+}
+
+#endif  /* SIMD_DEFINED */
@@ -17,6 +17,15 @@
 /* An UP-TRIANG matrix can also be viewed as lower-triangular, */
 /* stored by rows.                                             */
 
+/* Matrix storage: */
+#define   MAT_COLUMNS 0  /* Each column allocated separately.  */
+#define   MAT_DENSE   1  /* REAL only: one aligned block, by   */
+                         /* column, with leading dimension    */
+                         /* LeadDim (UP_TRIANG stored square). */
+
+/* Alignment (bytes) of MAT_DENSE blocks and columns. */
+#define   MAT_ALIGN   64
+
 typedef struct MatrixStruct
 {
      size_t    NumRows;
@@ -35,6 +44,10 @@ typedef struct MatrixStruct
      string    *RowName;
      string    *ColName;
      boolean   Initialized;
+     int       Storage;       /* MAT_COLUMNS or MAT_DENSE. */
+     size_t    LeadDim;       /* MAT_DENSE: column stride. */
+     real      *Block;        /* MAT_DENSE: aligned block. */
+     real      *BlockAlloc;   /* MAT_DENSE: as allocated.  */
      struct MatrixStruct *Next;
 } matrix;
 
@@ -57,6 +70,10 @@ typedef matrix Matrix;
 #define MatColLen(M,j)        ((M)->Shape == RECT ? \
                                    (M)->NumRows : j + 1)
 
+#define MatStorage(M)         ((M)->Storage)
+#define MatLeadDim(M)         ((M)->LeadDim)   /* MAT_DENSE. */
+#define MatBlock(M)           ((M)->Block)     /* MAT_DENSE. */
+
 #define MatType(M)            ((M)->Type)
 #define MatPutType(M,NewType) ((M)->Type = NewType)
 #define MatColType(M,j)       ((M)->ColType[j])
@@ -122,10 +139,31 @@ void MatInit(int Shape, int Type, boolean Labelled, Matrix *M);
 /*   Purpose:  Initialize a matrix as 0 x 0.                     */
 /*****************************************************************/
 
+/*****************************************************************/
+void MatInitDense(int Shape, Matrix *M);
+/*****************************************************************/
+/*   Purpose:  Initialize an unlabelled REAL matrix as 0 x 0,    */
+/*             with MAT_DENSE storage.                           */
+/*                                                               */
+/*   Comment:  Elements are still accessed through MatCol,       */
+/*             MatElem, etc.; in addition, column j starts at    */
+/*             MatBlock(M) + j * MatLeadDim(M).  Columns must    */
+/*             not be replaced by MatPutCol.                     */
+/*****************************************************************/
+
 void MatReAllocate(size_t NewNumRows, size_t NewNumCols,
           const int *NewColType, Matrix *M);
 void MatFree(Matrix *M);
 void MatColReAlloc(size_t NewLen, size_t j, Matrix *M);
+
+/*****************************************************************/
+void MatBlockReAlloc(size_t NewNumRows, size_t NewNumCols,
+          Matrix *M);
+/*****************************************************************/
+/*   Purpose:  For MatReAllocate, re-allocate the block of a     */
+/*             MAT_DENSE matrix, keeping the elements of the     */
+/*             surviving columns, and set the column pointers.   */
+/*****************************************************************/
 size_t MatColumnAdd(const string ColName, int NewColType, Matrix *M);
 
 #define MatReAlloc(NewNumRows, NewNumCols, M) \
@@ -135,6 +173,9 @@ size_t MatColumnAdd(const string ColName, int NewColType, Matrix *M);
            MatReAllocate(NumRows, NumCols, ColType, M);}
 #define MatAlloc(NumRows,NumCols,Shape,M) \
           MatAllocate(NumRows, NumCols, Shape, REAL, NULL, NO, M)
+#define MatAllocDense(NumRows,NumCols,Shape,M) \
+          {MatInitDense(Shape, M); \
+           MatReAllocate(NumRows, NumCols, NULL, M);}
 
 #define MatIntColAdd(ColName, M) \
           (MatIntCol(M, MatColumnAdd(ColName, INTEGER, M)))
@@ -344,6 +385,23 @@ int MatEig(boolean SortValues, matrix *S, real *eVal, matrix *V);
 /*             must be allocated RECT.                           */
 /*****************************************************************/
 
+/*****************************************************************/
+int MatEigProject(matrix *S, real *eVal, matrix *B);
+/*****************************************************************/
+/* Purpose:    Compute the eigenvalues, eVal, of symmetric       */
+/*             matrix S = V Diag(eVal) V', and overwrite B with  */
+/*             V'B, without forming the eigenvectors V.          */
+/*                                                               */
+/* Returns:    NUMERIC_ERR if MatEigTriDiag fails to converge;   */
+/*             OK          otherwise.                            */
+/*                                                               */
+/* Comments:   Calling routine must allocate space for eVal.     */
+/*             S and B must be allocated RECT, and B must have   */
+/*             the same number of rows as S.  S is overwritten;  */
+/*             only its upper triangle is used.                  */
+/*             The eigenvalues are not sorted.                   */
+/*****************************************************************/
+
 /*****************************************************************/
 void MatTriDiag(matrix *S, real *d, real *e, matrix *Z);
 /*****************************************************************/
@@ -363,6 +421,19 @@ void MatTriDiag(matrix *S, real *d, real *e, matrix *Z);
 /*             Computation, Volume II, pp. 212--226.             */
 /*****************************************************************/
 
+/*****************************************************************/
+void MatTriDiagProject(matrix *S, real *d, real *e, matrix *B);
+/*****************************************************************/
+/* Purpose:    Reduce a symmetric matrix S to Z T Z' as          */
+/*             MatTriDiag, but overwrite B with Z'B instead of   */
+/*             forming Z.                                        */
+/*                                                               */
+/* Comments:   Calling routine must allocate space for d and e.  */
+/*             S must be allocated RECT and is overwritten.  B   */
+/*             must be allocated RECT with the same number of    */
+/*             rows as S.                                        */
+/*****************************************************************/
+
 /*****************************************************************/
 int MatEigTriDiag(boolean SortValues, real *d, real *e, matrix *Z);
 /*****************************************************************/
@@ -381,6 +452,9 @@ int MatEigTriDiag(boolean SortValues, real *d, real *e, matrix *Z);
 /*             a symmetric matrix.  To obtain the eigenvectors   */
 /*             of a tridiagonal matrix, Z should be the identity */
 /*             on entry.                                         */
+/*             Z may have any number of rows; the rotations are  */
+/*             applied to its columns.  Thus, if Z is B'Z0 for   */
+/*             Z0 from MatTriDiag, Z is B'V on exit.             */
 /*                                                               */
 /* Returns:    NUMERIC_ERR if the algorithm failed to converge;  */
 /*             OK          otherwise.                            */
@@ -408,6 +482,36 @@ int MatRead(FILE *InpFile, int Type, Matrix *M);
 int       MatReadABlock(FILE *InpFile, int Type, Matrix *Block,
                boolean *Finished);
 
+/*****************************************************************/
+int MatReadStart(FILE *InpFile, Matrix *M, boolean *CaseLabels);
+/*****************************************************************/
+/*   Purpose:  Start reading a REAL matrix from a file a few     */
+/*             rows at a time: read the description and column   */
+/*             labels into M, which has no rows.  The rows are   */
+/*             read by MatReadRows.                              */
+/*                                                               */
+/*   Returns:  OK or an error number.                            */
+/*                                                               */
+/*   Comment:  On return, *CaseLabels is YES if the rows have    */
+/*             case labels.                                      */
+/*             Only one matrix at a time can be read this way.   */
+/*****************************************************************/
+
+/*****************************************************************/
+int MatReadRows(FILE *InpFile, boolean CaseLabels, size_t MaxRows,
+     Matrix *M, boolean *Finished);
+/*****************************************************************/
+/*   Purpose:  Read up to MaxRows further rows of the matrix     */
+/*             started by MatReadStart, replacing the rows of M. */
+/*                                                               */
+/*   Returns:  OK or an error number.                            */
+/*                                                               */
+/*   Comment:  On return, *Finished is YES if there are no more  */
+/*             rows.  Rows without case labels are labelled by   */
+/*             their row number in the file.  A second block of  */
+/*             columns (see MatWriteBlock) is an error.          */
+/*****************************************************************/
+
 /*****************************************************************/
 void MatWrite(Matrix *M, FILE *OutFile);
 /*****************************************************************/
@@ -418,6 +522,40 @@ void MatWrite(Matrix *M, FILE *OutFile);
 /*             lines.  Use MatWriteBlock() for "nice" output.    */
 /*****************************************************************/
 
+/*****************************************************************/
+int MatWriteStart(Matrix *M);
+/*****************************************************************/
+/*   Purpose:  Start writing a matrix a few rows at a time: the  */
+/*             rows are given to MatWriteRows, and MatWriteEnd   */
+/*             writes the file.                                  */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*                                                               */
+/*   Comment:  The file is exactly as MatWrite would write M     */
+/*             with all the rows.  Meanwhile the rows are kept   */
+/*             in a temporary binary file.  M must have only     */
+/*             REAL columns.                                     */
+/*****************************************************************/
+
+/*****************************************************************/
+int MatWriteRows(Matrix *M);
+/*****************************************************************/
+/*   Purpose:  Add the rows of M to the matrix started by        */
+/*             MatWriteStart with the same columns.              */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*****************************************************************/
+
+/*****************************************************************/
+int MatWriteEnd(Matrix *M, FILE *OutFile);
+/*****************************************************************/
+/*   Purpose:  Write the matrix started by MatWriteStart, with   */
+/*             the text and columns of M and the rows given to   */
+/*             MatWriteRows, to OutFile as MatWrite would.       */
+/*                                                               */
+/*   Returns:  OK or FILE_ERR.                                   */
+/*****************************************************************/
+
 /*****************************************************************/
 void MatWriteBlock(Matrix *M, boolean CaseLabels, FILE *OutFile);
 /*****************************************************************/
@@ -463,6 +601,107 @@ void MatPrint(const Matrix *M);
 /*****************************************************************/
 
 
+/* matlapack.c: */
+
+#ifdef LAPACK_DEFINED
+
+/* VecDotProd calls ddot for vectors at least this long. */
+#define LAPACK_DOT_MIN   32
+
+real LapackDotProd(size_t n, const real *a, const real *b);
+
+/*****************************************************************/
+int LapackMatVec(const Matrix *M, const real *x, real *y);
+/*****************************************************************/
+/*   Purpose:  Compute y = M'x (dgemv) for a RECT MAT_DENSE      */
+/*             matrix.                                           */
+/*                                                               */
+/*   Returns:  INPUT_ERR if M is not RECT and MAT_DENSE;         */
+/*             OK        otherwise.                              */
+/*****************************************************************/
+
+/*****************************************************************/
+int LapackTMult(const Matrix *A, const Matrix *B, Matrix *C);
+/*****************************************************************/
+/*   Purpose:  Compute C = A'B (dgemm) for RECT MAT_DENSE A, B,  */
+/*             and C.                                            */
+/*                                                               */
+/*   Returns:  INPUT_ERR if A, B, or C is not RECT and           */
+/*                       MAT_DENSE;                              */
+/*             OK        otherwise.                              */
+/*****************************************************************/
+
+/*****************************************************************/
+int LapackCholesky(const Matrix *S, Matrix *R);
+/*****************************************************************/
+/*   Purpose:  Cholesky decomposition R'R of symmetric matrix S  */
+/*             (dpotrf) for a MAT_DENSE R.                       */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if S is not positive definite (the    */
+/*                         upper triangle of R is then a copy of */
+/*                         S);                                   */
+/*             OK          otherwise.                            */
+/*****************************************************************/
+
+/*****************************************************************/
+int LapackCholInverse(const Matrix *R, Matrix *S);
+/*****************************************************************/
+/*   Purpose:  Upper triangle of S = Inverse(R'R) (dpotri) for   */
+/*             an UP_TRIANG R and a MAT_DENSE S.                 */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if S is not MAT_DENSE or R is         */
+/*                         singular;                             */
+/*             OK          otherwise.                            */
+/*****************************************************************/
+
+/*****************************************************************/
+int LapackTriSolve(const Matrix *R, boolean Trans, const real *b,
+          real *x);
+/*****************************************************************/
+/*   Purpose:  Solve R'x = b (Trans = YES) or R x = b (dtrsv)    */
+/*             for an UP_TRIANG MAT_DENSE R.                     */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if R is not MAT_DENSE or has a zero   */
+/*                         diagonal element;                     */
+/*             OK          otherwise.                            */
+/*****************************************************************/
+
+/*****************************************************************/
+int LapackTriSolveMat(const Matrix *R, Matrix *X);
+/*****************************************************************/
+/*   Purpose:  Overwrite X with the solution of R'X = X (dtrsm)  */
+/*             for an UP_TRIANG R and RECT X, both MAT_DENSE.    */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if R or X is not MAT_DENSE, X does    */
+/*                         not have as many rows as R, or R has  */
+/*                         a zero diagonal element;              */
+/*             OK          otherwise.                            */
+/*****************************************************************/
+
+/*****************************************************************/
+size_t LapackQRLS(const Matrix *F, const real *y, Matrix *Q,
+          Matrix *R, real *c, real *res);
+/*****************************************************************/
+/*   Purpose:  As QRLS, but by Householder reflections (dgeqrf,  */
+/*             dormqr, dorgqr) for a MAT_DENSE Q.                */
+/*****************************************************************/
+
+/*****************************************************************/
+int LapackEig(boolean SortValues, const Matrix *S, real *eVal,
+          Matrix *V);
+/*****************************************************************/
+/*   Purpose:  As MatEig, by divide and conquer (dsyevd).        */
+/*****************************************************************/
+
+/*****************************************************************/
+void LapackTriDiag(const Matrix *S, real *d, real *e, Matrix *B);
+/*****************************************************************/
+/*   Purpose:  As MatTriDiagProject, by dsytrd and dormtr.       */
+/*****************************************************************/
+
+#endif
+
+
 /* matqr.c: */
 
 size_t    QRLS(Matrix *F, real *y, Matrix *Q, Matrix *R, real *c,
@@ -545,6 +784,80 @@ size_t TriCholesky(const Matrix *S, size_t FirstOff, Matrix *R);
 /*             deficient.                                        */
 /*             Calling with TriCholesky(S,..., S) will overwrite */
 /*             S.                                                */
+/*             Blocked by panels of TRI_CHOL_BLOCK columns; the  */
+/*             panel updates are threaded if compiled with       */
+/*             OpenMP.                                           */
+/*****************************************************************/
+
+/* Columns per panel in TriCholesky. */
+#define TRI_CHOL_BLOCK   64
+
+/* Columns updated together by TriForSolvePanel. */
+#define TRI_CHOL_COLS    4
+
+/* Partial sums per dot product in TriForSolvePanel and */
+/* TriDotProd.                                          */
+#define TRI_CHOL_LANES   4
+
+/* Panels starting before this column are not threaded. */
+#define TRI_CHOL_PAR_MIN 256
+
+/*****************************************************************/
+void TriForSolvePanel(const Matrix *R, size_t iLast, size_t nCols,
+     real **B, real **X);
+/*****************************************************************/
+/*   Purpose:  Forward solve rows 0,..., iLast - 1 of R'x = b    */
+/*             for nCols (at most TRI_CHOL_COLS) columns: b is   */
+/*             B[c] and x is X[c].                               */
+/*                                                               */
+/*   Comment:  x[i] is set to zero if R[i, i] is zero.           */
+/*             Used by TriCholesky and TriForSolveMat.           */
+/*****************************************************************/
+
+/*****************************************************************/
+real TriDotProd(size_t n, const real *a, const real *b);
+/*****************************************************************/
+/*   Purpose:  Return a[0] * b[0] + ... + a[n-1] * b[n-1] for    */
+/*             TriCholesky, accumulated in TRI_CHOL_LANES        */
+/*             partial sums.                                     */
+/*****************************************************************/
+
+/*****************************************************************/
+int TriCholInverse(const Matrix *R, Matrix *S);
+/*****************************************************************/
+/*   Purpose:  Compute the upper triangle of S = Inverse(R'R)    */
+/*             from the Cholesky factor R: by dpotri if          */
+/*             LAPACK_DEFINED and S is MAT_DENSE.                */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if R has a zero diagonal element;     */
+/*             OK          otherwise.                            */
+/*                                                               */
+/*   Comment:  TriCholInverse(R, R) overwrites R.                */
+/*             Columns are shared among threads (if compiled     */
+/*             with OpenMP) from TRI_CHOL_PAR_MIN columns.       */
+/*****************************************************************/
+
+/*****************************************************************/
+int TriCholInvDiag(const Matrix *R, real *d);
+/*****************************************************************/
+/*   Purpose:  Compute the diagonal, d, of Inverse(R'R) from the */
+/*             Cholesky factor R, at half the cost of            */
+/*             TriCholInverse.                                   */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if R has a zero diagonal element;     */
+/*             OK          otherwise.                            */
+/*****************************************************************/
+
+/*****************************************************************/
+int TriForSolveMat(const Matrix *R, const Matrix *B, Matrix *X);
+/*****************************************************************/
+/*   Purpose:  Forward solve R'X = B for X: by dtrsm if          */
+/*             LAPACK_DEFINED and R and X are MAT_DENSE;         */
+/*             otherwise by TriForSolvePanel, or by TriForSolve  */
+/*             a column at a time if R has a zero diagonal.      */
+/*                                                               */
+/*   Returns:  As TriForSolve, for the first column with an      */
+/*             error; OK otherwise.                              */
 /*****************************************************************/
 
 void      TriRect(const Matrix *X, Matrix *R);
@@ -620,6 +933,14 @@ void MatVec(const Matrix *M, const real *x, real *y);
 /*   Comment:  Calling routine must allocate space for y.        */
 /*****************************************************************/
 
+/*****************************************************************/
+void MatTMult(const Matrix *A, const Matrix *B, Matrix *C);
+/*****************************************************************/
+/*   Purpose:  Compute C = A'B for RECT matrices.                */
+/*                                                               */
+/*   Comment:  Calling routine must allocate space for C.        */
+/*****************************************************************/
+
 void      MatStack(const Matrix *M, boolean ByCols, real *v);
 void      MatUnStack(const real *v, boolean ByCols, Matrix *M);
 int       MatMerge(Matrix *M1, Matrix *M2);
@@ -17,6 +17,8 @@
 #include "matrix.h"
 #include "lib.h"
 
+static void TriInvPacked(const Matrix *R, real *Z);
+
 /*******************************+++*******************************/
 int TriForSolve(const Matrix *R, const real *b, size_t StartOff,
           real *x)
@@ -37,13 +39,21 @@ int TriForSolve(const Matrix *R, const real *b, size_t StartOff,
 /*   Comment:  Calling routine must allocate space for x         */
 /*             (unless x = b).                                   */
 /*                                                               */
-/*   Version:  1991 May 20                                       */
+/*   2026.10.16: dtrsv if LAPACK_DEFINED and R is MAT_DENSE.     */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
 /*****************************************************************/
 {
      real      numer, *Rj, Rjj;
      int       ErrNum;
      size_t    j, n, nzero;
 
+#ifdef LAPACK_DEFINED
+     /* A zero diagonal element is left to the code below. */
+     if (StartOff == 0 && LapackTriSolve(R, YES, b, x) == OK)
+          return OK;
+#endif
+
      n = MatNumCols(R);
 
      /* Leading zeros in b simplify calculations. */
@@ -78,6 +88,76 @@ int TriForSolve(const Matrix *R, const real *b, size_t StartOff,
      return ErrNum;
 }
 
+/*******************************+++*******************************/
+int TriForSolveMat(const Matrix *R, const Matrix *B, Matrix *X)
+/*****************************************************************/
+/*   Purpose:  Forward solve R'X = B for X.                      */
+/*             Calling with TriForSolveMat(R, B, B) will         */
+/*             overwrite B with X.                               */
+/*                                                               */
+/*   Returns:  As TriForSolve, for the first column with an      */
+/*             error; OK otherwise.                              */
+/*                                                               */
+/*   Comment:  Calling routine must allocate space for X.        */
+/*             With LAPACK_DEFINED and R and X MAT_DENSE, all    */
+/*             columns are solved together (dtrsm).  Otherwise,  */
+/*             if R has no zero diagonal element,                */
+/*             TriForSolvePanel solves TRI_CHOL_COLS columns at  */
+/*             a time; if it has, each column is solved by       */
+/*             TriForSolve.                                      */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*   2026.10.16: Columns solved together by TriForSolvePanel.    */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     int       ErrNum;
+     real      *Bc[TRI_CHOL_COLS], *Xc[TRI_CHOL_COLS];
+     size_t    c, j, j0, n, nCols;
+
+#ifdef LAPACK_DEFINED
+     if (MatStorage(X) == MAT_DENSE)
+     {
+          if (B != X)
+               for (j = 0; j < MatNumCols(B); j++)
+                    VecCopy(MatCol(B, j), MatNumRows(B),
+                              MatCol(X, j));
+
+          if (LapackTriSolveMat(R, X) == OK)
+               return OK;
+
+          B = X;
+     }
+#endif
+
+     n = MatNumCols(R);
+     for (j = 0; j < n; j++)
+          if (MatElem(R, j, j) == 0.0)
+               break;
+
+     if (j == n)
+     {
+          for (j0 = 0; j0 < MatNumCols(B); j0 += nCols)
+          {
+               nCols = min(TRI_CHOL_COLS, MatNumCols(B) - j0);
+               for (c = 0; c < nCols; c++)
+               {
+                    Bc[c] = MatCol(B, j0 + c);
+                    Xc[c] = MatCol(X, j0 + c);
+               }
+               TriForSolvePanel(R, n, nCols, Bc, Xc);
+          }
+          return OK;
+     }
+
+     ErrNum = OK;
+     for (j = 0; j < MatNumCols(B) && ErrNum == OK; j++)
+          ErrNum = TriForSolve(R, MatCol(B, j), 0, MatCol(X, j));
+
+     return ErrNum;
+}
+
 /*******************************+++*******************************/
 /*                                                               */
 /*   int       TriBackSolve(const Matrix *R, const real *b,      */
@@ -97,7 +177,9 @@ int TriForSolve(const Matrix *R, const real *b, size_t StartOff,
 /*   Comment:  Calling routine must allocate space for x         */
 /*             (unless x = b).                                   */
 /*                                                               */
-/*   Version:  1991 May 20                                       */
+/*   2026.10.16: dtrsv if LAPACK_DEFINED and R is MAT_DENSE.     */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
 /*                                                               */
 /*****************************************************************/
 
@@ -107,6 +189,12 @@ int TriBackSolve(const Matrix *R, const real *b, real *x)
      real      Diag;
      size_t    j, jj, n;
 
+#ifdef LAPACK_DEFINED
+     /* A zero diagonal element is left to the code below. */
+     if (LapackTriSolve(R, NO, b, x) == OK)
+          return OK;
+#endif
+
      n = MatNumCols(R);
 
      if (x != b)
@@ -337,46 +425,90 @@ size_t TriCholesky(const Matrix *S, size_t FirstOff, Matrix *R)
 /*             deficient.                                        */
 /*             Calling with TriCholesky(S,..., S) will overwrite */
 /*             S.                                                */
+/*             The columns are processed in panels of            */
+/*             TRI_CHOL_BLOCK.  Above the diagonal block, a      */
+/*             panel depends only on the finished columns to its */
+/*             left, so it is computed by TriForSolvePanel in    */
+/*             groups of TRI_CHOL_COLS columns, which are        */
+/*             independent and are shared among threads if       */
+/*             compiled with OpenMP.                             */
 /*                                                               */
 /*   96.02.20: Adapted to continue if zero diagonal encountered. */
+/*   2026.10.16: Blocked by column panels.                       */
+/*   2026.10.16: dpotrf if LAPACK_DEFINED and R is MAT_DENSE.    */
 /*                                                               */
-/*   Version:  1996.02.20                                        */
+/*   Version:  2026.10.16                                        */
 /*****************************************************************/
 {
      real      *Sj, *Ri, *Rj;
-     real      r, t;
-     size_t    i, j, n, Rank;
+     real      r;
+     size_t    i, j, j0, j1, n, Rank;
+     long      g, nGroups;
+
+#ifdef LAPACK_DEFINED
+     /* If S is not positive definite, R is a copy of S and the */
+     /* code below completes the rank-deficient decomposition.  */
+     if (FirstOff == 0 && MatStorage(R) == MAT_DENSE)
+     {
+          if (LapackCholesky(S, R) == OK)
+               return OK;
+          S = R;
+     }
+#endif
 
      n = MatNumCols(S);
 
      R->Shape = UP_TRIANG;
 
-     for (j = FirstOff; j < n; j++)
+     for (j0 = FirstOff; j0 < n; j0 = j1)
      {
-          /* Pointers to column j of S and R. */
-          Sj = MatCol(S, j);
-          Rj = MatCol(R, j);
+          j1 = min(j0 + TRI_CHOL_BLOCK, n);
+
+          /* Rows 0,..., j0 - 1 of columns j0,..., j1 - 1. */
+          nGroups = (long) ((j1 - j0 + TRI_CHOL_COLS - 1)
+                    / TRI_CHOL_COLS);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (j0 >= TRI_CHOL_PAR_MIN)
+#endif
+          for (g = 0; g < nGroups; g++)
+          {
+               real      *Sc[TRI_CHOL_COLS], *Rc[TRI_CHOL_COLS];
+               size_t    c, jg, nCols;
+
+               jg = j0 + (size_t) g * TRI_CHOL_COLS;
+               nCols = min(TRI_CHOL_COLS, j1 - jg);
+               for (c = 0; c < nCols; c++)
+               {
+                    Sc[c] = MatCol(S, jg + c);
+                    Rc[c] = MatCol(R, jg + c);
+               }
+               TriForSolvePanel(R, j0, nCols, Sc, Rc);
+          }
 
-          for (r = 0.0, i = 0; i < j; i++)
+          /* Diagonal block. */
+          for (j = j0; j < j1; j++)
           {
-               /* Pointer to column i of R. */
-               Ri = MatCol(R, i);
+               Sj = MatCol(S, j);
+               Rj = MatCol(R, j);
 
-               if (Ri[i] > 0.0)
-                    t = (Sj[i] - DotProd(Rj, Ri, i)) / Ri[i];
-               else
-                    t = 0.0;
+               for (i = j0; i < j; i++)
+               {
+                    Ri = MatCol(R, i);
 
-               Rj[i] = t;
-               r += t * t;
-          }
+                    if (Ri[i] > 0.0)
+                         Rj[i] = (Sj[i] - TriDotProd(i, Rj, Ri))
+                                   / Ri[i];
+                    else
+                         Rj[i] = 0.0;
+               }
 
-          r = Sj[j] - r;
+               r = Sj[j] - TriDotProd(j, Rj, Rj);
 
-          if (r > 0.0)
-               Rj[j] = sqrt(r);
-          else
-               Rj[j] = 0.0;
+               if (r > 0.0)
+                    Rj[j] = sqrt(r);
+               else
+                    Rj[j] = 0.0;
+          }
      }
 
      for (Rank = 0, j = 0; j < n; j++)
@@ -386,6 +518,261 @@ size_t TriCholesky(const Matrix *S, size_t FirstOff, Matrix *R)
      return (Rank == n) ? OK : Rank;
 }
 
+/*******************************+++*******************************/
+void TriForSolvePanel(const Matrix *R, size_t iLast, size_t nCols,
+     real **B, real **X)
+/*****************************************************************/
+/*   Purpose:  Forward solve rows 0,..., iLast - 1 of R'x = b    */
+/*             for nCols (at most TRI_CHOL_COLS) columns: b is   */
+/*             B[c] and x is X[c].                               */
+/*                                                               */
+/*   Comment:  x[i] is set to zero if R[i, i] is zero, as        */
+/*             required by TriCholesky, which computes rows      */
+/*             0,..., iLast - 1 of columns of its R this way.    */
+/*             Each column i of R is read once for all the       */
+/*             columns, and the dot products are accumulated in  */
+/*             TRI_CHOL_LANES partial sums so that the compiler  */
+/*             can vectorize the inner loop.                     */
+/*             Unused columns repeat the last column, but their  */
+/*             results are not stored (B[c] may be X[c]).        */
+/*                                                               */
+/*   2026.10.16: Created (as TriCholPanel).                      */
+/*   2026.10.16: Generalized for TriForSolveMat.                 */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     real      Acc[TRI_CHOL_COLS][TRI_CHOL_LANES];
+     real      d[TRI_CHOL_COLS];
+     real      *Bc[TRI_CHOL_COLS], *Ri, *Xc[TRI_CHOL_COLS];
+     size_t    c, i, k, l;
+
+     CodeCheck(nCols > 0 && nCols <= TRI_CHOL_COLS);
+
+     for (c = 0; c < TRI_CHOL_COLS; c++)
+     {
+          Bc[c] = B[min(c, nCols - 1)];
+          Xc[c] = X[min(c, nCols - 1)];
+     }
+
+     for (i = 0; i < iLast; i++)
+     {
+          Ri = MatCol(R, i);
+
+          for (c = 0; c < TRI_CHOL_COLS; c++)
+               for (l = 0; l < TRI_CHOL_LANES; l++)
+                    Acc[c][l] = 0.0;
+
+          for (k = 0; k + TRI_CHOL_LANES <= i; k += TRI_CHOL_LANES)
+               for (c = 0; c < TRI_CHOL_COLS; c++)
+                    for (l = 0; l < TRI_CHOL_LANES; l++)
+                         Acc[c][l] += Ri[k + l] * Xc[c][k + l];
+
+          for (c = 0; c < TRI_CHOL_COLS; c++)
+          {
+               for (d[c] = 0.0, l = 0; l < TRI_CHOL_LANES; l++)
+                    d[c] += Acc[c][l];
+               for (l = k; l < i; l++)
+                    d[c] += Ri[l] * Xc[c][l];
+          }
+
+          for (c = 0; c < nCols; c++)
+               if (Ri[i] != 0.0)
+                    Xc[c][i] = (Bc[c][i] - d[c]) / Ri[i];
+               else
+                    Xc[c][i] = 0.0;
+     }
+
+     return;
+}
+
+/*******************************+++*******************************/
+real TriDotProd(size_t n, const real *a, const real *b)
+/*****************************************************************/
+/*   Purpose:  Return a[0] * b[0] + ... + a[n-1] * b[n-1] for    */
+/*             TriCholesky.                                      */
+/*                                                               */
+/*   Comment:  As VecDotProd, but accumulated in TRI_CHOL_LANES  */
+/*             partial sums so that the loop vectorizes.         */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     real      Acc[TRI_CHOL_LANES];
+     real      d;
+     size_t    k, l;
+
+     for (l = 0; l < TRI_CHOL_LANES; l++)
+          Acc[l] = 0.0;
+
+     for (k = 0; k + TRI_CHOL_LANES <= n; k += TRI_CHOL_LANES)
+          for (l = 0; l < TRI_CHOL_LANES; l++)
+               Acc[l] += a[k + l] * b[k + l];
+
+     for (d = 0.0, l = 0; l < TRI_CHOL_LANES; l++)
+          d += Acc[l];
+     for ( ; k < n; k++)
+          d += a[k] * b[k];
+
+     return d;
+}
+
+/*******************************+++*******************************/
+int TriCholInverse(const Matrix *R, Matrix *S)
+/*****************************************************************/
+/*   Purpose:  Compute the upper triangle of S = Inverse(R'R)    */
+/*             from the Cholesky factor R.                       */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if R has a zero diagonal element;     */
+/*             OK          otherwise.                            */
+/*                                                               */
+/*   Comment:  The calling routine must allocate space for S.    */
+/*             Calling with TriCholInverse(R, R) will overwrite  */
+/*             R.                                                */
+/*             Column j of Z = Inverse(R)' is zero above row j;  */
+/*             rows j,..., n - 1 are found by forward solution   */
+/*             of R'z = e_j and packed in a work vector          */
+/*             (TriInvPacked).  Then                             */
+/*             S[i, j] = z_i'z_j, summed over rows j,..., n - 1. */
+/*             Both stages use dot products of contiguous        */
+/*             elements (TriDotProd) and cost about n^3 / 6      */
+/*             multiplications each; the columns are independent */
+/*             and are shared among threads if compiled with     */
+/*             OpenMP.                                           */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      *Z;
+     size_t    k, n;
+     long      jj;
+
+     n = MatNumCols(R);
+
+     for (k = 0; k < n; k++)
+          if (MatElem(R, k, k) == 0.0)
+               return NUMERIC_ERR;
+
+#ifdef LAPACK_DEFINED
+     if (LapackCholInverse(R, S) == OK)
+          return OK;
+#endif
+
+     /* Column j of Z starts at Z + j * (2 * n - j + 1) / 2. */
+     Z = AllocReal(n * (n + 1) / 2, NULL);
+     TriInvPacked(R, Z);
+
+     /* R is no longer needed, and may be S. */
+     S->Shape = UP_TRIANG;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (n >= TRI_CHOL_PAR_MIN)
+#endif
+     for (jj = 0; jj < (long) n; jj++)
+     {
+          real      *Sj, *z;
+          size_t    i, j;
+
+          j  = (size_t) jj;
+          z  = Z + j * (2 * n - j + 1) / 2;
+          Sj = MatCol(S, j);
+
+          for (i = 0; i <= j; i++)
+               Sj[i] = TriDotProd(n - j,
+                         Z + i * (2 * n - i + 1) / 2 + (j - i), z);
+     }
+
+     AllocFree(Z);
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+int TriCholInvDiag(const Matrix *R, real *d)
+/*****************************************************************/
+/*   Purpose:  Compute the diagonal, d, of Inverse(R'R) from the */
+/*             Cholesky factor R.                                */
+/*                                                               */
+/*   Returns:  NUMERIC_ERR if R has a zero diagonal element;     */
+/*             OK          otherwise.                            */
+/*                                                               */
+/*   Comment:  The calling routine must allocate space for d.    */
+/*             d[j] = z_j'z_j for column j of Z = Inverse(R)',   */
+/*             i.e., the first stage of TriCholInverse only.     */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      *Z, *z;
+     size_t    j, n;
+
+     n = MatNumCols(R);
+
+     for (j = 0; j < n; j++)
+          if (MatElem(R, j, j) == 0.0)
+               return NUMERIC_ERR;
+
+     Z = AllocReal(n * (n + 1) / 2, NULL);
+     TriInvPacked(R, Z);
+
+     for (j = 0; j < n; j++)
+     {
+          z = Z + j * (2 * n - j + 1) / 2;
+          d[j] = TriDotProd(n - j, z, z);
+     }
+
+     AllocFree(Z);
+
+     return OK;
+}
+
+/*******************************+++*******************************/
+static void TriInvPacked(const Matrix *R, real *Z)
+/*****************************************************************/
+/*   Purpose:  Compute the lower triangle of Z = Inverse(R)', by */
+/*             columns: column j (rows j,..., n - 1) starts at   */
+/*             Z + j * (2 * n - j + 1) / 2.                      */
+/*                                                               */
+/*   Comment:  R must not have a zero diagonal element.          */
+/*             The columns are independent and are shared among  */
+/*             threads if compiled with OpenMP.                  */
+/*                                                               */
+/*   2026.10.17: Created from TriCholInverse.                    */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     size_t    n;
+     long      jj;
+
+     n = MatNumCols(R);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (n >= TRI_CHOL_PAR_MIN)
+#endif
+     for (jj = 0; jj < (long) n; jj++)
+     {
+          real      *z;
+          size_t    i, j;
+
+          j = (size_t) jj;
+          z = Z + j * (2 * n - j + 1) / 2;
+
+          z[0] = 1.0 / MatElem(R, j, j);
+          for (i = j + 1; i < n; i++)
+               z[i - j] = -TriDotProd(i - j, MatCol(R, i) + j, z)
+                         / MatElem(R, i, i);
+     }
+
+     return;
+}
+
 /*******************************+++*******************************/
 /*                                                               */
 /*   void      TriRect(const Matrix *X, Matrix *R)               */
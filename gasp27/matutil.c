@@ -13,7 +13,7 @@
 #include "matrix.h"
 #include "lib.h"
 
-extern int     ErrorSeverityLevel;
+extern THREAD_LOCAL int ErrorSeverityLevel;
 
 /*******************************+++*******************************/
 /*   int       *MatIntCol(const Matrix *M, size_t j)             */
@@ -284,16 +284,59 @@ void MatVec(const Matrix *M, const real *x, real *y)
 /*                                                               */
 /*   Comment:  Calling routine must allocate space for y.        */
 /*                                                               */
-/*   Version:  1995 February 14                                  */
+/*   2026.10.16: dgemv if LAPACK_DEFINED and M is MAT_DENSE.     */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
 /*****************************************************************/
 {
      size_t    j, n;
 
+#ifdef LAPACK_DEFINED
+     if (LapackMatVec(M, x, y) == OK)
+          return;
+#endif
+
      n = MatNumRows(M);
      for (j = 0; j < MatNumCols(M); j++)
           y[j] = DotProd(MatCol(M, j), x, n);
 }
 
+/*******************************+++*******************************/
+void MatTMult(const Matrix *A, const Matrix *B, Matrix *C)
+/*****************************************************************/
+/*   Purpose:  Compute C = A'B for RECT matrices.                */
+/*                                                               */
+/*   Comment:  Calling routine must allocate space for C.        */
+/*             dgemm if LAPACK_DEFINED and A, B, and C are       */
+/*             MAT_DENSE.                                        */
+/*                                                               */
+/*   2026.10.16: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.16                                        */
+/*****************************************************************/
+{
+     real      *b, *c;
+     size_t    i, j, n;
+
+     CodeCheck(MatNumRows(A) == MatNumRows(B));
+     CodeCheck(MatNumRows(C) == MatNumCols(A));
+     CodeCheck(MatNumCols(C) == MatNumCols(B));
+
+#ifdef LAPACK_DEFINED
+     if (LapackTMult(A, B, C) == OK)
+          return;
+#endif
+
+     n = MatNumRows(A);
+     for (j = 0; j < MatNumCols(B); j++)
+     {
+          b = MatCol(B, j);
+          c = MatCol(C, j);
+          for (i = 0; i < MatNumCols(A); i++)
+               c[i] = DotProd(MatCol(A, i), b, n);
+     }
+}
+
 /*******************************+++*******************************/
 void MatMultElemWise(const Matrix *A, Matrix *B)
 /*****************************************************************/
@@ -16,10 +16,17 @@
 #include "lib.h"
 #include "min.h"
 
-/* These external variables communicate with ObjCont. */
-static real    (*ObjFuncExt)(real *x, size_t nDims);
-static real    *xExt;
-static size_t  *IndexCont, nDimsExt;
+/* These external variables communicate with ObjCont.  */
+/* They are private to each thread, so that separate    */
+/* optimizations may run concurrently.                  */
+static THREAD_LOCAL real    (*ObjFuncExt)(real *x, size_t nDims);
+static THREAD_LOCAL real    *xExt;
+static THREAD_LOCAL size_t  *IndexCont, nDimsExt;
+
+/* These communicate with ObjContGrad and ObjGradValue. */
+static THREAD_LOCAL real    (*ObjGradExt)(real *x, size_t nDims,
+                                 real *g);
+static THREAD_LOCAL real    *gExt;
 
 /*******************************+++*******************************/
 unsigned MinAnyX(real (*ObjFunc)(real *x, size_t nDims),
@@ -56,8 +63,9 @@ unsigned MinAnyX(real (*ObjFunc)(real *x, size_t nDims),
 /*   96.03.08: MinConverged replaced by ApproxEq.                */
 /*             Extrapolation removed.                            */
 /*   96.03.09: Extrapolation at end of each iteration.           */
+/*   2026.10.17: LBFGSALG (from MinAnyXGrad).                    */
 /*                                                               */
-/*   Version:  1996.03.09                                        */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
      real      ObjOld;
@@ -79,6 +87,7 @@ unsigned MinAnyX(real (*ObjFunc)(real *x, size_t nDims),
      nDimsExtCopy = nDimsExt;
 
      CodeCheck(RegNumVars(XReg) == nDims);
+     CodeCheck(MinAlg != LBFGSALG || ObjGradExt != NULL);
 
      ContDistrib = AllocSize_t(nDims, NULL);
      IndexCont   = AllocSize_t(nDims, NULL);
@@ -174,9 +183,10 @@ unsigned MinAnyX(real (*ObjFunc)(real *x, size_t nDims),
                /* Load continuous x's into xCont. */
                VecCopyIndex(nContVars, IndexCont, x, NULL, xCont);
 
-               nEvals += MinCont(ObjCont, AbsTol, RelTol, MaxFuncs,
-                         ContMin, ContMax, ContDistrib, nContVars,
-                         MinAlg, xCont, Obj);
+               nEvals += MinCont(ObjCont,
+                         (MinAlg == LBFGSALG) ? ObjContGrad : NULL,
+                         AbsTol, RelTol, MaxFuncs, ContMin, ContMax,
+                         ContDistrib, nContVars, MinAlg, xCont, Obj);
                NumOpts++;
 
                /* Put best continuous levels back in x. */
@@ -231,6 +241,54 @@ unsigned MinAnyX(real (*ObjFunc)(real *x, size_t nDims),
      return nEvals;
 }
 
+/*******************************+++*******************************/
+unsigned MinAnyXGrad(real (*ObjGrad)(real *x, size_t nDims,
+          real *g), real AbsTol, real RelTol, unsigned MaxFuncs,
+          const Matrix *XReg, size_t nDims, real *x, real *Obj)
+/*****************************************************************/
+/*   Purpose:  As MinAnyX with MinAlg LBFGSALG, for an objective */
+/*             that also computes its gradient.                  */
+/*                                                               */
+/*   Args:     ObjGrad   Returns the objective at x and, unless  */
+/*                       g is NULL, puts its gradient in g       */
+/*                       (elements for variables that are not    */
+/*                       CONTINUOUS are ignored).                */
+/*             Others    As MinAnyX.                             */
+/*                                                               */
+/*   Returns:  Total number of function evaluations.             */
+/*                                                               */
+/*   Comment:  The discrete variables and the extrapolation in   */
+/*             MinAnyX use ObjGradValue (no gradient).           */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      *gExtCopy;
+     real      (*ObjGradExtCopy)(real *x, size_t nDims, real *g);
+     unsigned  nEvals;
+
+     /* Save statics to local variables, */
+     /* to enable recursive calling.     */
+     ObjGradExtCopy = ObjGradExt;
+     gExtCopy       = gExt;
+
+     ObjGradExt = ObjGrad;
+     gExt       = AllocReal(nDims, NULL);
+
+     nEvals = MinAnyX(ObjGradValue, AbsTol, RelTol, MaxFuncs, XReg,
+               nDims, LBFGSALG, x, Obj);
+
+     AllocFree(gExt);
+
+     /* Restore statics. */
+     ObjGradExt = ObjGradExtCopy;
+     gExt       = gExtCopy;
+
+     return nEvals;
+}
+
 /*******************************+++*******************************/
 unsigned MinDisc(size_t NumVars, const size_t *VarIndex,
      const Matrix *XReg, real *x, real *Obj)
@@ -305,6 +363,47 @@ real ObjCont(real *xCont, size_t nContVars)
      return((*ObjFuncExt)(xExt, nDimsExt));
 }
 
+/*******************************+++*******************************/
+real ObjContGrad(real *xCont, size_t nContVars, real *gCont)
+/*****************************************************************/
+/*   Purpose:  As ObjCont, and put the gradient with respect to  */
+/*             the continuous variables in gCont (unless NULL).  */
+/*                                                               */
+/*   Returns:  Objective.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real   Obj;
+     size_t c;
+
+     for (c = 0; c < nContVars; c++)
+          xExt[IndexCont[c]] = xCont[c];
+
+     if (gCont == NULL)
+          return((*ObjGradExt)(xExt, nDimsExt, NULL));
+
+     Obj = (*ObjGradExt)(xExt, nDimsExt, gExt);
+
+     for (c = 0; c < nContVars; c++)
+          gCont[c] = gExt[IndexCont[c]];
+
+     return Obj;
+}
+
+/*******************************+++*******************************/
+real ObjGradValue(real *x, size_t nDims)
+/*****************************************************************/
+/*   Purpose:  The objective of MinAnyXGrad without gradient.    */
+/*                                                               */
+/*   Returns:  Objective.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     return((*ObjGradExt)(x, nDims, NULL));
+}
+
 /*******************************+++*******************************/
 unsigned MinMultiStart(real (*ObjFunc)(real *x, size_t nDims),
           real AbsTol, real RelTol, unsigned MaxFuncs,
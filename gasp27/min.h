@@ -7,6 +7,7 @@
 
 #define SIMPLEXALG 0
 #define POWELLALG  1
+#define LBFGSALG   2    /* Needs the gradient: see MinAnyXGrad. */
 
 /* min.c: */
 
@@ -39,6 +40,23 @@ unsigned MinAnyX(real (*ObjFunc)(real *x, size_t nDims),
 /*   Returns:  Total number of function evaluations.             */
 /*****************************************************************/
 
+/*****************************************************************/
+unsigned MinAnyXGrad(real (*ObjGrad)(real *x, size_t nDims,
+          real *g), real AbsTol, real RelTol, unsigned MaxFuncs,
+          const Matrix *XReg, size_t nDims, real *x, real *Obj);
+/*****************************************************************/
+/*   Purpose:  As MinAnyX with MinAlg LBFGSALG, for an objective */
+/*             that also computes its gradient.                  */
+/*                                                               */
+/*   Args:     ObjGrad   Returns the objective at x and, unless  */
+/*                       g is NULL, puts its gradient in g       */
+/*                       (elements for variables that are not    */
+/*                       CONTINUOUS are ignored).                */
+/*             Others    As MinAnyX.                             */
+/*                                                               */
+/*   Returns:  Total number of function evaluations.             */
+/*****************************************************************/
+
 /*****************************************************************/
 unsigned MinDisc(size_t nDims, const size_t *VarIndex,
      const Matrix *XReg, real *x, real *Obj);
@@ -58,6 +76,23 @@ real ObjCont(real *xCont, size_t nContVars);
 /*   Returns:  Objective.                                        */
 /*****************************************************************/
 
+/*****************************************************************/
+real ObjContGrad(real *xCont, size_t nContVars, real *gCont);
+/*****************************************************************/
+/*   Purpose:  As ObjCont, and put the gradient with respect to  */
+/*             the continuous variables in gCont (unless NULL).  */
+/*                                                               */
+/*   Returns:  Objective.                                        */
+/*****************************************************************/
+
+/*****************************************************************/
+real ObjGradValue(real *x, size_t nDims);
+/*****************************************************************/
+/*   Purpose:  The objective of MinAnyXGrad without gradient.    */
+/*                                                               */
+/*   Returns:  Objective.                                        */
+/*****************************************************************/
+
 /*****************************************************************/
 unsigned MinMultiStart(real (*ObjFunc)(real *x, size_t nDims),
           real AbsTol, real RelTol, unsigned MaxFuncs,
@@ -106,12 +141,20 @@ real ObjFuncNoGrad(real *x, size_t n);
 /* mincont.c: */
 
 unsigned  MinCont(real (*ObjFunc)(real *x, size_t nDims),
+               real (*ObjGrad)(real *x, size_t nDims, real *g),
                real AbsTol, real RelTol, unsigned MaxFuncs,
                real *LowBnd, real *UpBnd, size_t *Distrib,
                size_t nDims, int MinAlg, real *x, real *fx);
 real      XToUncon(real x, real a, real b);
 real      UnconToX(real u, real a, real b);
 
+/*****************************************************************/
+real UnconToXDeriv(real u, real a, real b);
+/*****************************************************************/
+/*   Purpose:  Return the derivative of UnconToX(u, a, b) with   */
+/*             respect to u.                                     */
+/*****************************************************************/
+
 /*****************************************************************/
 real ObjFuncUncon(real *xUncon, size_t nDims);
 /*****************************************************************/
@@ -121,6 +164,45 @@ real ObjFuncUncon(real *xUncon, size_t nDims);
 /*   Returns:  Objective.                                        */
 /*****************************************************************/
 
+/*****************************************************************/
+real ObjGradUncon(real *xUncon, size_t nDims, real *gUncon);
+/*****************************************************************/
+/*   Purpose:  As ObjFuncUncon, and put the gradient with        */
+/*             respect to the unconstrained x's in gUncon        */
+/*             (unless NULL).                                    */
+/*                                                               */
+/*   Returns:  Objective.                                        */
+/*****************************************************************/
+
+/* minlbfgs.c: */
+
+/* Number of corrections kept by MinLBFGS. */
+#define LBFGS_MEM    5
+
+/*****************************************************************/
+unsigned MinLBFGS(real (*ObjGrad)(real *x, size_t nDims, real *g),
+          real AbsTol, real RelTol, unsigned MaxFuncs,
+          size_t nDims, real *x, real *fx);
+/*****************************************************************/
+/*   Purpose:  Multidimensional unconstrained minimization by    */
+/*             the limited-memory BFGS method.                   */
+/*                                                               */
+/*   Args:     ObjGrad   Returns the objective at x and, unless  */
+/*                       g is NULL, puts its gradient in g.      */
+/*             AbsTol    Absolute tolerance on function value    */
+/*                       for convergence.                        */
+/*             RelTol    Relative tolerance on function value    */
+/*                       for convergence.                        */
+/*             MaxFuncs  Maximum function evaluations.           */
+/*             nDims     Number of dimensions.                   */
+/*             x         Input:  Starting point.                 */
+/*                       Output: "Optimal" point.                */
+/*             fx        Input:  Function value at x.            */
+/*                       Output: "Optimal" function value.       */
+/*                                                               */
+/*   Returns:  Number of function evaluations.                   */
+/*****************************************************************/
+
 /* minextra.c: */
 
 unsigned  MinExtrap(real (*ObjFunc)(real *x, size_t nDims),
@@ -12,7 +12,7 @@
 #include "lib.h"
 #include "min.h"
 
-static real (*ExtObjFunc)(size_t n, real *x, real *g);
+static THREAD_LOCAL real (*ExtObjFunc)(size_t n, real *x, real *g);
 
 /*******************************+++*******************************/
 unsigned MinConjGrad(real (*ObjFunc)(size_t n, real *x, real *g),
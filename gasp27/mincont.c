@@ -15,12 +15,19 @@
 #include "lib.h"
 #include "min.h"
 
-/* These external variables communicate with ObjFuncUncon. */
-static real    (*ObjFuncExt)(real *x, size_t nDims);
-static real    *LowBndExt, *UpBndExt, *xExt;
+/* These external variables communicate with ObjFuncUncon */
+/* (one copy per thread).                                  */
+static THREAD_LOCAL real    (*ObjFuncExt)(real *x, size_t nDims);
+static THREAD_LOCAL real    (*ObjGradExt)(real *x, size_t nDims,
+                                 real *g);
+static THREAD_LOCAL real    *LowBndExt, *UpBndExt, *xExt;
+
+/* Step in u off a bound for LBFGSALG. */
+#define U_NUDGE    1.0e-4
 
 /*******************************+++*******************************/
 unsigned MinCont(real (*ObjFunc)(real *x, size_t nDims),
+          real (*ObjGrad)(real *x, size_t nDims, real *g),
           real AbsTol, real RelTol, unsigned MaxFuncs,
           real *LowBnd, real *UpBnd, size_t *Distrib,
           size_t nDims, int MinAlg, real *x, real *fx)
@@ -30,6 +37,9 @@ unsigned MinCont(real (*ObjFunc)(real *x, size_t nDims),
 /*             unconstrained minimization.                       */
 /*                                                               */
 /*   Args:     ObjFunc   The objective function.                 */
+/*             ObjGrad   The objective function and its          */
+/*                       gradient (only used if MinAlg is        */
+/*                       LBFGSALG).                              */
 /*             AbsTol    Absolute tolerance on function value    */
 /*                       for convergence.                        */
 /*             RelTol    Relative tolerance on function value    */
@@ -52,26 +62,30 @@ unsigned MinCont(real (*ObjFunc)(real *x, size_t nDims),
 /*   96.03.08: Calls ObjFuncUncon to convert unconstrained       */
 /*             ranges to constrained ranges.                     */
 /*             Calls MinTryBounds.                               */
+/*   2026.10.17: LBFGSALG, via ObjGradUncon.                     */
 /*                                                               */
-/*   Version:  1996.03.08                                        */
+/*   Version:  2026.10.17                                        */
 /*****************************************************************/
 {
      real      *Obj, r;
      real      **Dir, **Simp;
      real      *LowBndExtCopy, *UpBndExtCopy, *xExtCopy;
      real      (*ObjFuncExtCopy)(real *x, size_t nDims);
+     real      (*ObjGradExtCopy)(real *x, size_t nDims, real *g);
      size_t    i, j;
      unsigned  nEvals;
 
      /* Save statics to local variables, */
      /* to enable recursive calling.     */
      ObjFuncExtCopy = ObjFuncExt;
+     ObjGradExtCopy = ObjGradExt;
      LowBndExtCopy  = LowBndExt;
      UpBndExtCopy   = UpBndExt;
      xExtCopy       = xExt;
 
      /* External equivalents. */
      ObjFuncExt = ObjFunc;
+     ObjGradExt = ObjGrad;
      LowBndExt  = LowBnd;
      UpBndExt   = UpBnd;
 
@@ -143,6 +157,17 @@ unsigned MinCont(real (*ObjFunc)(real *x, size_t nDims),
                AllocFree(Dir[i]);
           AllocFree(Dir);
      }
+     else if (MinAlg == LBFGSALG)
+     {
+          /* At a bound, dx/du is zero and so is the gradient */
+          /* with respect to u: move u slightly into range.   */
+          for (j = 0; j < nDims; j++)
+               if (UnconToXDeriv(x[j], LowBnd[j], UpBnd[j]) == 0.0)
+                    x[j] += (x[j] > 0.0) ? -U_NUDGE : U_NUDGE;
+
+          nEvals = MinLBFGS(ObjGradUncon, AbsTol, RelTol, MaxFuncs,
+                    nDims, x, fx);
+     }
 
      /* Transform back to constrained x's. */
      for (j = 0; j < nDims; j++)
@@ -152,6 +177,7 @@ unsigned MinCont(real (*ObjFunc)(real *x, size_t nDims),
 
      /* Restore statics. */
      ObjFuncExt = ObjFuncExtCopy;
+     ObjGradExt = ObjGradExtCopy;
      LowBndExt  = LowBndExtCopy;
      UpBndExt   = UpBndExtCopy;
      xExt       = xExtCopy;
@@ -244,6 +270,30 @@ real UnconToX(real u, real a, real b)
      return x;
 }
 
+/*******************************+++*******************************/
+real UnconToXDeriv(real u, real a, real b)
+/*****************************************************************/
+/*                                                               */
+/* Purpose:    Return the derivative of UnconToX(u, a, b) with   */
+/*             respect to u.                                     */
+/*                                                               */
+/* 2026.10.17                                                    */
+/*****************************************************************/
+{
+     real d;
+
+     if (a == -REAL_MAX && b == REAL_MAX)
+          d = 1.0;
+     else if (a > -REAL_MAX && b < REAL_MAX)
+          d = 0.5 * cos(u) * (b - a);
+     else if (a == -REAL_MAX)
+          d = -2.0 * u;
+     else
+          d = 2.0 * u;
+
+     return d;
+}
+
 /*******************************+++*******************************/
 real ObjFuncUncon(real *xUncon, size_t nDims)
 /*****************************************************************/
@@ -263,3 +313,30 @@ real ObjFuncUncon(real *xUncon, size_t nDims)
      return((*ObjFuncExt)(xExt, nDims));
 }
 
+/*******************************+++*******************************/
+real ObjGradUncon(real *xUncon, size_t nDims, real *gUncon)
+/*****************************************************************/
+/*   Purpose:  As ObjFuncUncon, and put the gradient with        */
+/*             respect to the unconstrained x's in gUncon        */
+/*             (unless NULL).                                    */
+/*                                                               */
+/*   Returns:  Objective.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     real      Obj;
+     size_t    j;
+
+     for (j = 0; j < nDims; j++)
+          xExt[j] = UnconToX(xUncon[j], LowBndExt[j], UpBndExt[j]);
+
+     Obj = (*ObjGradExt)(xExt, nDims, gUncon);
+
+     if (gUncon != NULL)
+          for (j = 0; j < nDims; j++)
+               gUncon[j] *= UnconToXDeriv(xUncon[j], LowBndExt[j],
+                         UpBndExt[j]);
+
+     return Obj;
+}
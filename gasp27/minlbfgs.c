@@ -0,0 +1,227 @@
+/*****************************************************************/
+/*   LIMITED-MEMORY BFGS METHOD FOR MULTIDIMENSIONAL             */
+/*   UNCONSTRAINED MINIMIZATION WITH GRADIENTS                   */
+/*                                                               */
+/*   See Nocedal and Wright (2006), Numerical Optimization,      */
+/*   Algorithms 7.4 and 7.5.                                     */
+/*****************************************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "define.h"
+#include "implem.h"
+#include "matrix.h"
+#include "lib.h"
+#include "min.h"
+
+/* Sufficient-decrease constant for the line search. */
+#define ARMIJO    1.0e-4
+
+/*******************************+++*******************************/
+unsigned MinLBFGS(real (*ObjGrad)(real *x, size_t nDims, real *g),
+          real AbsTol, real RelTol, unsigned MaxFuncs,
+          size_t nDims, real *x, real *fx)
+/*****************************************************************/
+/*   Purpose:  Multidimensional unconstrained minimization by    */
+/*             the limited-memory BFGS method.                   */
+/*                                                               */
+/*   Args:     ObjGrad   Returns the objective at x and, unless  */
+/*                       g is NULL, puts its gradient in g.      */
+/*             AbsTol    Absolute tolerance on function value    */
+/*                       for convergence.                        */
+/*             RelTol    Relative tolerance on function value    */
+/*                       for convergence.                        */
+/*             MaxFuncs  Maximum function evaluations.           */
+/*             nDims     Number of dimensions.                   */
+/*             x         Input:  Starting point.                 */
+/*                       Output: "Optimal" point.                */
+/*             fx        Input:  Function value at x.            */
+/*                       Output: "Optimal" function value.       */
+/*                                                               */
+/*   Returns:  Number of function evaluations.                   */
+/*                                                               */
+/*   Comment:  The search direction is from the last LBFGS_MEM   */
+/*             steps and gradient changes (two-loop recursion).  */
+/*             The line search backtracks from a unit step by    */
+/*             safeguarded quadratic interpolation until the     */
+/*             sufficient-decrease (Armijo) condition holds; a   */
+/*             pair with non-positive curvature is not kept.     */
+/*             The gradient is requested with the function value */
+/*             only for a quasi-Newton unit step, which is       */
+/*             usually accepted, and otherwise once a step is    */
+/*             accepted.  The first evaluation is at the         */
+/*             starting point, as its gradient is needed.        */
+/*             A Powell iteration is a cycle of line searches,   */
+/*             and similarly the search stops when the last      */
+/*             LBFGS_MEM iterations together decrease the        */
+/*             function by no more than AbsTol or RelTol times   */
+/*             its size.                                         */
+/*                                                               */
+/*   2026.10.17: Created.                                        */
+/*                                                               */
+/*   Version:  2026.10.17                                        */
+/*****************************************************************/
+{
+     boolean   Decrease, WithGrad;
+     real      ave, b, diff, fNew, fPrev, gd, Step, sy, t;
+     real      fOld[LBFGS_MEM];
+     real      *a, *d, *g, *gNew, *rho, *S, *xNew, *Y;
+     size_t    j, l, Newest, nIter, nMem;
+     long      ll;
+     unsigned  NumFuncs;
+
+     a    = AllocReal(LBFGS_MEM, NULL);
+     rho  = AllocReal(LBFGS_MEM, NULL);
+     S    = AllocReal(LBFGS_MEM * nDims, NULL);
+     Y    = AllocReal(LBFGS_MEM * nDims, NULL);
+     d    = AllocReal(nDims, NULL);
+     g    = AllocReal(nDims, NULL);
+     gNew = AllocReal(nDims, NULL);
+     xNew = AllocReal(nDims, NULL);
+
+     *fx = (*ObjGrad)(x, nDims, g);
+     NumFuncs = 1;
+
+     /* The stored pairs are S + l * nDims and Y + l * nDims, */
+     /* l = Newest, Newest - 1,... (cyclically).              */
+     nMem   = 0;
+     Newest = LBFGS_MEM - 1;
+
+     nIter = 0;
+
+     while (NumFuncs < MaxFuncs)
+     {
+          /* f before this iteration, for the convergence test. */
+          fOld[nIter % LBFGS_MEM] = *fx;
+          nIter++;
+
+          /* Direction d = -H * g by the two-loop recursion. */
+          for (j = 0; j < nDims; j++)
+               d[j] = -g[j];
+
+          for (ll = 0; ll < (long) nMem; ll++)
+          {
+               l = (Newest + LBFGS_MEM - ll) % LBFGS_MEM;
+               a[l] = rho[l] * VecDotProd(nDims, S + l * nDims, d);
+               VecAddVec(-a[l], Y + l * nDims, nDims, d);
+          }
+
+          if (nMem > 0)
+          {
+               /* Initial Hessian approximation is s'y / y'y * I. */
+               l = Newest;
+               VecMultScalar(1.0 / (rho[l] *
+                         VecSS(Y + l * nDims, nDims)), nDims, d);
+          }
+
+          for (ll = (long) nMem - 1; ll >= 0; ll--)
+          {
+               l = (Newest + LBFGS_MEM - (size_t) ll) % LBFGS_MEM;
+               b = rho[l] * VecDotProd(nDims, Y + l * nDims, d);
+               VecAddVec(a[l] - b, S + l * nDims, nDims, d);
+          }
+
+          gd = VecDotProd(nDims, g, d);
+          if (gd >= 0.0)
+          {
+               /* Not a descent direction: restart. */
+               nMem = 0;
+               for (j = 0; j < nDims; j++)
+                    d[j] = -g[j];
+               gd = -VecSS(g, nDims);
+          }
+
+          if (gd == 0.0)
+               break;   /* Stationary point. */
+
+          /* Without curvature information, take a step of */
+          /* at most unit length.                          */
+          Step = (nMem == 0) ? min(1.0, 1.0 / sqrt(-gd)) : 1.0;
+
+          /* Backtracking line search.  The gradient comes with */
+          /* the function value only for a quasi-Newton unit    */
+          /* step, which is usually accepted.                   */
+          Decrease = NO;
+          WithGrad = (nMem > 0);
+          while (NumFuncs < MaxFuncs)
+          {
+               for (j = 0; j < nDims; j++)
+                    xNew[j] = x[j] + Step * d[j];
+               fNew = (*ObjGrad)(xNew, nDims, WithGrad ? gNew : NULL);
+               NumFuncs++;
+
+               if (fNew <= *fx + ARMIJO * Step * gd)
+               {
+                    Decrease = YES;
+                    break;
+               }
+               WithGrad = NO;
+
+               /* Minimum of the quadratic through f(0), f'(0), */
+               /* and f(Step), kept in [Step / 10, Step / 2].   */
+               t = fNew - *fx - gd * Step;
+               t = (t > 0.0) ? -gd * Step * Step / (2.0 * t) : 0.0;
+               Step = max(0.1 * Step, min(0.5 * Step, t));
+          }
+
+          if (!Decrease)
+               break;
+
+          if (!WithGrad)
+          {
+               if (NumFuncs >= MaxFuncs)
+               {
+                    VecCopy(xNew, nDims, x);
+                    *fx = fNew;
+                    break;
+               }
+               (*ObjGrad)(xNew, nDims, gNew);
+               NumFuncs++;
+          }
+
+          /* Save the step and the gradient change */
+          /* if the curvature is positive.         */
+          l = (Newest + 1) % LBFGS_MEM;
+          for (j = 0; j < nDims; j++)
+          {
+               S[l * nDims + j] = xNew[j] - x[j];
+               Y[l * nDims + j] = gNew[j] - g[j];
+          }
+          sy = VecDotProd(nDims, S + l * nDims, Y + l * nDims);
+          if (sy > EPSILON * VecSS(Y + l * nDims, nDims))
+          {
+               rho[l] = 1.0 / sy;
+               Newest = l;
+               nMem   = min(nMem + 1, LBFGS_MEM);
+          }
+
+          VecCopy(xNew, nDims, x);
+          VecCopy(gNew, nDims, g);
+          *fx = fNew;
+
+          if (nIter >= LBFGS_MEM)
+          {
+               /* Decrease over the last LBFGS_MEM iterations. */
+               fPrev = fOld[nIter % LBFGS_MEM];
+               diff  = fPrev - fNew;
+               /* Have to be careful here to avoid overflow. */
+               ave = 0.5 * fabs(fPrev) + 0.5 * fabs(fNew);
+
+               if (diff <= AbsTol || diff <= RelTol * ave)
+                    break;   /* Converged. */
+          }
+     }
+
+     AllocFree(a);
+     AllocFree(rho);
+     AllocFree(S);
+     AllocFree(Y);
+     AllocFree(d);
+     AllocFree(g);
+     AllocFree(gNew);
+     AllocFree(xNew);
+
+     return NumFuncs;
+}
@@ -294,12 +294,13 @@ unsigned Brent(real (*ObjFunc)(real x), real AbsTol, real RelTol,
      return NumFuncs;
 }
 
-/* These external variables communicate with f1dim. */
-static real    *ExtD = NULL;
-static real    *ExtX = NULL;
-static real    *NewX = NULL;
-static real    (*ExtObjFunc)(real *x, size_t nDims);
-static size_t  ExtnDims;
+/* These external variables communicate with f1dim */
+/* (one copy per thread).                          */
+static THREAD_LOCAL real    *ExtD = NULL;
+static THREAD_LOCAL real    *ExtX = NULL;
+static THREAD_LOCAL real    *NewX = NULL;
+static THREAD_LOCAL real    (*ExtObjFunc)(real *x, size_t nDims);
+static THREAD_LOCAL size_t  ExtnDims;
 
 /*******************************+++*******************************/
 unsigned MinLine(real (*ObjFunc)(real *x, size_t nDims),
@@ -12,7 +12,7 @@
 #include "lib.h"
 #include "min.h"
 
-static real sqrarg;
+static THREAD_LOCAL real sqrarg;
 #define SQR(a) (sqrarg = (a), sqrarg*sqrarg)
 
 /*******************************+++*******************************/
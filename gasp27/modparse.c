@@ -15,7 +15,7 @@
 #include "lib.h"
 #include "model.h"
 
-extern int     ErrorSeverityLevel;
+extern THREAD_LOCAL int ErrorSeverityLevel;
 
 int            TermColType[] = TERM_COL_TYPES;
 